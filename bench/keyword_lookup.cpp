@@ -0,0 +1,67 @@
+/* Microbenchmark: Lexer::lookupKeyword against the unordered_map lookup it replaced */
+#include "lexer/lexer.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <cstdlib>
+#include <string_view>
+
+static const std::unordered_map<std::string, TokenType> mapKeywords = {
+    {"var", TokenType::VAR}, {"const", TokenType::CONST}, {"as", TokenType::AS},
+    {"bool", TokenType::BOOL}, {"true", TokenType::TRUE}, {"false", TokenType::FALSE},
+    {"if", TokenType::IF}, {"then", TokenType::THEN}, {"else", TokenType::ELSE},
+    {"elseif", TokenType::ELSEIF}, {"end", TokenType::END}, {"and", TokenType::AND},
+    {"or", TokenType::OR}, {"not", TokenType::NOT}, {"func", TokenType::FUNC},
+    {"ret", TokenType::RETURN}, {"while", TokenType::WHILE}, {"for", TokenType::FOR},
+    {"do", TokenType::DO}, {"enum", TokenType::ENUM}, {"stop", TokenType::STOP},
+    {"next", TokenType::NEXT}, {"struct", TokenType::STRUCT},
+    {"i4", TokenType::INT4}, {"i8", TokenType::INT8}, {"i12", TokenType::INT12},
+    {"i16", TokenType::INT16}, {"i24", TokenType::INT24}, {"i32", TokenType::INT32},
+    {"i48", TokenType::INT48}, {"i64", TokenType::INT64},
+    {"u0", TokenType::UINT0}, {"u4", TokenType::UINT4}, {"u8", TokenType::UINT8},
+    {"u12", TokenType::UINT12}, {"u16", TokenType::UINT16}, {"u24", TokenType::UINT24},
+    {"u32", TokenType::UINT32}, {"u48", TokenType::UINT48}, {"u64", TokenType::UINT64},
+    {"f32", TokenType::FLOAT32}, {"f64", TokenType::FLOAT64}, {"str", TokenType::STRING}
+};
+
+/* Keeps the optimizer from discarding the lookups */
+static volatile unsigned sink;
+
+template <typename Fn>
+static double nsPerCall(const std::vector<std::string>& words, int rounds, Fn&& fn) {
+    unsigned total = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (const auto& word : words) total += static_cast<unsigned>(fn(word));
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    sink = total;
+    return elapsed / (static_cast<double>(words.size()) * rounds);
+}
+
+int main(int argc, char** argv) {
+    int rounds = argc > 1 ? std::atoi(argv[1]) : 2000;
+
+    /* Roughly the keyword/identifier mix of generated programs */
+    std::vector<std::string> words = {
+        "var", "counter", "i32", "func", "end", "if", "then", "result", "elseif", "value",
+        "u8", "ret", "while", "do", "index", "struct", "Point", "x", "f64", "total_sum",
+        "else", "for", "str", "message", "true", "false", "io", "println", "a", "bb",
+    };
+
+    /* Both sides start from the lexeme as the lexer sees it: a view into the source */
+    double mapNs = nsPerCall(words, rounds, [](const std::string& word) {
+        std::string key{std::string_view(word)};
+        auto it = mapKeywords.find(key);
+        return it != mapKeywords.end() ? it->second : TokenType::IDENTIFIER;
+    });
+    double hashNs = nsPerCall(words, rounds, [](const std::string& word) {
+        return Lexer::lookupKeyword(std::string_view(word));
+    });
+
+    std::printf("{\"unordered_map_ns\":%.2f,\"perfect_hash_ns\":%.2f,\"speedup\":%.2f}\n",
+                mapNs, hashNs, mapNs / hashNs);
+    return 0;
+}
@@ -0,0 +1,178 @@
+/* Front-end throughput on a generated Summit program: tokens/s for Lexer::tokenize, AST nodes/s
+   for Parser::parse and functions/s for SemanticAnalyzer plus CodeGen, best of --rounds, printed as JSON.
+   --emit <file> also writes the corpus so it can be fed to 'summit --time-report' */
+#include "lexer/lexer.h"
+#include "parser/parser.h"
+#include "ast/semantic_analyzer.h"
+#include "codegen/codegen.h"
+#include "stdlib/core/stdlib_manager.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace {
+
+struct CorpusShape {
+    int functions = 2000;
+    int elseifDepth = 16;
+    int structs = 50;
+    int enums = 50;
+    int formatArgs = 8;
+};
+
+std::string generateCorpus(const CorpusShape& shape) {
+    std::ostringstream out;
+    out << "const std = @import(\"std\");\n\n";
+
+    for (int e = 0; e < shape.enums; ++e) {
+        out << "enum Kind" << e << "\n";
+        for (int m = 0; m < 4; ++m) out << "    Member" << m << " = " << m << ",\n";
+        out << "end\n\n";
+    }
+
+    for (int s = 0; s < shape.structs; ++s) {
+        out << "struct Shape" << s << "\n"
+            << "    x: i32 = 0;\n"
+            << "    y: i32 = " << s << ";\n";
+        if (shape.enums > 0) {
+            int e = s % shape.enums;
+            out << "    kind: Kind" << e << " = Kind" << e << ".Member" << s % 4 << ";\n";
+        }
+        out << "end\n\n";
+    }
+
+    for (int f = 0; f < shape.functions; ++f) {
+        int structIndex = shape.structs > 0 ? f % shape.structs : -1;
+        out << "func work_" << f << "(a: i32, b: i32) -> i32\n"
+            << "    var acc: i32 = a * " << (f % 97 + 1) << " + b;\n";
+        if (structIndex >= 0) {
+            out << "    var shape: Shape" << structIndex << " = Shape" << structIndex << "{};\n"
+                << "    shape.x = acc;\n";
+        }
+
+        out << "    if (a == 0) then\n        acc += 1;\n";
+        for (int d = 1; d <= shape.elseifDepth; ++d) {
+            out << "    elseif (a == " << d << " and b > " << d % 7 << ") then\n"
+                << "        acc = acc * " << (d % 5 + 2) << " - b;\n";
+        }
+        out << "    else\n        acc -= b;\n    end\n";
+
+        out << "    while (acc > 1000) then\n        acc -= 17;\n    end\n";
+
+        out << "    std.io.println(`work_" << f;
+        for (int i = 0; i < shape.formatArgs; ++i) {
+            out << " step " << i << " {acc + " << i << "}";
+        }
+        out << "`);\n";
+
+        if (f > 0) out << "    acc += work_" << f - 1 << "(b, a);\n";
+        out << "    ret acc" << (structIndex >= 0 ? " + shape.x" : "") << ";\nend\n\n";
+    }
+
+    out << "func main() -> i32\n    ret work_" << std::max(shape.functions - 1, 0) << "(1, 2);\nend\n";
+    return out.str();
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int intArg(int argc, char** argv, int& i) {
+    if (i + 1 >= argc) {
+        std::cerr << "Missing value for " << argv[i] << "\n";
+        std::exit(2);
+    }
+    return std::atoi(argv[++i]);
+}
+
+}
+
+int main(int argc, char** argv) {
+    CorpusShape shape;
+    int rounds = 5;
+    bool runCodegen = true;
+    std::string emitPath;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "--functions") shape.functions = intArg(argc, argv, i);
+        else if (a == "--elseif") shape.elseifDepth = intArg(argc, argv, i);
+        else if (a == "--structs") shape.structs = intArg(argc, argv, i);
+        else if (a == "--enums") shape.enums = intArg(argc, argv, i);
+        else if (a == "--format-args") shape.formatArgs = intArg(argc, argv, i);
+        else if (a == "--rounds") rounds = std::max(1, intArg(argc, argv, i));
+        else if (a == "--no-codegen") runCodegen = false;
+        else if (a == "--emit" && i + 1 < argc) emitPath = argv[++i];
+        else {
+            std::cerr << "Usage: summit-bench [--functions N] [--elseif N] [--structs N] [--enums N]\n"
+                         "                    [--format-args N] [--rounds N] [--no-codegen] [--emit <file>]\n";
+            return 2;
+        }
+    }
+
+    std::string source = generateCorpus(shape);
+    if (!emitPath.empty()) {
+        std::ofstream(emitPath, std::ios::binary) << source;
+    }
+
+    size_t tokens = 0, nodes = 0;
+    uint64_t irFunctions = 0, irInstructions = 0;
+    double lexBest = 1e30, parseBest = 1e30, codegenBest = 1e30;
+
+    if (runCodegen) {
+        StdLibManager::getInstance().initializeStandardLibrary(true);
+    }
+
+    try {
+        for (int r = 0; r < rounds; ++r) {
+            StringInterner symbols;
+            Lexer lexer(source, symbols);
+            auto start = std::chrono::steady_clock::now();
+            TokenList tokenList = lexer.tokenize();
+            lexBest = std::min(lexBest, secondsSince(start));
+            tokens = tokenList.size();
+
+            AST::constructedNodeCount = 0;
+            start = std::chrono::steady_clock::now();
+            Parser parser(std::move(tokenList));
+            auto ast = parser.parse();
+            parseBest = std::min(parseBest, secondsSince(start));
+            nodes = AST::constructedNodeCount;
+
+            if (!runCodegen) continue;
+            start = std::chrono::steady_clock::now();
+            AST::SemanticAnalyzer().analyze(*ast);
+            CodeGen codegen(symbols);
+            codegen.setGlobalVariables(parser.getGlobalVariables());
+            ast->codegen(codegen);
+            codegenBest = std::min(codegenBest, secondsSince(start));
+            CodeGen::countIR(codegen.getModule(), irFunctions, irInstructions);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "summit-bench: " << e.what() << "\n";
+        return 1;
+    }
+
+    std::printf("{\"corpus\":{\"bytes\":%zu,\"functions\":%d,\"elseif_depth\":%d,\"structs\":%d,"
+                "\"enums\":%d,\"format_args\":%d},\"rounds\":%d,\n",
+                source.size(), shape.functions, shape.elseifDepth, shape.structs, shape.enums,
+                shape.formatArgs, rounds);
+    std::printf(" \"lex\":{\"seconds\":%.6f,\"tokens\":%zu,\"tokens_per_sec\":%.0f,\"mb_per_sec\":%.1f},\n",
+                lexBest, tokens, tokens / lexBest, source.size() / lexBest / 1e6);
+    std::printf(" \"parse\":{\"seconds\":%.6f,\"nodes\":%zu,\"nodes_per_sec\":%.0f}",
+                parseBest, nodes, nodes / parseBest);
+    if (runCodegen) {
+        std::printf(",\n \"codegen\":{\"seconds\":%.6f,\"functions\":%d,\"functions_per_sec\":%.0f,"
+                    "\"ir_functions\":%llu,\"ir_instructions\":%llu}",
+                    codegenBest, shape.functions + 1, (shape.functions + 1) / codegenBest,
+                    static_cast<unsigned long long>(irFunctions),
+                    static_cast<unsigned long long>(irInstructions));
+    }
+    std::printf("}\n");
+    return 0;
+}
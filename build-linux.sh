@@ -3,6 +3,7 @@ set -euo pipefail
 
 
 c=clang++
+cc=clang
 s=src
 b=build-linux
 bin="$b/bin"
@@ -12,10 +13,11 @@ n=$(nproc)
 cf="-std=c++17 -O2 \
 -fdata-sections -ffunction-sections -DNDEBUG \
 -Isrc -Iinclude -Iinclude/codegen -Iinclude/ast -Iinclude/utils -Iinclude/lexer -Iinclude/parser \
--I/usr/include/llvm-18 -I/usr/include/llvm \
+-I/usr/include/llvm-18 -I/usr/include/llvm -I/usr/lib/llvm-18/include \
+-DSUMMIT_HAVE_LLD \
 -fmerge-all-constants -fno-stack-protector -fno-math-errno -fno-ident -w"
 
-lf="-L/usr/lib/llvm-18/lib -lLLVM-18 -ltommath \
+lf="-L/usr/lib/llvm-18/lib -llldELF -llldCommon -lLLVM-18 -ltommath \
 -Wl,--gc-sections,--as-needed,--strip-all,-s -flto -Wl,-O3"
 
 run(){ echo "+ $*"; "$@"; }
@@ -35,6 +37,12 @@ build(){
         '"$c"' '"$cf"' -c "$1" -o "$o"
     ' _ {}
 
+    # runtime linked into the compiler for `summit run` (JIT)
+    run mkdir -p "$b/runtime"
+    for f in stdlib/*.c; do
+        run $cc -O2 -fPIC -w -c "$f" -o "$b/runtime/$(basename "${f%.c}").o"
+    done
+
     objs=$(find "$b" -name '*.o')
     run $c $objs $lf -o "$t"
 
@@ -45,6 +45,7 @@ for source in "${C_SOURCES[@]}"; do
 done
 
 OBJECT_FILES=()
+BITCODE_FILES=()
 
 for source_file in "${C_SOURCES[@]}"; do
     base_name=$(basename "$source_file" .c)
@@ -68,8 +69,42 @@ for source_file in "${C_SOURCES[@]}"; do
         exit 1
     fi
     OBJECT_FILES+=("$object_file")
+
+    # bitcode copy, linked into user modules so the runtime can be inlined
+    bitcode_file="$BUILD_DIR/$base_name.bc"
+    if [ "$OS_TYPE" = "windows" ]; then
+        clang -c -emit-llvm -O2 -I"$INCLUDE_DIR" "$source_file" -o "$bitcode_file"
+    else
+        clang -c -emit-llvm -O2 -fPIC -I"$INCLUDE_DIR" "$source_file" -o "$bitcode_file"
+    fi
+
+    if [ $? -ne 0 ]; then
+        echo "Failed to compile $source_file to bitcode"
+        exit 1
+    fi
+    BITCODE_FILES+=("$bitcode_file")
 done
 
+LLVM_LINK=""
+for candidate in llvm-link llvm-link-18; do
+    if command -v "$candidate" &> /dev/null; then
+        LLVM_LINK="$candidate"
+        break
+    fi
+done
+
+if [ -n "$LLVM_LINK" ]; then
+    echo "Linking runtime bitcode from ${#BITCODE_FILES[@]} modules..."
+    "$LLVM_LINK" "${BITCODE_FILES[@]}" -o "$LIB_DIR/libsummit.bc"
+    if [ $? -eq 0 ]; then
+        echo "  Bitcode: $LIB_DIR/libsummit.bc"
+    else
+        echo "Failed to link runtime bitcode (continuing anyway)"
+    fi
+else
+    echo "llvm-link not found, skipping runtime bitcode (continuing anyway)"
+fi
+
 echo "Creating static library from ${#OBJECT_FILES[@]} object files..."
 
 if [ "$OS_TYPE" = "windows" ]; then
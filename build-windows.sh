@@ -38,7 +38,7 @@ $LLVM_CXXFLAGS \
 -fmerge-all-constants -fno-stack-protector -fno-math-errno -fno-ident -w \
 -D__USE_MINGW_ANSI_STDIO=1"
 
-LDFLAGS="$LLVM_LDFLAGS -ltommath -lstdc++ -lstdc++fs -Wl,--gc-sections,--as-needed,--strip-all,-s"
+LDFLAGS="$LLVM_LDFLAGS -ltommath -lpsapi -lstdc++ -lstdc++fs -Wl,--gc-sections,--as-needed,--strip-all,-s"
 
 
 run() { echo "+ $*"; "$@"; }
@@ -69,6 +69,13 @@ build() {
         "$CXX" $CXXFLAGS -c "$src" -o "$obj"
     '
 
+    # runtime linked into the compiler for `summit run` (JIT)
+    CC_RUNTIME=${CC:-gcc}
+    mkdir -p "$BUILD_DIR/runtime"
+    for f in stdlib/*.c; do
+        run "$CC_RUNTIME" -O2 -w -D__USE_MINGW_ANSI_STDIO=1 -c "$f" -o "$BUILD_DIR/runtime/$(basename "${f%.c}").o"
+    done
+
     OBJS=$(find "$BUILD_DIR" -name '*.o')
     if [[ -z "$OBJS" ]]; then
         echo "No object files found to link."
@@ -0,0 +1,25 @@
+#!/usr/bin/env bash
+# Runs every example here with `summit run` and compares its output with NAME.out;
+# an example with NAME.err instead must fail to compile with that message.
+# SUMMIT overrides the compiler (default: build-linux/bin/summit).
+set -uo pipefail
+
+summit=${SUMMIT:-build-linux/bin/summit}
+dir=$(dirname "$0")
+fail=0
+
+for src in "$dir"/*.sm; do
+    name=${src%.sm}
+    if [ -f "$name.err" ]; then
+        if out=$("$summit" run "$src" 2>&1); then
+            echo "FAIL $src: compiled, expected: $(cat "$name.err")"; fail=1
+        elif ! grep -qF -- "$(cat "$name.err")" <<<"$out"; then
+            echo "FAIL $src: $out"; fail=1
+        fi
+    elif ! out=$("$summit" run "$src" 2>&1) || [ "$out" != "$(cat "$name.out")" ]; then
+        echo "FAIL $src"; diff <(echo "$out") "$name.out"; fail=1
+    fi
+done
+
+[ "$fail" -eq 0 ] && echo "integer examples: all passed"
+exit "$fail"
@@ -0,0 +1,81 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace AST {
+
+/* Bump allocator owned by a Program: its nodes and child lists are carved out of a few large
+   blocks and the blocks are freed together with the Program; single frees are no-ops */
+class Arena {
+public:
+    Arena() = default;
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* allocate(size_t size, size_t align);
+    size_t bytesAllocated() const { return allocated; }
+
+    /* Arena that nodes created on this thread go to; nullptr means the global heap */
+    static Arena* current();
+
+    /* Makes arena current for the lifetime of the scope */
+    class Scope {
+        Arena* previous;
+    public:
+        explicit Scope(Arena* arena);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    /* operator new/delete for Expr and Stmt: each node records the arena it came from (or
+       nullptr for the heap), so deleting a node is right wherever and whenever it happens */
+    static void* allocateNode(size_t size);
+    static void releaseNode(void* node) noexcept;
+
+private:
+    static constexpr size_t FIRST_BLOCK_SIZE = 64 * 1024;
+    static constexpr size_t MAX_BLOCK_SIZE = 1024 * 1024;
+
+    std::vector<std::unique_ptr<std::byte[]>> blocks;
+    std::byte* cursor = nullptr;
+    std::byte* limit = nullptr;
+    size_t nextBlockSize = FIRST_BLOCK_SIZE;
+    size_t allocated = 0;
+};
+
+/* Standard allocator over the arena current when the container is created, so child lists
+   built while parsing live next to their nodes */
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    ArenaAllocator() noexcept : arena(Arena::current()) {}
+    explicit ArenaAllocator(Arena* arena) noexcept : arena(arena) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena(other.arena) {}
+
+    T* allocate(size_t n) {
+        if (arena) return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t) noexcept {
+        if (!arena) ::operator delete(p);
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept { return arena == other.arena; }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const noexcept { return arena != other.arena; }
+
+    Arena* arena;
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+}
@@ -1,5 +1,7 @@
 #pragma once
+#include <cstdint>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <vector>
 #include <sstream>
@@ -7,6 +9,7 @@
 #include <llvm/IR/Value.h>
 #include "utils/bigint.h"
 #include "ast/ast_types.h"
+#include "ast/arena.h"
 #include "codegen/bounds.h"
 
 class CodeGen;
@@ -23,25 +26,82 @@ inline std::string quoted(const std::string& s) {
 
 inline std::string boolStr(bool b) { return b ? "true" : "false"; }
 
+/* Nodes constructed on this thread, for --time-report; per-thread so parallel builds count per file */
+inline thread_local size_t constructedNodeCount = 0;
+
+/* Concrete class of a node, so passes can switch on it instead of using virtual calls or
+   dynamic_cast; see visit(), as() and is() */
+enum class ExprKind : uint8_t {
+    String, Number, FormatString, Float, Boolean, Variable, Binary, Call, Cast,
+    Module, MemberAccess, Unary, EnumValue, StructLiteral
+};
+
+enum class StmtKind : uint8_t {
+    VariableDecl, Assignment, Block, If, Function, MemberAssignment, While, ForLoop,
+    Entrypoint, Return, Expr, EnumDecl, Break, Continue, StructDecl
+};
+
+/* Nodes hand out their child slots through non-const accessors as well, so a pass over the
+   tree (constant folding in SemanticAnalyzer) can replace a subtree in place */
 class Expr {
+    const ExprKind kind;
+    VarType resolvedType = VarType::VOID;
+    const std::string* resolvedStructName = nullptr;
 public:
+    explicit Expr(ExprKind kind) : kind(kind) { ++constructedNodeCount; }
     virtual ~Expr() = default;
-    virtual llvm::Value* codegen(::CodeGen& context) = 0;
+    static void* operator new(size_t size) { return Arena::allocateNode(size); }
+    static void operator delete(void* node) noexcept { Arena::releaseNode(node); }
+    ExprKind getKind() const { return kind; }
+
+    /* Source type recorded by SemanticAnalyzer; VOID until it runs and for expressions it
+       cannot type. For STRUCT the name points into the declaring node, else nullptr */
+    VarType getResolvedType() const { return resolvedType; }
+    const std::string* getResolvedStructName() const { return resolvedStructName; }
+    void setResolvedType(VarType type, const std::string* structName = nullptr) {
+        resolvedType = type;
+        resolvedStructName = structName;
+    }
+    /* CodeGen::codegen for the concrete class, chosen by kind */
+    llvm::Value* codegen(::CodeGen& context);
     virtual std::string toString(int indent = 0) const = 0;
 };
 
 class Stmt {
+    const StmtKind kind;
 public:
+    explicit Stmt(StmtKind kind) : kind(kind) { ++constructedNodeCount; }
     virtual ~Stmt() = default;
-    virtual llvm::Value* codegen(::CodeGen& context) = 0;
+    static void* operator new(size_t size) { return Arena::allocateNode(size); }
+    static void operator delete(void* node) noexcept { Arena::releaseNode(node); }
+    StmtKind getKind() const { return kind; }
+    /* CodeGen::codegen for the concrete class, chosen by kind */
+    llvm::Value* codegen(::CodeGen& context);
     virtual std::string toString(int indent = 0) const = 0;
 };
 
+/* node as a T if that is its concrete class, else nullptr (also for a null node) */
+template <typename T, typename Node>
+T* as(Node* node) {
+    return node && node->getKind() == T::KIND ? static_cast<T*>(node) : nullptr;
+}
+
+template <typename T, typename Node>
+const T* as(const Node* node) {
+    return node && node->getKind() == T::KIND ? static_cast<const T*>(node) : nullptr;
+}
+
+template <typename T, typename Node>
+bool is(const Node* node) {
+    return node && node->getKind() == T::KIND;
+}
+
 class StringExpr : public Expr {
     std::string value;
 public:
-    StringExpr(const std::string& val) : value(val) {}
-    llvm::Value* codegen(::CodeGen& context) override;
+    static constexpr ExprKind KIND = ExprKind::String;
+
+    StringExpr(const std::string& val) : Expr(KIND), value(val) {}
     const std::string& getValue() const { return value; }
     std::string toString(int indent = 0) const override {
         return indentStr(indent) + "StringExpr: " + quoted(value);
@@ -50,8 +110,10 @@ public:
 class NumberExpr : public Expr {
     BigInt value;
 public:
-    NumberExpr(const BigInt& val) : value(val) {}
-    NumberExpr(const std::string& str) {
+    static constexpr ExprKind KIND = ExprKind::Number;
+
+    NumberExpr(BigInt val) : Expr(KIND), value(std::move(val)) {}
+    NumberExpr(const std::string& str) : Expr(KIND) {
         if (str.length() >= 2 && str.substr(0, 2) == "0b") {
             std::string binStr = str.substr(2);
             binStr.erase(std::remove(binStr.begin(), binStr.end(), '_'), binStr.end());
@@ -98,23 +160,27 @@ public:
         }
     }
     
-    llvm::Value* codegen(::CodeGen& context) override;
     const BigInt& getValue() const { return value; }
     std::string toString(int indent = 0) const override {
         return indentStr(indent) + "NumberExpr: " + value.toString();
     }
 };
 
+/* literals are the text around the placeholders (one more than expressions), as split by the lexer */
 class FormatStringExpr : public Expr {
     std::string formatStr;
-    std::vector<std::unique_ptr<Expr>> expressions;
+    std::vector<std::string> literals;
+    ArenaVector<std::unique_ptr<Expr>> expressions;
 public:
-    FormatStringExpr(std::string formatStr, std::vector<std::unique_ptr<Expr>> exprs)
-        : formatStr(std::move(formatStr)), expressions(std::move(exprs)) {}
+    static constexpr ExprKind KIND = ExprKind::FormatString;
+
+    FormatStringExpr(std::string formatStr, std::vector<std::string> literals, ArenaVector<std::unique_ptr<Expr>> exprs)
+        : Expr(KIND), formatStr(std::move(formatStr)), literals(std::move(literals)), expressions(std::move(exprs)) {}
 
-    llvm::Value* codegen(::CodeGen& context) override;
     const std::string& getFormatStr() const { return formatStr; }
-    const std::vector<std::unique_ptr<Expr>>& getExpressions() const { return expressions; }
+    const std::vector<std::string>& getLiterals() const { return literals; }
+    const ArenaVector<std::unique_ptr<Expr>>& getExpressions() const { return expressions; }
+    ArenaVector<std::unique_ptr<Expr>>& getExpressions() { return expressions; }
     
     std::string toString(int indent = 0) const override {
         std::ostringstream oss;
@@ -131,10 +197,11 @@ class FloatExpr : public Expr {
     double value;
     VarType floatType;
 public:
-    FloatExpr(double val, VarType type = VarType::FLOAT64) : value(val), floatType(type) {}
+    static constexpr ExprKind KIND = ExprKind::Float;
+
+    FloatExpr(double val, VarType type = VarType::FLOAT64) : Expr(KIND), value(val), floatType(type) {}
     double getValue() const { return value; }
     VarType getFloatType() const { return floatType; }
-    llvm::Value* codegen(CodeGen& context) override;
     std::string toString(int indent = 0) const override {
         std::ostringstream oss;
         oss << indentStr(indent) 
@@ -147,8 +214,9 @@ public:
 class BooleanExpr : public Expr {
     bool value;
 public:
-    BooleanExpr(bool val) : value(val) {}
-    llvm::Value* codegen(::CodeGen& context) override;
+    static constexpr ExprKind KIND = ExprKind::Boolean;
+
+    BooleanExpr(bool val) : Expr(KIND), value(val) {}
     bool getValue() const { return value; }
     std::string toString(int indent = 0) const override {
         return indentStr(indent) + "BooleanExpr: " + boolStr(value);
@@ -158,8 +226,9 @@ public:
 class VariableExpr : public Expr {
     std::string name;
 public:
-    VariableExpr(const std::string& name) : name(name) {}
-    llvm::Value* codegen(::CodeGen& context) override;
+    static constexpr ExprKind KIND = ExprKind::Variable;
+
+    VariableExpr(const std::string& name) : Expr(KIND), name(name) {}
     const std::string& getName() const { return name; }
     std::string toString(int indent = 0) const override {
         return indentStr(indent) + "VariableExpr: " + quoted(name);
@@ -171,12 +240,15 @@ class BinaryExpr : public Expr {
     std::unique_ptr<Expr> lhs;
     std::unique_ptr<Expr> rhs;
 public:
+    static constexpr ExprKind KIND = ExprKind::Binary;
+
     BinaryExpr(BinaryOp op, std::unique_ptr<Expr> lhs, std::unique_ptr<Expr> rhs)
-        : op(op), lhs(std::move(lhs)), rhs(std::move(rhs)) {}
-    llvm::Value* codegen(::CodeGen& context) override;
+        : Expr(KIND), op(op), lhs(std::move(lhs)), rhs(std::move(rhs)) {}
     BinaryOp getOp() const { return op; }
     const std::unique_ptr<Expr>& getLHS() const { return lhs; }
+    std::unique_ptr<Expr>& getLHS() { return lhs; }
     const std::unique_ptr<Expr>& getRHS() const { return rhs; }
+    std::unique_ptr<Expr>& getRHS() { return rhs; }
     std::string toString(int indent = 0) const override {
         std::ostringstream oss;
         oss << indentStr(indent) << "BinaryExpr (Op: " << static_cast<int>(op) << ")\n";
@@ -188,19 +260,21 @@ public:
 class CallExpr : public Expr {
     std::string callee;
     std::unique_ptr<Expr> calleeExpr;
-    std::vector<std::unique_ptr<Expr>> args;
+    ArenaVector<std::unique_ptr<Expr>> args;
 public:
-    CallExpr(const std::string& callee, std::vector<std::unique_ptr<Expr>> args)
-        : callee(callee), args(std::move(args)) {}
-    
-    CallExpr(std::unique_ptr<Expr> calleeExpr, std::vector<std::unique_ptr<Expr>> args)
-        : calleeExpr(std::move(calleeExpr)), args(std::move(args)) {}
+    static constexpr ExprKind KIND = ExprKind::Call;
+
+    CallExpr(const std::string& callee, ArenaVector<std::unique_ptr<Expr>> args)
+        : Expr(KIND), callee(callee), args(std::move(args)) {}
     
-    llvm::Value* codegen(::CodeGen& context) override;
+    CallExpr(std::unique_ptr<Expr> calleeExpr, ArenaVector<std::unique_ptr<Expr>> args)
+        : Expr(KIND), calleeExpr(std::move(calleeExpr)), args(std::move(args)) {}
     
     const std::string& getCallee() const { return callee; }
     const std::unique_ptr<Expr>& getCalleeExpr() const { return calleeExpr; }
-    const std::vector<std::unique_ptr<Expr>>& getArgs() const { return args; }
+    std::unique_ptr<Expr>& getCalleeExpr() { return calleeExpr; }
+    const ArenaVector<std::unique_ptr<Expr>>& getArgs() const { return args; }
+    ArenaVector<std::unique_ptr<Expr>>& getArgs() { return args; }
     
     std::string toString(int indent = 0) const override {
         std::ostringstream oss;
@@ -221,10 +295,12 @@ class CastExpr : public Expr {
     std::unique_ptr<Expr> expr;
     VarType targetType;
 public:
+    static constexpr ExprKind KIND = ExprKind::Cast;
+
     CastExpr(std::unique_ptr<Expr> expr, VarType targetType)
-        : expr(std::move(expr)), targetType(targetType) {}
-    llvm::Value* codegen(::CodeGen& context) override;
+        : Expr(KIND), expr(std::move(expr)), targetType(targetType) {}
     Expr* getExpr() const { return expr.get(); }
+    std::unique_ptr<Expr>& getExprSlot() { return expr; }
     VarType getTargetType() const { return targetType; }
     std::string toString(int indent = 0) const override {
         std::ostringstream oss;
@@ -242,17 +318,18 @@ class VariableDecl : public Stmt {
     std::string structName;
 
 public:
+    static constexpr StmtKind KIND = StmtKind::VariableDecl;
+
     VariableDecl(const std::string& name, VarType type, bool isConst, 
                  std::unique_ptr<Expr> value, const std::string& structName = "")
-        : name(name), type(type), isConst(isConst), 
+        : Stmt(KIND), name(name), type(type), isConst(isConst), 
           value(std::move(value)), structName(structName) {}
     
-    llvm::Value* codegen(::CodeGen& context) override;
-    
     const std::string& getName() const { return name; }
     VarType getType() const { return type; }
     bool getIsConst() const { return isConst; }
     const std::unique_ptr<Expr>& getValue() const { return value; }
+    std::unique_ptr<Expr>& getValue() { return value; }
     const std::string& getStructName() const { return structName; }
     
     std::string toString(int indent = 0) const override {
@@ -274,11 +351,13 @@ class AssignmentStmt : public Stmt {
     std::string name;
     std::unique_ptr<Expr> value;
 public:
+    static constexpr StmtKind KIND = StmtKind::Assignment;
+
     AssignmentStmt(const std::string& name, std::unique_ptr<Expr> value)
-        : name(name), value(std::move(value)) {}
-    llvm::Value* codegen(::CodeGen& context) override;
+        : Stmt(KIND), name(name), value(std::move(value)) {}
     const std::string& getName() const { return name; }
     const std::unique_ptr<Expr>& getValue() const { return value; }
+    std::unique_ptr<Expr>& getValue() { return value; }
     std::string toString(int indent = 0) const override {
         std::ostringstream oss;
         oss << indentStr(indent) << "AssignmentStmt: " << quoted(name) << "\n";
@@ -288,15 +367,16 @@ public:
 };
 
 class BlockStmt : public Stmt {
-    std::vector<std::unique_ptr<Stmt>> statements;
+    ArenaVector<std::unique_ptr<Stmt>> statements;
 public:
+    static constexpr StmtKind KIND = StmtKind::Block;
+    BlockStmt() : Stmt(KIND) {}
+
     void addStatement(std::unique_ptr<Stmt> stmt) {
         statements.push_back(std::move(stmt));
     }
     
-    llvm::Value* codegen(::CodeGen& context) override;
-    
-    const std::vector<std::unique_ptr<Stmt>>& getStatements() const { return statements; }
+    const ArenaVector<std::unique_ptr<Stmt>>& getStatements() const { return statements; }
     
     std::string toString(int indent = 0) const override {
         std::ostringstream oss;
@@ -312,12 +392,13 @@ class IfStmt : public Stmt {
     std::unique_ptr<Stmt> thenBranch;
     std::unique_ptr<Stmt> elseBranch;
 public:
+    static constexpr StmtKind KIND = StmtKind::If;
+
     IfStmt(std::unique_ptr<Expr> condition, std::unique_ptr<Stmt> thenBranch, std::unique_ptr<Stmt> elseBranch = nullptr)
-        : condition(std::move(condition)), thenBranch(std::move(thenBranch)), elseBranch(std::move(elseBranch)) {}
-    
-    llvm::Value* codegen(::CodeGen& context) override;
+        : Stmt(KIND), condition(std::move(condition)), thenBranch(std::move(thenBranch)), elseBranch(std::move(elseBranch)) {}
     
     const std::unique_ptr<Expr>& getCondition() const { return condition; }
+    std::unique_ptr<Expr>& getCondition() { return condition; }
     const std::unique_ptr<Stmt>& getThenBranch() const { return thenBranch; }
     const std::unique_ptr<Stmt>& getElseBranch() const { return elseBranch; }
     
@@ -346,18 +427,18 @@ class FunctionStmt : public Stmt {
     std::vector<std::string> parameterStructNames;
 
 public:
+    static constexpr StmtKind KIND = StmtKind::Function;
+
     FunctionStmt(const std::string& name, 
                  std::vector<std::pair<std::string, VarType>> parameters,
                  VarType returnType,
                  std::unique_ptr<BlockStmt> body,
                  bool isEntryPoint = false,
                  std::string returnStructName = "")
-        : name(name), parameters(std::move(parameters)), 
+        : Stmt(KIND), name(name), parameters(std::move(parameters)), 
           returnType(returnType), body(std::move(body)), 
           isEntryPoint(isEntryPoint), returnStructName(std::move(returnStructName)) {}
     
-    llvm::Value* codegen(::CodeGen& context) override;
-    
     const std::string& getName() const { return name; }
     const std::vector<std::pair<std::string, VarType>>& getParameters() const { return parameters; }
     VarType getReturnType() const { return returnType; }
@@ -406,14 +487,16 @@ class MemberAssignmentStmt : public Stmt {
     std::unique_ptr<Expr> value;
 
 public:
-    MemberAssignmentStmt(std::unique_ptr<Expr> obj, const std::string& member, std::unique_ptr<Expr> val)
-        : object(std::move(obj)), memberName(member), value(std::move(val)) {}
+    static constexpr StmtKind KIND = StmtKind::MemberAssignment;
 
-    llvm::Value* codegen(::CodeGen& context) override;
+    MemberAssignmentStmt(std::unique_ptr<Expr> obj, const std::string& member, std::unique_ptr<Expr> val)
+        : Stmt(KIND), object(std::move(obj)), memberName(member), value(std::move(val)) {}
 
     const std::unique_ptr<Expr>& getObject() const { return object; }
+    std::unique_ptr<Expr>& getObject() { return object; }
     const std::string& getMemberName() const { return memberName; }
     const std::unique_ptr<Expr>& getValue() const { return value; }
+    std::unique_ptr<Expr>& getValue() { return value; }
 
     std::string toString(int indent = 0) const override {
         std::ostringstream oss;
@@ -431,12 +514,13 @@ class WhileStmt : public Stmt {
     std::unique_ptr<Expr> condition;
     std::unique_ptr<BlockStmt> body;
 public:
+    static constexpr StmtKind KIND = StmtKind::While;
+
     WhileStmt(std::unique_ptr<Expr> condition, std::unique_ptr<BlockStmt> body)
-        : condition(std::move(condition)), body(std::move(body)) {}
-    
-    llvm::Value* codegen(::CodeGen& context) override;
+        : Stmt(KIND), condition(std::move(condition)), body(std::move(body)) {}
     
     const std::unique_ptr<Expr>& getCondition() const { return condition; }
+    std::unique_ptr<Expr>& getCondition() { return condition; }
     const std::unique_ptr<BlockStmt>& getBody() const { return body; }
     
     std::string toString(int indent = 0) const override {
@@ -458,22 +542,25 @@ class ForLoopStmt : public Stmt {
     std::unique_ptr<Expr> increment;
     std::unique_ptr<BlockStmt> body;
 public:
+    static constexpr StmtKind KIND = StmtKind::ForLoop;
+
     ForLoopStmt(const std::string& varName, VarType varType,
                 std::unique_ptr<Expr> initializer,
                 std::unique_ptr<Expr> condition,
                 std::unique_ptr<Expr> increment,
                 std::unique_ptr<BlockStmt> body)
-        : varName(varName), varType(varType), initializer(std::move(initializer)),
+        : Stmt(KIND), varName(varName), varType(varType), initializer(std::move(initializer)),
           condition(std::move(condition)), increment(std::move(increment)),
           body(std::move(body)) {}
     
-    llvm::Value* codegen(::CodeGen& context) override;
-    
     const std::string& getVarName() const { return varName; }
     VarType getVarType() const { return varType; }
     const std::unique_ptr<Expr>& getInitializer() const { return initializer; }
+    std::unique_ptr<Expr>& getInitializer() { return initializer; }
     const std::unique_ptr<Expr>& getCondition() const { return condition; }
+    std::unique_ptr<Expr>& getCondition() { return condition; }
     const std::unique_ptr<Expr>& getIncrement() const { return increment; }
+    std::unique_ptr<Expr>& getIncrement() { return increment; }
     const std::unique_ptr<BlockStmt>& getBody() const { return body; }
     
     std::string toString(int indent = 0) const override {
@@ -494,11 +581,9 @@ public:
 
 class EntrypointStmt : public Stmt {
 public:
-    EntrypointStmt() = default;
-    
-    llvm::Value* codegen(::CodeGen& context) override {
-        return nullptr;
-    }
+    static constexpr StmtKind KIND = StmtKind::Entrypoint;
+
+    EntrypointStmt() : Stmt(KIND) {}
     
     std::string toString(int indent = 0) const override {
         return indentStr(indent) + "EntrypointStmt";
@@ -508,11 +593,12 @@ public:
 class ReturnStmt : public Stmt {
     std::unique_ptr<Expr> value;
 public:
-    ReturnStmt(std::unique_ptr<Expr> value = nullptr) : value(std::move(value)) {}
-    
-    llvm::Value* codegen(::CodeGen& context) override;
+    static constexpr StmtKind KIND = StmtKind::Return;
+
+    ReturnStmt(std::unique_ptr<Expr> value = nullptr) : Stmt(KIND), value(std::move(value)) {}
     
     const std::unique_ptr<Expr>& getValue() const { return value; }
+    std::unique_ptr<Expr>& getValue() { return value; }
     
     std::string toString(int indent = 0) const override {
         std::ostringstream oss;
@@ -525,8 +611,9 @@ public:
 class ModuleExpr : public Expr {
     std::string moduleName;
 public:
-    ModuleExpr(const std::string& name) : moduleName(name) {}
-    llvm::Value* codegen(::CodeGen& context) override;
+    static constexpr ExprKind KIND = ExprKind::Module;
+
+    ModuleExpr(const std::string& name) : Expr(KIND), moduleName(name) {}
     const std::string& getModuleName() const { return moduleName; }
     std::string toString(int indent = 0) const override {
         return indentStr(indent) + "ModuleExpr: " + quoted(moduleName);
@@ -537,10 +624,12 @@ class MemberAccessExpr : public Expr {
     std::unique_ptr<Expr> object;
     std::string member;
 public:
+    static constexpr ExprKind KIND = ExprKind::MemberAccess;
+
     MemberAccessExpr(std::unique_ptr<Expr> object, const std::string& member)
-        : object(std::move(object)), member(member) {}
-    llvm::Value* codegen(::CodeGen& context) override;
+        : Expr(KIND), object(std::move(object)), member(member) {}
     const std::unique_ptr<Expr>& getObject() const { return object; }
+    std::unique_ptr<Expr>& getObject() { return object; }
     const std::string& getMember() const { return member; }
     std::string toString(int indent = 0) const override {
         std::ostringstream oss;
@@ -554,12 +643,14 @@ class UnaryExpr : public Expr {
     UnaryOp op;
     std::unique_ptr<Expr> operand;
 public:
+    static constexpr ExprKind KIND = ExprKind::Unary;
+
     UnaryExpr(UnaryOp op, std::unique_ptr<Expr> operand)
-        : op(op), operand(std::move(operand)) {}
+        : Expr(KIND), op(op), operand(std::move(operand)) {}
     
-    llvm::Value* codegen(CodeGen& context) override;
     UnaryOp getOp() const { return op; }
     Expr* getOperand() const { return operand.get(); }
+    std::unique_ptr<Expr>& getOperandSlot() { return operand; }
     
     std::string toString(int indent = 0) const override {
         std::ostringstream oss;
@@ -572,9 +663,11 @@ public:
 class ExprStmt : public Stmt {
     std::unique_ptr<Expr> expr;
 public:
-    ExprStmt(std::unique_ptr<Expr> expr) : expr(std::move(expr)) {}
-    llvm::Value* codegen(::CodeGen& context) override;
+    static constexpr StmtKind KIND = StmtKind::Expr;
+
+    ExprStmt(std::unique_ptr<Expr> expr) : Stmt(KIND), expr(std::move(expr)) {}
     const std::unique_ptr<Expr>& getExpr() const { return expr; }
+    std::unique_ptr<Expr>& getExpr() { return expr; }
     std::string toString(int indent = 0) const override {
         std::ostringstream oss;
         oss << indentStr(indent) << "ExprStmt\n";
@@ -585,16 +678,17 @@ public:
 
 class EnumDecl : public Stmt {
     std::string name;
-    std::vector<std::pair<std::string, std::unique_ptr<Expr>>> members;
+    ArenaVector<std::pair<std::string, std::unique_ptr<Expr>>> members;
 public:
+    static constexpr StmtKind KIND = StmtKind::EnumDecl;
+
     EnumDecl(const std::string& name, 
-             std::vector<std::pair<std::string, std::unique_ptr<Expr>>> members)
-        : name(name), members(std::move(members)) {}
-    
-    llvm::Value* codegen(::CodeGen& context) override;
+             ArenaVector<std::pair<std::string, std::unique_ptr<Expr>>> members)
+        : Stmt(KIND), name(name), members(std::move(members)) {}
     
     const std::string& getName() const { return name; }
-    const std::vector<std::pair<std::string, std::unique_ptr<Expr>>>& getMembers() const { return members; }
+    const ArenaVector<std::pair<std::string, std::unique_ptr<Expr>>>& getMembers() const { return members; }
+    ArenaVector<std::pair<std::string, std::unique_ptr<Expr>>>& getMembers() { return members; }
     
     std::string toString(int indent = 0) const override {
         std::ostringstream oss;
@@ -616,10 +710,10 @@ class EnumValueExpr : public Expr {
     std::string enumName;
     std::string memberName;
 public:
+    static constexpr ExprKind KIND = ExprKind::EnumValue;
+
     EnumValueExpr(const std::string& enumName, const std::string& memberName)
-        : enumName(enumName), memberName(memberName) {}
-    
-    llvm::Value* codegen(::CodeGen& context) override;
+        : Expr(KIND), enumName(enumName), memberName(memberName) {}
     
     const std::string& getEnumName() const { return enumName; }
     const std::string& getMemberName() const { return memberName; }
@@ -631,9 +725,9 @@ public:
 
 class BreakStmt : public Stmt {
 public:
-    BreakStmt() = default;
-    
-    llvm::Value* codegen(::CodeGen& context) override;
+    static constexpr StmtKind KIND = StmtKind::Break;
+
+    BreakStmt() : Stmt(KIND) {}
     
     std::string toString(int indent = 0) const override {
         return indentStr(indent) + "BreakStmt";
@@ -642,9 +736,9 @@ public:
 
 class ContinueStmt : public Stmt {
 public:
-    ContinueStmt() = default;
-    
-    llvm::Value* codegen(::CodeGen& context) override;
+    static constexpr StmtKind KIND = StmtKind::Continue;
+
+    ContinueStmt() : Stmt(KIND) {}
     
     std::string toString(int indent = 0) const override {
         return indentStr(indent) + "ContinueStmt";
@@ -653,13 +747,15 @@ public:
 class StructDecl : public Stmt {
     std::string name;
     std::vector<std::pair<std::string, VarType>> fields;
-    std::vector<std::unique_ptr<FunctionStmt>> methods;
+    ArenaVector<std::unique_ptr<FunctionStmt>> methods;
     std::unordered_map<std::string, std::unique_ptr<Expr>> fieldDefaults;
 public:
+    static constexpr StmtKind KIND = StmtKind::StructDecl;
+
     StructDecl(const std::string& name, 
                std::vector<std::pair<std::string, VarType>> fields,
-               std::vector<std::unique_ptr<FunctionStmt>> methods = {})
-        : name(name), fields(std::move(fields)), methods(std::move(methods)) {}
+               ArenaVector<std::unique_ptr<FunctionStmt>> methods = {})
+        : Stmt(KIND), name(name), fields(std::move(fields)), methods(std::move(methods)) {}
     
     void addFieldDefault(const std::string& fieldName, std::unique_ptr<Expr> defaultValue) {
         fieldDefaults[fieldName] = std::move(defaultValue);
@@ -673,12 +769,13 @@ public:
     const std::unordered_map<std::string, std::unique_ptr<Expr>>& getFieldDefaults() const {
         return fieldDefaults;
     }
-    
-    llvm::Value* codegen(::CodeGen& context) override;
+    std::unordered_map<std::string, std::unique_ptr<Expr>>& getFieldDefaults() {
+        return fieldDefaults;
+    }
     
     const std::string& getName() const { return name; }
     const std::vector<std::pair<std::string, VarType>>& getFields() const { return fields; }
-    const std::vector<std::unique_ptr<FunctionStmt>>& getMethods() const { return methods; }
+    const ArenaVector<std::unique_ptr<FunctionStmt>>& getMethods() const { return methods; }
     
     std::string toString(int indent = 0) const override {
         std::ostringstream oss;
@@ -706,16 +803,17 @@ public:
 };
 class StructLiteralExpr : public Expr {
     std::string structName;
-    std::vector<std::pair<std::string, std::unique_ptr<Expr>>> fields;
+    ArenaVector<std::pair<std::string, std::unique_ptr<Expr>>> fields;
 public:
+    static constexpr ExprKind KIND = ExprKind::StructLiteral;
+
     StructLiteralExpr(const std::string& structName,
-                     std::vector<std::pair<std::string, std::unique_ptr<Expr>>> fields)
-        : structName(structName), fields(std::move(fields)) {}
-    
-    llvm::Value* codegen(::CodeGen& context) override;
+                     ArenaVector<std::pair<std::string, std::unique_ptr<Expr>>> fields)
+        : Expr(KIND), structName(structName), fields(std::move(fields)) {}
     
     const std::string& getStructName() const { return structName; }
-    const std::vector<std::pair<std::string, std::unique_ptr<Expr>>>& getFields() const { return fields; }
+    const ArenaVector<std::pair<std::string, std::unique_ptr<Expr>>>& getFields() const { return fields; }
+    ArenaVector<std::pair<std::string, std::unique_ptr<Expr>>>& getFields() { return fields; }
     
     std::string toString(int indent = 0) const override {
         std::ostringstream oss;
@@ -735,11 +833,16 @@ public:
 };
 
 class Program {
-    std::vector<std::unique_ptr<Stmt>> statements;
+    /* Declared first so every node is destroyed before the memory goes */
+    std::unique_ptr<Arena> arena = std::make_unique<Arena>();
+    ArenaVector<std::unique_ptr<Stmt>> statements{ArenaAllocator<std::unique_ptr<Stmt>>(arena.get())};
     std::string entryPointFunction;
     bool hasEntryPoint = false;
 
 public:
+    /* Parsers place this program's nodes here (see Arena::Scope) */
+    Arena& getArena() { return *arena; }
+
     void addStatement(std::unique_ptr<Stmt> stmt) {
         statements.push_back(std::move(stmt));
     }
@@ -762,7 +865,7 @@ public:
     
     llvm::Value* codegen(::CodeGen& context);
     
-    const std::vector<std::unique_ptr<Stmt>>& getStatements() const { 
+    const ArenaVector<std::unique_ptr<Stmt>>& getStatements() const { 
         return statements; 
     }
     
@@ -779,4 +882,49 @@ public:
     }
 };
 
+/* Calls fn with expr as its concrete class; fn is typically a generic lambda or an object with
+   an operator() per node class, and every overload must return the same type */
+template <typename Fn>
+decltype(auto) visit(Expr& expr, Fn&& fn) {
+    switch (expr.getKind()) {
+        case ExprKind::String:        return fn(static_cast<StringExpr&>(expr));
+        case ExprKind::Number:        return fn(static_cast<NumberExpr&>(expr));
+        case ExprKind::FormatString:  return fn(static_cast<FormatStringExpr&>(expr));
+        case ExprKind::Float:         return fn(static_cast<FloatExpr&>(expr));
+        case ExprKind::Boolean:       return fn(static_cast<BooleanExpr&>(expr));
+        case ExprKind::Variable:      return fn(static_cast<VariableExpr&>(expr));
+        case ExprKind::Binary:        return fn(static_cast<BinaryExpr&>(expr));
+        case ExprKind::Call:          return fn(static_cast<CallExpr&>(expr));
+        case ExprKind::Cast:          return fn(static_cast<CastExpr&>(expr));
+        case ExprKind::Module:        return fn(static_cast<ModuleExpr&>(expr));
+        case ExprKind::MemberAccess:  return fn(static_cast<MemberAccessExpr&>(expr));
+        case ExprKind::Unary:         return fn(static_cast<UnaryExpr&>(expr));
+        case ExprKind::EnumValue:     return fn(static_cast<EnumValueExpr&>(expr));
+        case ExprKind::StructLiteral: return fn(static_cast<StructLiteralExpr&>(expr));
+    }
+    throw std::logic_error("Unknown expression kind");
+}
+
+template <typename Fn>
+decltype(auto) visit(Stmt& stmt, Fn&& fn) {
+    switch (stmt.getKind()) {
+        case StmtKind::VariableDecl:     return fn(static_cast<VariableDecl&>(stmt));
+        case StmtKind::Assignment:       return fn(static_cast<AssignmentStmt&>(stmt));
+        case StmtKind::Block:            return fn(static_cast<BlockStmt&>(stmt));
+        case StmtKind::If:               return fn(static_cast<IfStmt&>(stmt));
+        case StmtKind::Function:         return fn(static_cast<FunctionStmt&>(stmt));
+        case StmtKind::MemberAssignment: return fn(static_cast<MemberAssignmentStmt&>(stmt));
+        case StmtKind::While:            return fn(static_cast<WhileStmt&>(stmt));
+        case StmtKind::ForLoop:          return fn(static_cast<ForLoopStmt&>(stmt));
+        case StmtKind::Entrypoint:       return fn(static_cast<EntrypointStmt&>(stmt));
+        case StmtKind::Return:           return fn(static_cast<ReturnStmt&>(stmt));
+        case StmtKind::Expr:             return fn(static_cast<ExprStmt&>(stmt));
+        case StmtKind::EnumDecl:         return fn(static_cast<EnumDecl&>(stmt));
+        case StmtKind::Break:            return fn(static_cast<BreakStmt&>(stmt));
+        case StmtKind::Continue:         return fn(static_cast<ContinueStmt&>(stmt));
+        case StmtKind::StructDecl:       return fn(static_cast<StructDecl&>(stmt));
+    }
+    throw std::logic_error("Unknown statement kind");
+}
+
 }
@@ -0,0 +1,109 @@
+#pragma once
+#include "ast/ast.h"
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace AST {
+
+/* Type binary arithmetic and comparisons on lhs and rhs are carried out in, whatever their
+   order: float64 if either is float64, else float32 if either is a float. Integers of the same
+   signedness use the wider one (storage width, then value bits). A signed and an unsigned
+   integer use the signed one when it holds every value of the other, else the narrowest of
+   int16/int32/int64 wider than the unsigned one's storage. uint64 with a signed type has no
+   such type and uses int64, as every integer did before this analysis: arithmetic wraps uint64
+   values above int64's max, and codegen keeps comparisons exact with a sign test. VOID when
+   either is not numeric */
+VarType commonOperandType(VarType lhs, VarType rhs);
+
+/* Runs between Parser::parse and codegen and records every expression's source type on the
+   node (Expr::getResolvedType), so codegen can work at each type's own width instead of
+   treating every integer as int64. An integer literal takes the type of the operand, variable,
+   parameter or return it meets when it fits, and stays int64 otherwise; integer arithmetic
+   stored into a wider integer is typed, and computed, at that width. Assignments to const
+   names and string/number mismatches are rejected here; whatever cannot be typed is left VOID
+   and codegen handles it as before. Scopes follow codegen's: one per function, method and for
+   loop, with globals visible everywhere.
+
+   Expressions made only of literals and integer or bool consts are folded exactly with BigInt
+   and replaced by a literal, so codegen emits a constant with no runtime bounds check. A const
+   keeps its declared type, so folding computes what the same expression on a variable would; a
+   folded value that does not fit its type, or the variable, field, parameter or return it is
+   stored into, is reported here. Literal-only expressions have no type of their own until they
+   are stored, so only their final value is checked */
+class SemanticAnalyzer {
+public:
+    void analyze(Program& program);
+
+private:
+    struct Typed {
+        VarType type = VarType::VOID;
+        const std::string* structName = nullptr;
+        bool literal = false; /* built only from integer literals, so it takes its type from its use */
+    };
+
+    struct Binding {
+        Typed typed;
+        bool isConst = false;
+        const Expr* constant = nullptr; /* folded initializer of an integer or bool const */
+    };
+
+    void collect(Program& program);
+    void analyzeFunction(FunctionStmt& function, const std::string* selfStruct);
+
+    void analyzeStmt(Stmt& stmt);
+    void check(VariableDecl& decl);
+    void check(AssignmentStmt& stmt);
+    void check(BlockStmt& stmt);
+    void check(IfStmt& stmt);
+    void check(FunctionStmt& stmt);
+    void check(MemberAssignmentStmt& stmt);
+    void check(WhileStmt& stmt);
+    void check(ForLoopStmt& stmt);
+    void check(EntrypointStmt&) {}
+    void check(ReturnStmt& stmt);
+    void check(ExprStmt& stmt);
+    void check(EnumDecl& decl);
+    void check(BreakStmt&) {}
+    void check(ContinueStmt&) {}
+    void check(StructDecl& decl);
+
+    /* Types the expression in slot (and its operands), records the result on it and returns
+       it, folding it to a literal when it is constant; hint is the type the value is headed
+       for, if known */
+    Typed analyzeExpr(std::unique_ptr<Expr>& slot, VarType hint = VarType::VOID);
+    Typed type(StringExpr& expr, VarType hint);
+    Typed type(NumberExpr& expr, VarType hint);
+    Typed type(FormatStringExpr& expr, VarType hint);
+    Typed type(FloatExpr& expr, VarType hint);
+    Typed type(BooleanExpr& expr, VarType hint);
+    Typed type(VariableExpr& expr, VarType hint);
+    Typed type(BinaryExpr& expr, VarType hint);
+    Typed type(CallExpr& expr, VarType hint);
+    Typed type(CastExpr& expr, VarType hint);
+    Typed type(ModuleExpr& expr, VarType hint);
+    Typed type(MemberAccessExpr& expr, VarType hint);
+    Typed type(UnaryExpr& expr, VarType hint);
+    Typed type(EnumValueExpr& expr, VarType hint);
+    Typed type(StructLiteralExpr& expr, VarType hint);
+
+    void analyzeArgs(CallExpr& expr, const FunctionStmt* callee, size_t firstParam);
+    VarType fieldType(const std::string* structName, const std::string& field) const;
+    void checkStore(const std::string& name, VarType target, VarType value) const;
+    std::unique_ptr<Expr> fold(Expr& expr, VarType type, bool exact) const;
+    void checkConstant(const Expr& value, VarType target, const std::string& name) const;
+
+    void enterScope() { scopes.emplace_back(); }
+    void exitScope() { scopes.pop_back(); }
+    void declare(const std::string& name, Typed typed, bool isConst, const Expr* constant = nullptr);
+    const Binding* lookup(std::string_view name) const;
+
+    /* Keys view names held by the AST, which outlives the analysis */
+    std::unordered_map<std::string_view, const FunctionStmt*> functions; /* methods as "Struct.method" */
+    std::unordered_map<std::string_view, const StructDecl*> structs;
+    std::vector<std::unordered_map<std::string_view, Binding>> scopes;
+    Typed returnType;
+};
+
+}
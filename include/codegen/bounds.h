@@ -8,6 +8,9 @@ namespace AST {
     class TypeBounds {
     public:
         static bool checkBounds(VarType type, const BigInt& value);
+        /* Same check without a BigInt, for constants already held as sign- or zero-extended integers */
+        static bool checkBounds(VarType type, int64_t value);
+        static bool checkBounds(VarType type, uint64_t value);
         static std::string getTypeRange(VarType type);
         static std::string getTypeName(VarType type);
 
@@ -17,6 +20,9 @@ namespace AST {
         static bool isFloatType(VarType type);
         static size_t getTypeBitWidth(VarType type);
         static bool requiresBoundsCheck(VarType fromType, VarType toType);
+        /* Every value the storage of source can hold is in target's range, so storing one
+           needs no runtime check; int4 is held in i8 and so does not fit int4 */
+        static bool storageFitsIn(VarType source, VarType target);
         static bool isUnsignedType(VarType type);
         
         static VarType stringToType(const std::string& typeName);
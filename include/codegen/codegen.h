@@ -1,4 +1,6 @@
 #pragma once
+#include <array>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -14,6 +16,10 @@
 #include <unordered_map>
 
 #include "ast/ast_types.h"
+#include "codegen/symbol_table.h"
+#include "codegen/type_descriptor.h"
+#include "utils/string_interner.h"
+#include "utils/trace.h"
 
 namespace llvm {
     class StructType;
@@ -44,6 +50,7 @@ namespace AST {
     class ReturnStmt;
     class WhileStmt;
     class ForLoopStmt;
+    class EntrypointStmt;
     class ModuleExpr;
     class MemberAccessExpr;
     class EnumDecl;
@@ -56,29 +63,66 @@ namespace AST {
     class MemberAssignmentStmt;
 }
 
+class TimeReport;
+
+/* Optimization level selected with -O0/-O1/-O2/-O3/-Os */
+enum class OptLevel {
+    O0,
+    O1,
+    O2,
+    O3,
+    Os
+};
+
+/* Target, tuning and linking settings for compileToExecutable */
+struct CompileOptions {
+    std::string targetTriple;
+    std::string cpu;        /* "" = generic, "native" = host CPU */
+    std::string features;   /* comma separated, e.g. "+avx2,-avx512f" */
+    OptLevel optLevel = OptLevel::O0;
+    bool verbose = false;
+    bool noStdlib = false;
+    bool externalLinker = false; /* --linker=external: shell out to clang++/g++ */
+    bool linkRuntimeBitcode = true; /* link libsummit.bc into the module when available */
+    TimeReport* timeReport = nullptr; /* --time-report: backend phases are recorded here */
+};
+
 class CodeGen {
     std::unique_ptr<llvm::LLVMContext> llvmContext;
     std::unique_ptr<llvm::IRBuilder<>> irBuilder;
     std::unique_ptr<llvm::Module> llvmModule;
     
-    /* Stack-based scope management for variables */
-    std::vector<std::unordered_map<std::string, llvm::Value*>> namedValuesStack;
-    std::vector<std::unordered_map<std::string, AST::VarType>> variableTypesStack;
-    std::vector<std::unordered_set<std::string>> constVariablesStack;
-    std::map<std::string, llvm::Value*> moduleReferences;
-    std::map<std::string, std::string> moduleIdentities;
-    std::map<std::string, std::string> moduleAliases;
-    
-    std::unordered_map<std::string, llvm::StructType*> structTypes;
-    std::unordered_map<std::string, std::unordered_map<std::string, int>> structFieldIndices;
-    std::map<std::string, std::string> variableStructNames;
-    std::unordered_set<std::string> globalVariables;
-    
-    std::unordered_map<std::string, std::unordered_map<std::string, std::unique_ptr<AST::Expr>>> structFieldDefaults_;
-    std::unordered_map<std::string, std::unordered_map<std::string, llvm::Constant*>> structFieldDefaults;
-    std::unordered_map<std::string, std::vector<std::pair<std::string, AST::VarType>>> structFields_;
+    /* Names are interned in the table the lexer and parser used, so ids match across phases */
+    StringInterner& symbolNames;
+
+    /* Variables by interned name, in one scope chain */
+    SymbolTable symbols;
+    std::unordered_map<StringInterner::Id, llvm::Value*> moduleReferences;
+    std::unordered_map<StringInterner::Id, StringInterner::Id> moduleIdentities;
+    std::unordered_map<StringInterner::Id, StringInterner::Id> moduleAliases;
+
+    /* Everything known about one struct; fields and methods are keyed by interned member name */
+    struct StructInfo {
+        llvm::StructType* type = nullptr;
+        std::vector<std::pair<std::string, AST::VarType>> fields;
+        std::unordered_map<StringInterner::Id, int> fieldIndices;
+        std::unordered_map<StringInterner::Id, llvm::Constant*> fieldDefaults;
+        std::unordered_map<StringInterner::Id, llvm::Function*> methods;
+        bool declared = false; /* registerStructType ran; until then only forward references exist */
+    };
+    std::unordered_map<StringInterner::Id, StructInfo> structs;
+    std::vector<StringInterner::Id> structOrder; /* registration order, for deterministic searches */
+    std::unordered_map<StringInterner::Id, StringInterner::Id> variableStructNames;
+    std::unordered_set<StringInterner::Id> globalVariables;
+
+    bool stdlibEnabled = true;
+
+    /* Canonical lowering of each non-struct VarType, filled on first use */
+    std::array<llvm::Type*, std::size(AST::TYPE_DESCRIPTORS)> typeCache{};
+
+    const StructInfo* findStruct(const std::string& name) const;
 public:
-    CodeGen();
+    explicit CodeGen(StringInterner& symbolNames);
     
     /* Get references to LLVM core objects */
     llvm::LLVMContext& getContext() { return *llvmContext; }
@@ -86,30 +130,35 @@ public:
     llvm::Module& getModule() { return *llvmModule; }
 
     void registerGlobalVariable(const std::string& name) {
-        globalVariables.insert(name);
+        globalVariables.insert(symbolNames.intern(name));
     }
     
-    void setGlobalVariables(const std::unordered_set<std::string>& globals) {
+    void setGlobalVariables(const std::unordered_set<StringInterner::Id>& globals) {
         globalVariables = globals;
-        std::cout << "DEBUG: Set " << globalVariables.size() << " global variables in codegen" << std::endl;
-        for (const auto& global : globalVariables) {
-            std::cout << "DEBUG: Global variable: " << global << std::endl;
+        SUMMIT_TRACE(Var, Info, "Set " << globalVariables.size() << " global variables in codegen");
+        for (StringInterner::Id global : globalVariables) {
+            SUMMIT_TRACE(Var, Detail, "Global variable: " << symbolNames.text(global));
         }
     }
     
     bool isGlobalVariable(const std::string& name) const {
-        return globalVariables.count(name) > 0;
-    }
-    
-    const std::unordered_map<std::string, llvm::StructType*>& getStructTypes() const {
-        return structTypes;
+        return globalVariables.count(symbolNames.find(name)) > 0;
     }
 
+    /* Per compile: a --no-stdlib compile resolves no stdlib modules or functions, even in a
+       process (the server) whose StdLibManager has them registered */
+    void setStdlibEnabled(bool enabled) { stdlibEnabled = enabled; }
+    bool isStdlibEnabled() const { return stdlibEnabled; }
+
     /* Struct type management */
     void registerStructType(const std::string& name, llvm::StructType* type, 
                            const std::vector<std::pair<std::string, AST::VarType>>& fields);
     int getStructFieldIndex(const std::string& structName, const std::string& fieldName);
     llvm::Type* getStructType(const std::string& name);
+    /* First struct, in declaration order, with a field of this name; {nullptr, -1} when none */
+    std::pair<llvm::StructType*, int> findStructWithField(const std::string& fieldName) const;
+    void registerStructMethod(const std::string& structName, const std::string& methodName, llvm::Function* function);
+    llvm::Function* getStructMethod(const std::string& structName, const std::string& methodName) const;
 
     const std::vector<std::pair<std::string, AST::VarType>>& getStructFields(const std::string& structName) const;
     
@@ -117,14 +166,14 @@ public:
     llvm::Type* getLLVMType(AST::VarType type, const std::string& structName = "");
 
     void setVariableStructName(const std::string& varName, const std::string& structName) {
-        variableStructNames[varName] = structName;
-        std::cout << "DEBUG: Set variable '" << varName << "' to struct '" << structName << "'" << std::endl;
+        variableStructNames[symbolNames.intern(varName)] = symbolNames.intern(structName);
+        SUMMIT_TRACE(Struct, Detail, "Set variable '" << varName << "' to struct '" << structName << "'");
     }
 
     std::string getVariableStructName(const std::string& varName) const {
-        auto it = variableStructNames.find(varName);
+        auto it = variableStructNames.find(symbolNames.find(varName));
         if (it != variableStructNames.end()) {
-            return it->second;
+            return std::string(symbolNames.text(it->second));
         }
         return "";
     }
@@ -133,9 +182,9 @@ public:
     /* Scope management methods */
     void enterScope();
     void exitScope();
-    std::unordered_map<std::string, llvm::Value*>& getNamedValues();
-    std::unordered_map<std::string, AST::VarType>& getVariableTypes();
-    std::unordered_set<std::string>& getConstVariables();
+    /* Declare a variable in the innermost scope, shadowing any outer one of the same name */
+    void declareVariable(const std::string& name, llvm::Value* value, AST::VarType type);
+    void markVariableConst(const std::string& name);
 
     void setCurrentTargetType(const std::string& type) { currentTargetType = type; }
     std::string getCurrentTargetType() const { return currentTargetType; }
@@ -179,6 +228,7 @@ public:
     llvm::Value* codegen(AST::ReturnStmt& stmt);
     llvm::Value* codegen(AST::WhileStmt& stmt);
     llvm::Value* codegen(AST::ForLoopStmt& stmt);
+    llvm::Value* codegen(AST::EntrypointStmt& stmt);
     llvm::Value* codegen(AST::EnumDecl& expr);
     llvm::Value* codegen(AST::BreakStmt& expr);
     llvm::Value* codegen(AST::ContinueStmt& expr);
@@ -188,21 +238,34 @@ public:
     /* Debugging and output methods */
     void printIR();
     void printIRToFile(const std::string& filename);
-    bool compileToExecutable(const std::string& outputFilename, bool verbose = false, 
-                        const std::string& targetTriple = "", bool noStdlib = false);
+    bool compileToExecutable(const std::string& outputFilename, const CompileOptions& options = {});
+    bool emitObject(llvm::SmallVectorImpl<char>& objBuffer, const CompileOptions& options = {});
+    static bool linkObject(llvm::ArrayRef<char> objBuffer, const std::string& outputFilename,
+                           const CompileOptions& options = {});
+    static void initializeTargets();
+    static std::string resolveTargetTriple(const std::string& targetTriple);
+    static std::string findStandardLibrary(const std::string& triple, std::string& dllPath);
+    static void resolveCpuAndFeatures(const CompileOptions& options, std::string& cpu, std::string& features);
+    static std::string findRuntimeBitcode(const std::string& triple);
+    bool linkRuntimeBitcode(const std::string& triple, bool verbose = false);
+    /* Defined functions and their instruction total, for --time-report */
+    static void countIR(const llvm::Module& module, uint64_t& functions, uint64_t& instructions);
+    /* JIT the module in-process and return the program's exit code; consumes the module */
+    int runJIT(const CompileOptions& options = {});
 
     /* Module alias management */
     void setModuleReference(const std::string& varName, llvm::Value* module, const std::string& actualModuleName) {
-        moduleReferences[varName] = module;
-        moduleIdentities[varName] = actualModuleName;
-        std::cout << "DEBUG: Tracked module alias: " << varName << " -> " << actualModuleName << std::endl;
+        StringInterner::Id id = symbolNames.intern(varName);
+        moduleReferences[id] = module;
+        moduleIdentities[id] = symbolNames.intern(actualModuleName);
+        SUMMIT_TRACE(Module, Detail, "Tracked module alias: " << varName << " -> " << actualModuleName);
     }
 
     void registerModuleAlias(const std::string& alias, const std::string& actualModuleName, llvm::Value* moduleValue);
     std::string resolveModuleAlias(const std::string& name) const;
     
     llvm::Value* getModuleReference(const std::string& varName) const {
-        auto it = moduleReferences.find(varName);
+        auto it = moduleReferences.find(symbolNames.find(varName));
         if (it != moduleReferences.end()) {
             return it->second;
         }
@@ -210,9 +273,9 @@ public:
     }
     
     std::string getModuleIdentity(const std::string& varName) const {
-        auto it = moduleIdentities.find(varName);
+        auto it = moduleIdentities.find(symbolNames.find(varName));
         if (it != moduleIdentities.end()) {
-            return it->second;
+            return std::string(symbolNames.text(it->second));
         }
         return "";
     }
@@ -245,20 +308,18 @@ public:
     }
 
     void registerStructFieldDefault(const std::string& structName, const std::string& fieldName, llvm::Constant* defaultValue) {
-        structFieldDefaults[structName][fieldName] = defaultValue;
+        structs[symbolNames.intern(structName)].fieldDefaults[symbolNames.intern(fieldName)] = defaultValue;
     }
     
     bool hasStructFieldDefault(const std::string& structName, const std::string& fieldName) const {
-        auto structIt = structFieldDefaults.find(structName);
-        if (structIt == structFieldDefaults.end()) return false;
-        return structIt->second.find(fieldName) != structIt->second.end();
+        return getStructFieldDefault(structName, fieldName) != nullptr;
     }
     
     llvm::Constant* getStructFieldDefault(const std::string& structName, const std::string& fieldName) const {
-        auto structIt = structFieldDefaults.find(structName);
-        if (structIt == structFieldDefaults.end()) return nullptr;
-        auto fieldIt = structIt->second.find(fieldName);
-        if (fieldIt == structIt->second.end()) return nullptr;
+        const StructInfo* info = findStruct(structName);
+        if (!info) return nullptr;
+        auto fieldIt = info->fieldDefaults.find(symbolNames.find(fieldName));
+        if (fieldIt == info->fieldDefaults.end()) return nullptr;
         return fieldIt->second;
     }
 private:
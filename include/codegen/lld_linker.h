@@ -0,0 +1,16 @@
+#pragma once
+#include <string>
+#include <llvm/ADT/ArrayRef.h>
+
+namespace LldLinker {
+    enum class LinkStatus {
+        Linked,       /* executable written */
+        Failed,       /* lld ran and reported errors */
+        Unavailable   /* not built with lld, or host crt files not found */
+    };
+
+    /* Link an ELF executable in-process from an object held in memory */
+    LinkStatus linkExecutable(llvm::ArrayRef<char> object, const std::string& outputFilename,
+                              const std::string& triple, const std::string& stdlibPath,
+                              bool verbose, std::string& error);
+}
@@ -23,5 +23,8 @@ namespace StatementCodeGen {
     llvm::Value* codegenMemberAssignment(CodeGen& context, AST::MemberAssignmentStmt& stmt);
     void codegenStructMethodBodies(CodeGen& context, AST::StructDecl& decl);
 
-    llvm::Value* addRuntimeBoundsChecking(CodeGen& context, llvm::Value* value, AST::VarType targetType, const std::string& varName);
+    /* sourceType, when SemanticAnalyzer knows it, decides how a narrower value is widened
+       for the comparison; otherwise the target's signedness does */
+    llvm::Value* addRuntimeBoundsChecking(CodeGen& context, llvm::Value* value, AST::VarType targetType,
+                                          const std::string& varName, AST::VarType sourceType = AST::VarType::VOID);
 }
\ No newline at end of file
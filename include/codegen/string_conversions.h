@@ -4,5 +4,6 @@
 namespace AST {
     llvm::Value* convertToBinaryString(CodeGen& context, llvm::Value* value);
     llvm::Value* convertToDecimalString(CodeGen& context, llvm::Value* value);
-    llvm::Value* convertToString(CodeGen& context, llvm::Value* value);
+    /* sourceType picks signed or unsigned formatting for integers; VOID infers it from value */
+    llvm::Value* convertToString(CodeGen& context, llvm::Value* value, VarType sourceType = VarType::VOID);
 }
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+#include "ast/ast_types.h"
+#include "utils/string_interner.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace llvm {
+    class Value;
+}
+
+/* Variables visible to codegen, as one scope chain: every declaration is pushed onto a single
+   entry stack and linked to the declaration it shadows, and a per-name head gives the visible
+   one. Entering a scope records the stack height and leaving it pops back to that mark, so
+   both are O(1) apart from the names declared in between, and outer names (globals included)
+   stay visible without being copied into each scope */
+class SymbolTable {
+public:
+    using Id = StringInterner::Id;
+
+    struct Symbol {
+        llvm::Value* value = nullptr;
+        AST::VarType type = AST::VarType::VOID;
+        bool isConst = false;
+    };
+
+    void enterScope();
+    void exitScope();
+    size_t depth() const { return scopeMarks.size(); }
+
+    /* Entry for id in the innermost scope, created (shadowing any outer one) if it is not
+       declared there yet; the reference is invalidated by the next declaration */
+    Symbol& declare(Id id);
+
+    /* Innermost visible entry for id, or nullptr */
+    Symbol* lookup(Id id);
+    const Symbol* lookup(Id id) const;
+
+private:
+    struct Entry {
+        Symbol symbol;
+        Id id;
+        uint32_t depth;
+        uint32_t shadowed; /* 1-based index of the entry this one hides; 0 when none */
+    };
+
+    std::vector<Entry> entries;
+    std::vector<size_t> scopeMarks;
+    std::unordered_map<Id, uint32_t> heads; /* 1-based index of the visible entry per name */
+};
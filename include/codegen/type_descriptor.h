@@ -0,0 +1,106 @@
+#pragma once
+#include "ast/ast_types.h"
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+
+namespace llvm {
+    class Type;
+    class LLVMContext;
+}
+
+namespace AST {
+
+/* Static facts about one VarType; TYPE_DESCRIPTORS has a row per enumerator, in enum order */
+struct TypeDescriptor {
+    VarType type;
+    std::string_view name;   /* as spelled in diagnostics */
+    uint8_t bitWidth;        /* value bits (bool and uint0 count as 1); 0 when not numeric */
+    uint8_t storageBits;     /* width of the LLVM type values are stored in; 0 when not numeric */
+    bool isInteger;          /* the intN/uintN family, uint0 included, bool excluded */
+    bool isUnsigned;
+    bool isFloat;
+    bool hasRange;           /* minValue/maxValue apply: integers and bool */
+    int64_t minValue;
+    uint64_t maxValue;
+    llvm::Type* (*llvmType)(llvm::LLVMContext&); /* nullptr when the type needs more than a context */
+};
+
+namespace TypeFactories {
+    llvm::Type* int1(llvm::LLVMContext& context);
+    llvm::Type* int8(llvm::LLVMContext& context);
+    llvm::Type* int16(llvm::LLVMContext& context);
+    llvm::Type* int32(llvm::LLVMContext& context);
+    llvm::Type* int64(llvm::LLVMContext& context);
+    llvm::Type* float32(llvm::LLVMContext& context);
+    llvm::Type* float64(llvm::LLVMContext& context);
+    llvm::Type* string(llvm::LLVMContext& context);
+    llvm::Type* voidType(llvm::LLVMContext& context);
+    llvm::Type* module(llvm::LLVMContext& context);
+}
+
+namespace TypeRows {
+    constexpr TypeDescriptor signedInt(VarType type, std::string_view name, uint8_t bits, uint8_t storage,
+                                       llvm::Type* (*llvmType)(llvm::LLVMContext&)) {
+        return {type, name, bits, storage, true, false, false, true,
+                bits == 64 ? INT64_MIN : -(int64_t(1) << (bits - 1)),
+                bits == 64 ? uint64_t(INT64_MAX) : (uint64_t(1) << (bits - 1)) - 1, llvmType};
+    }
+
+    constexpr TypeDescriptor unsignedInt(VarType type, std::string_view name, uint8_t bits, uint8_t storage,
+                                         llvm::Type* (*llvmType)(llvm::LLVMContext&)) {
+        return {type, name, bits, storage, true, true, false, true,
+                0, bits == 64 ? UINT64_MAX : (uint64_t(1) << bits) - 1, llvmType};
+    }
+
+    constexpr TypeDescriptor other(VarType type, std::string_view name, uint8_t bits, uint8_t storage, bool isFloat,
+                                   llvm::Type* (*llvmType)(llvm::LLVMContext&)) {
+        return {type, name, bits, storage, false, false, isFloat, false, 0, 0, llvmType};
+    }
+}
+
+inline constexpr TypeDescriptor TYPE_DESCRIPTORS[] = {
+    {VarType::BOOL, "bool", 1, 1, false, false, false, true, 0, 1, TypeFactories::int1},
+    TypeRows::signedInt(VarType::INT4, "int4", 4, 8, TypeFactories::int8),
+    TypeRows::signedInt(VarType::INT8, "int8", 8, 8, TypeFactories::int8),
+    TypeRows::signedInt(VarType::INT12, "int12", 12, 16, TypeFactories::int16),
+    TypeRows::signedInt(VarType::INT16, "int16", 16, 16, TypeFactories::int16),
+    TypeRows::signedInt(VarType::INT24, "int24", 24, 32, TypeFactories::int32),
+    TypeRows::signedInt(VarType::INT32, "int32", 32, 32, TypeFactories::int32),
+    TypeRows::signedInt(VarType::INT48, "int48", 48, 64, TypeFactories::int64),
+    TypeRows::signedInt(VarType::INT64, "int64", 64, 64, TypeFactories::int64),
+    TypeRows::unsignedInt(VarType::UINT4, "uint4", 4, 8, TypeFactories::int8),
+    TypeRows::unsignedInt(VarType::UINT8, "uint8", 8, 8, TypeFactories::int8),
+    TypeRows::unsignedInt(VarType::UINT12, "uint12", 12, 16, TypeFactories::int16),
+    TypeRows::unsignedInt(VarType::UINT16, "uint16", 16, 16, TypeFactories::int16),
+    TypeRows::unsignedInt(VarType::UINT24, "uint24", 24, 32, TypeFactories::int32),
+    TypeRows::unsignedInt(VarType::UINT32, "uint32", 32, 32, TypeFactories::int32),
+    TypeRows::unsignedInt(VarType::UINT48, "uint48", 48, 64, TypeFactories::int64),
+    TypeRows::unsignedInt(VarType::UINT64, "uint64", 64, 64, TypeFactories::int64),
+    {VarType::UINT0, "uint0", 1, 1, true, true, false, true, 0, 0, TypeFactories::int1},
+    TypeRows::other(VarType::FLOAT32, "float32", 32, 32, true, TypeFactories::float32),
+    TypeRows::other(VarType::FLOAT64, "float64", 64, 64, true, TypeFactories::float64),
+    TypeRows::other(VarType::STRING, "str", 0, 0, false, TypeFactories::string),
+    TypeRows::other(VarType::MODULE, "module", 0, 0, false, TypeFactories::module),
+    TypeRows::other(VarType::ENUM, "unknown", 0, 0, false, nullptr),
+    TypeRows::other(VarType::STRUCT, "unknown", 0, 0, false, nullptr),
+    TypeRows::other(VarType::VOID, "void", 0, 0, false, TypeFactories::voidType),
+};
+
+constexpr const TypeDescriptor& typeDescriptor(VarType type) {
+    return TYPE_DESCRIPTORS[static_cast<size_t>(type)];
+}
+
+namespace TypeRows {
+    constexpr bool inEnumOrder() {
+        for (size_t i = 0; i < std::size(TYPE_DESCRIPTORS); ++i) {
+            if (static_cast<size_t>(TYPE_DESCRIPTORS[i].type) != i) return false;
+        }
+        return std::size(TYPE_DESCRIPTORS) == static_cast<size_t>(VarType::VOID) + 1;
+    }
+}
+
+static_assert(TypeRows::inEnumOrder(), "TYPE_DESCRIPTORS must have one row per VarType, in enum order");
+
+}
@@ -6,4 +6,13 @@ namespace AST {
     VarType inferSourceType(llvm::Value* value, CodeGen& context);
     bool isConvertibleToString(llvm::Value* value);
     VarType inferTypeFromValue(llvm::Value* value, CodeGen& context);
-}
\ No newline at end of file
+
+    /* expr's type from SemanticAnalyzer when value is held in that type's LLVM form; VOID when
+       the analyzer left it untyped or the two disagree */
+    VarType resolvedSourceType(const Expr& expr, llvm::Value* value);
+    /* resolvedSourceType, falling back to inferSourceType */
+    VarType sourceTypeOf(const Expr& expr, llvm::Value* value, CodeGen& context);
+
+    /* Extends an integer to the wider type, zero-extending unsigned and bool sources */
+    llvm::Value* widenInteger(CodeGen& context, llvm::Value* value, llvm::Type* type, VarType sourceType);
+}
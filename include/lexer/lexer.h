@@ -1,29 +1,43 @@
 #pragma once
 #include "token.h"
-#include <vector>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 
 class Lexer {
 private:
-    std::string input;
+    std::string_view input; /* not owned; must outlive the lexer */
     size_t position;
-    size_t line;
-    size_t column;
-    
-    static std::unordered_map<std::string, TokenType> keywords;
+    TokenList out;
+    TokenList* sink; /* list tokens are appended to: out, or the caller's when streaming */
+    bool finished = false;
     
     char peek();
+    char peekNext();
     char advance();
     void skipWhitespace();
     void skipComment();
-    Token readNumber();
-    Token readString();
-    Token readBacktickString();
-    Token readIdentifier();
-    Token readBuiltin();
+    void emit(TokenType type, size_t start, uint32_t id = 0);
+    uint32_t addLiteral(std::string text);
+    void readNumber();
+    void finishNumber(TokenType type, size_t start);
+    void readString();
+    void readFormatString();
+    void readIdentifier();
+    void readBuiltin();
+    void scanToken();
 
 public:
-    Lexer(const std::string& input);
-    std::vector<Token> tokenize();
+    /* Identifiers are interned into symbols, which must outlive the returned TokenList */
+    Lexer(std::string_view input, StringInterner& symbols);
+
+    /* Keyword or type-name token for ident, else IDENTIFIER; constexpr perfect hash, no allocation */
+    static TokenType lookupKeyword(std::string_view ident);
+
+    /* Lex the whole input */
+    TokenList tokenize();
+
+    /* Streaming: beginStream() hands over an empty TokenList carrying the line table, then each
+       lexInto() appends up to maxTokens more to it (END_OF_FILE last) and returns how many */
+    TokenList beginStream();
+    size_t lexInto(TokenList& list, size_t maxTokens);
 };
\ No newline at end of file
@@ -1,8 +1,11 @@
 #pragma once
+#include "utils/string_interner.h"
+#include <cstdint>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+#include <vector>
 
-enum class TokenType {
+enum class TokenType : uint8_t {
     // Keywords
     VAR, CONST, AS, BOOL, TRUE, FALSE,
     THEN, ELSE, ELSEIF, END, IF, AND, OR, NOT,
@@ -41,16 +44,78 @@ enum class TokenType {
     // Punctuation
     COLON, SEMICOLON, LPAREN, RPAREN, COMMA, BACKTICK_STRING, LBRACE, RBRACE,
     
+    // Closes a {placeholder} inside a backtick string
+    FORMAT_END,
+    
     // Special tokens
     END_OF_FILE, UNKNOWN
 };
 
+/* 16 bytes and no heap: the lexeme is source[offset, offset + length). For IDENTIFIER and
+   BUILTIN, id is the interned symbol; for literals whose text differs from the lexeme
+   (escapes, digit separators) it is a 1-based index into the TokenList literal pool; for
+   BACKTICK_STRING it is always a 1-based index into the format pool */
 struct Token {
     TokenType type;
-    std::string value;
+    uint32_t offset;
+    uint32_t length;
+    uint32_t id;
+};
+
+static_assert(sizeof(Token) == 16, "Token should stay two words");
+
+struct SourceLocation {
     size_t line;
     size_t column;
-    
-    Token(TokenType t, const std::string& v, size_t l, size_t c);
-    std::string toString() const;
-};
\ No newline at end of file
+};
+
+/* Lexer output: the tokens plus what is needed to recover their text and, lazily, their
+   line/column. Refers to (does not own) the source text and the symbol table. When fed by
+   Lexer::lexInto it holds a sliding window; indices stay absolute */
+class TokenList {
+    friend class Lexer;
+
+public:
+    /* A backtick string split at its {placeholders}: literals holds the text around them, one
+       more entry than there are placeholders */
+    struct FormatString {
+        std::string text; /* escapes applied, placeholders kept as written */
+        std::vector<std::string> literals;
+    };
+
+private:
+    std::vector<Token> tokens;
+    size_t firstIndex = 0; /* index of tokens[0]; non-zero once a stream discards consumed tokens */
+    std::vector<uint32_t> lineStarts; /* offset of the first character of each line */
+    std::vector<std::string> literals;
+    std::vector<FormatString> formats;
+    std::string_view src;
+    StringInterner* symbolTable;
+
+public:
+    TokenList(std::string_view source, StringInterner& symbols);
+
+    /* One past the last index lexed so far */
+    size_t size() const { return firstIndex + tokens.size(); }
+    const Token& operator[](size_t i) const { return tokens[i - firstIndex]; }
+    std::vector<Token>::const_iterator begin() const { return tokens.begin(); }
+    std::vector<Token>::const_iterator end() const { return tokens.end(); }
+
+    /* Drop tokens before index (they can no longer be accessed) */
+    void discardBefore(size_t index);
+
+    std::string_view source() const { return src; }
+    StringInterner& symbols() const { return *symbolTable; }
+
+    /* Identifier/builtin spelling, literal value (quotes stripped, escapes applied), else the lexeme */
+    std::string_view text(const Token& tok) const;
+    SourceLocation location(const Token& tok) const;
+
+    /* Segments of a BACKTICK_STRING token */
+    const FormatString& format(const Token& tok) const { return formats[tok.id - 1]; }
+
+    /* Text of a 1-based line without its terminator; empty when out of range */
+    std::string_view lineText(size_t line) const;
+
+    std::string describe(const Token& tok) const;
+};
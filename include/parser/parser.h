@@ -2,46 +2,52 @@
 #include "lexer/lexer.h"
 #include "ast/ast.h"
 #include "utils/error_utils.h"
+#include "utils/trace.h"
+#include <algorithm>
 #include <vector>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_set>
 
 class Parser {
 private:
-    std::vector<Token> tokens;
+    TokenList tokens;
     size_t current;
-    std::string source;
-    std::unordered_set<std::string> structTypes;
-    std::unordered_set<std::string> enumTypes;
-    std::unordered_set<std::string> globalVariables;
+    Lexer* stream = nullptr; /* set when tokens are pulled on demand (see Parser(Lexer&)) */
+    /* Declared names keyed by interned symbol id (see TokenList::symbols) */
+    std::unordered_set<StringInterner::Id> structTypes;
+    std::unordered_set<StringInterner::Id> enumTypes;
+    std::unordered_set<StringInterner::Id> globalVariables;
     bool inGlobalScope = true;
     std::vector<std::string> currentScope;
 
-    void registerStructType(const std::string& name) {
+    void registerStructType(StringInterner::Id name) {
         structTypes.insert(name);
     }
     
-    bool isStructType(const std::string& name) const {
+    bool isStructType(StringInterner::Id name) const {
         return structTypes.find(name) != structTypes.end();
     }
 
-    void registerEnumType(const std::string& name) {
+    void registerEnumType(StringInterner::Id name) {
         enumTypes.insert(name);
     }
     
-    bool isEnumType(const std::string& name) const {
+    bool isEnumType(StringInterner::Id name) const {
         return enumTypes.find(name) != enumTypes.end();
     }
 
-    void registerGlobalVariable(const std::string& name) {
+    void registerGlobalVariable(StringInterner::Id name) {
         globalVariables.insert(name);
     }
     
-    bool isGlobalVariable(const std::string& name) const {
+    bool isGlobalVariable(StringInterner::Id name) const {
         return globalVariables.count(name) > 0;
     }
 
+    std::unordered_set<std::string> spell(const std::unordered_set<StringInterner::Id>& ids) const;
+
     void enterScope() {
         inGlobalScope = false;
         currentScope.push_back("local");
@@ -58,12 +64,21 @@ private:
         return inGlobalScope;
     }
 
-    const Token& peek();
-    const Token& advance();
+    /* Tokens are returned by value: a streaming refill may move the window */
+    Token tokenAt(size_t index) {
+        if (index >= tokens.size()) pull(index);
+        return tokens[std::min(index, tokens.size() - 1)];
+    }
+    void pull(size_t index);
+
+    Token peek() { return tokenAt(current); }
+    Token previous() { return tokenAt(current - 1); }
+    Token advance();
     bool match(TokenType type);
     bool check(TokenType type);
     bool checkNext(TokenType type);
     bool isAtEnd();
+    std::string_view text(const Token& tok) const { return tokens.text(tok); }
 
     std::unique_ptr<AST::Expr> parseExpression();
     std::unique_ptr<AST::Expr> parsePrimary();
@@ -88,10 +103,6 @@ private:
     std::unique_ptr<AST::Expr> parseStructLiteral();
     std::unique_ptr<AST::Expr> parseMemberAccess(std::unique_ptr<AST::Expr> object);
 
-    std::unique_ptr<AST::Expr> parseExpressionFromString(const std::string& exprStr);
-    std::vector<std::unique_ptr<AST::Expr>> extractExpressionsFromFormat(const std::string& formatStr);
-    std::string buildFormatSpecifiers(const std::string& formatStr);
-
     std::unique_ptr<AST::Stmt> parseStatement();
     std::unique_ptr<AST::Stmt> parseVariableDeclaration();
     std::unique_ptr<AST::Stmt> parseAssignment();
@@ -103,18 +114,26 @@ private:
     void errorAt(const Token& tok, const std::string& msg);
 
 public:
-    Parser(std::vector<Token> tokens, const std::string& source);
+    Parser(TokenList tokens);
+
+    /* Streaming: pull tokens from lexer (which must outlive the parser) through a small window,
+       so memory does not grow with the input and lexing interleaves with parsing */
+    explicit Parser(Lexer& lexer);
+    
+    /* Tokens consumed so far; all of them once parse() returns */
+    size_t tokenCount() const { return tokens.size(); }
     std::unique_ptr<AST::Program> parse();
     
-    const std::unordered_set<std::string>& getGlobalVariables() const {
+    /* Ids in the interner the parser was given, which CodeGen shares */
+    const std::unordered_set<StringInterner::Id>& getGlobalVariables() const {
         return globalVariables;
     }
     
-    const std::unordered_set<std::string>& getStructTypes() const {
-        return structTypes;
+    std::unordered_set<std::string> getStructTypes() const {
+        return spell(structTypes);
     }
     
-    const std::unordered_set<std::string>& getEnumTypes() const {
-        return enumTypes;
+    std::unordered_set<std::string> getEnumTypes() const {
+        return spell(enumTypes);
     }
 };
\ No newline at end of file
@@ -7,83 +7,102 @@
 #include <cstdint>  // Add this for uint64_t
 #include <limits>   // Add this for std::numeric_limits
 
+/* Arbitrary precision integer. Values that fit in int64_t are kept inline and only larger
+   magnitudes allocate an mp_int; the form is canonical (big means outside int64_t), so the
+   common cases never touch libtommath */
 class BigInt {
-    mp_int value;
-    
-public:
-    BigInt() {
-        mp_init(&value);
-    }
-    
-    BigInt(int64_t val) {
-        mp_init(&value);
-        mp_set_i64(&value, val);
-    }
-    
-    BigInt(const std::string& str) {
-        mp_init(&value);
-        if (mp_read_radix(&value, str.c_str(), 10) != MP_OKAY) {
-            throw std::runtime_error("Invalid integer: " + str);
+    union {
+        int64_t small;
+        mp_int big;
+    };
+    bool isBig = false;
+
+    /* Switch a freshly computed mp_int result to the inline form when it fits */
+    void normalize();
+    static int compare(const BigInt& a, const BigInt& b) {
+        if (!a.isBig && !b.isBig) return (a.small > b.small) - (a.small < b.small);
+        if (!a.isBig) return mp_isneg(&b.big) ? 1 : -1;
+        if (!b.isBig) return mp_isneg(&a.big) ? -1 : 1;
+        int cmp = mp_cmp(const_cast<mp_int*>(&a.big), const_cast<mp_int*>(&b.big));
+        return cmp == MP_LT ? -1 : cmp == MP_GT ? 1 : 0;
+    }
+    void release() {
+        if (isBig) mp_clear(&big);
+        isBig = false;
+    }
+    void copyFrom(const BigInt& other) {
+        if (other.isBig) {
+            mp_init_copy(&big, const_cast<mp_int*>(&other.big));
+        } else {
+            small = other.small;
+        }
+        isBig = other.isBig;
+    }
+    /* Copies the value into an initialized mp_int */
+    void loadInto(mp_int& out) const;
+    /* Takes over value (the caller must not clear it) and normalizes */
+    static BigInt adopt(mp_int& value);
+    /* a op b through libtommath, for the operands or results that leave int64_t */
+    template <typename Op>
+    static BigInt viaMp(const BigInt& a, const BigInt& b, Op op);
+    void moveFrom(BigInt& other) noexcept {
+        if (other.isBig) {
+            big = other.big; /* takes over the digit buffer */
+            other.small = 0;
+            other.isBig = false;
+            isBig = true;
+        } else {
+            small = other.small;
         }
     }
-    
+
+public:
+    BigInt() : small(0) {}
+
+    BigInt(int64_t val) : small(val) {}
+
+    BigInt(const std::string& str);
+
     BigInt(const BigInt& other) {
-        mp_init_copy(&value, const_cast<mp_int*>(&other.value));
+        copyFrom(other);
     }
-    
+
+    BigInt(BigInt&& other) noexcept {
+        moveFrom(other);
+    }
+
     BigInt& operator=(const BigInt& other) {
         if (this != &other) {
-            mp_clear(&value);
-            mp_init_copy(&value, const_cast<mp_int*>(&other.value));
+            release();
+            copyFrom(other);
         }
         return *this;
     }
-    
+
+    BigInt& operator=(BigInt&& other) noexcept {
+        if (this != &other) {
+            release();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
     ~BigInt() {
-        mp_clear(&value);
+        release();
     }
-    
+
     bool fitsInInt64() const {
-        int bits = mp_count_bits(&value);
-
-        if (bits > 63) {
-            if (mp_isneg(&value) && bits == 64) {
-                BigInt int64_min("-9223372036854775808");
-                return *this == int64_min;
-            }
-            return false;
-        }
-        
-        return true;
+        return !isBig;
     }
-    
+
     int64_t toInt64() const {
-        if (!fitsInInt64()) {
-            std::cerr << "DEBUG: Value doesn't fit in int64, throwing error" << std::endl;
-            throw std::runtime_error("Integer out of range for int64: " + toString() + 
+        if (isBig) {
+            throw std::runtime_error("Integer out of range for int64: " + toString() +
                                     ". Valid range: -9223372036854775808 to 9223372036854775807");
         }
-        
-        uint64_t magnitude = 0;
-        
-        #if defined(MP_GET_U64)
-            mp_get_u64(&value, &magnitude);
-        #else
-            for (int i = 0; i < value.used; i++) {
-                magnitude |= ((uint64_t)value.dp[i]) << (i * MP_DIGIT_BIT);
-            }
-        #endif
-        
-        if (mp_isneg(&value)) {
-            if (magnitude == 9223372036854775808ULL) {
-                return INT64_MIN;
-            }
-            return -static_cast<int64_t>(magnitude);
-        }
-        
-        return static_cast<int64_t>(magnitude);
+        return small;
     }
-    
+
     bool fitsInType(int type) const {
         switch (type) {
             case 0:
@@ -98,47 +117,35 @@ public:
                 return false;
         }
     }
-    
-    std::string toString() const {
-        int size;
-        mp_radix_size(&value, 10, &size);
-        std::string result(size, '\0');
-        mp_toradix(&value, &result[0], 10);
-        
-        if (!result.empty() && result.back() == '\0') {
-            result.pop_back();
-        }
-        return result;
-    }
-    
-    bool operator<(const BigInt& other) const {
-        return mp_cmp(&value, const_cast<mp_int*>(&other.value)) == MP_LT;
-    }
-    
-    bool operator<=(const BigInt& other) const {
-        int cmp = mp_cmp(&value, const_cast<mp_int*>(&other.value));
-        return cmp == MP_LT || cmp == MP_EQ;
-    }
-    
-    bool operator>(const BigInt& other) const {
-        return mp_cmp(&value, const_cast<mp_int*>(&other.value)) == MP_GT;
-    }
-    
-    bool operator>=(const BigInt& other) const {
-        int cmp = mp_cmp(&value, const_cast<mp_int*>(&other.value));
-        return cmp == MP_GT || cmp == MP_EQ;
-    }
-    
-    bool operator==(const BigInt& other) const {
-        return mp_cmp(&value, const_cast<mp_int*>(&other.value)) == MP_EQ;
-    }
-    
-    bool operator!=(const BigInt& other) const {
-        return mp_cmp(&value, const_cast<mp_int*>(&other.value)) != MP_EQ;
-    }
+
+    std::string toString() const;
+
+    bool operator<(const BigInt& other) const { return compare(*this, other) < 0; }
+    bool operator<=(const BigInt& other) const { return compare(*this, other) <= 0; }
+    bool operator>(const BigInt& other) const { return compare(*this, other) > 0; }
+    bool operator>=(const BigInt& other) const { return compare(*this, other) >= 0; }
+    bool operator==(const BigInt& other) const { return compare(*this, other) == 0; }
+    bool operator!=(const BigInt& other) const { return compare(*this, other) != 0; }
+
+    /* Exact arithmetic. Division truncates toward zero and the remainder takes the dividend's
+       sign, as sdiv/srem do; both throw on a zero divisor. Bitwise operators and shifts treat
+       values as two's complement with infinite sign extension, so >> rounds toward negative
+       infinity. Shift amounts are bit counts and should be bounded by the caller */
+    BigInt operator-() const;
+    BigInt operator~() const;
+    BigInt operator+(const BigInt& other) const;
+    BigInt operator-(const BigInt& other) const;
+    BigInt operator*(const BigInt& other) const;
+    BigInt operator/(const BigInt& other) const;
+    BigInt operator%(const BigInt& other) const;
+    BigInt operator&(const BigInt& other) const;
+    BigInt operator|(const BigInt& other) const;
+    BigInt operator^(const BigInt& other) const;
+    BigInt operator<<(unsigned shift) const;
+    BigInt operator>>(unsigned shift) const;
 
     // REMOVED the problematic toUint64() method
-    
+
     static const BigInt MIN_INT4;
     static const BigInt MAX_INT4;
     static const BigInt MIN_INT8;
@@ -169,11 +176,4 @@ public:
     static const BigInt MAX_UINT24;
     static const BigInt MIN_UINT48;
     static const BigInt MAX_UINT48;
-    
-private:
-    static BigInt createFromInt64(int64_t val) {
-        BigInt result;
-        mp_set_i64(&result.value, val);
-        return result;
-    }
-};
\ No newline at end of file
+};
@@ -0,0 +1,29 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <functional>
+
+/* 'summit --server': a long-lived process that keeps LLVM targets, cached
+   TargetMachines and the stdlib registry warm, and compiles requests sent by
+   'summit --connect' over a Unix domain socket */
+namespace CompileServer {
+    /* Compiles one request whose input files were written to workDir; artifacts go to workDir.
+       std::cout/std::cerr output of the calling thread is captured and sent to the client */
+    using Handler = std::function<int(const std::vector<std::string>& args, const std::string& workDir)>;
+
+    /* $SUMMIT_SERVER_SOCKET, else summit-<uid>.sock in the temp directory */
+    std::string defaultSocketPath();
+
+    /* Accept connections until killed, one thread per request; returns the exit code on failure */
+    int serve(const std::string& socketPath, const Handler& handler);
+
+    /* Wrap work for another thread so its output joins the current request's (e.g. 'build -jN') */
+    std::function<void()> inheritOutput(std::function<void()> work);
+
+    /* Send args and the named input files to a server, replay its output and write the returned
+       artifacts (placeArtifact maps an artifact name to a local path). Returns the remote exit
+       code, or -1 if no server is listening */
+    int forward(const std::string& socketPath, const std::vector<std::string>& args,
+                const std::vector<std::string>& inputFiles,
+                const std::function<std::string(const std::string&)>& placeArtifact);
+}
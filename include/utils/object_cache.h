@@ -0,0 +1,37 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/SmallVector.h>
+
+/* Content-addressed cache of emitted object files, size bounded with LRU eviction */
+class ObjectCache {
+    std::string directory;
+    uint64_t maxBytes;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+
+    void loadStats();
+    void recordStats(bool hit);
+    void evict();
+    std::string objectPath(const std::string& key) const;
+
+public:
+    ObjectCache(const std::string& directory, uint64_t maxBytes);
+
+    /* $SUMMIT_CACHE_DIR, else $XDG_CACHE_HOME/summit, else ~/.cache/summit */
+    static std::string defaultDirectory();
+
+    /* Hash every input that affects the emitted object into a hex key */
+    static std::string computeKey(const std::vector<std::string_view>& parts);
+
+    bool lookup(const std::string& key, llvm::SmallVectorImpl<char>& object);
+    void store(const std::string& key, llvm::ArrayRef<char> object);
+
+    /* Totals across all runs sharing this cache directory */
+    uint64_t getHits() const { return hits; }
+    uint64_t getMisses() const { return misses; }
+    const std::string& getDirectory() const { return directory; }
+};
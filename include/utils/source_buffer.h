@@ -0,0 +1,20 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <string_view>
+#include <llvm/Support/MemoryBuffer.h>
+
+/* A source file loaded once (memory-mapped when large) and shared by the lexer, parser
+   and diagnostics as a string_view; the text is always followed by a NUL */
+class SourceBuffer {
+    std::unique_ptr<llvm::MemoryBuffer> buffer;
+
+    explicit SourceBuffer(std::unique_ptr<llvm::MemoryBuffer> buffer) : buffer(std::move(buffer)) {}
+
+public:
+    /* Throws std::runtime_error if the file can't be read */
+    static SourceBuffer fromFile(const std::string& filename);
+
+    std::string_view text() const { return {buffer->getBufferStart(), buffer->getBufferSize()}; }
+    size_t size() const { return buffer->getBufferSize(); }
+};
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/* Gives every distinct spelling a dense integer id so names can be compared and hashed as
+   integers. Ids start at 1 (NONE is never assigned); spellings live as long as the interner */
+class StringInterner {
+public:
+    using Id = uint32_t;
+    static constexpr Id NONE = 0;
+
+    StringInterner();
+    StringInterner(const StringInterner&) = delete;
+    StringInterner& operator=(const StringInterner&) = delete;
+
+    Id intern(std::string_view text);
+
+    /* Id of an already interned spelling, else NONE; never inserts */
+    Id find(std::string_view text) const;
+
+    std::string_view text(Id id) const { return spellings[id]; }
+    size_t size() const { return spellings.size() - 1; }
+
+private:
+    std::deque<std::string> storage; /* deque: elements never move, so views stay valid */
+    std::vector<std::string_view> spellings; /* indexed by id; [NONE] is empty */
+    std::unordered_map<std::string_view, Id> ids;
+};
@@ -0,0 +1,50 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+
+/* Per-phase wall/CPU time, peak RSS and size counters for --time-report */
+class TimeReport {
+public:
+    struct Phase {
+        std::string name;
+        double wallMs;
+        double cpuMs;
+        uint64_t peakRssKB;
+    };
+
+    /* Times a phase from construction until stop() or destruction; a null report makes it a no-op */
+    class Scope {
+        TimeReport* report;
+        std::string name;
+        std::chrono::steady_clock::time_point wallStart;
+        double cpuStartMs = 0;
+
+    public:
+        Scope(TimeReport* report, const std::string& name);
+        ~Scope() { stop(); }
+        void stop();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    explicit TimeReport(const std::string& file = "") : file(file) {}
+
+    void addPhase(const Phase& phase) { phases.push_back(phase); }
+    void setCounter(const std::string& name, uint64_t value);
+
+    std::string toText() const;
+    std::string toJSON() const;
+
+    /* CPU time of the calling thread, so parallel builds report per-file cost */
+    static double threadCpuMs();
+    static uint64_t peakRssKB();
+
+private:
+    std::string file;
+    std::vector<Phase> phases;
+    std::vector<std::pair<std::string, uint64_t>> counters;
+};
@@ -0,0 +1,82 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <llvm/Support/raw_ostream.h>
+
+/* Compiler-internal tracing, off unless enabled with --trace=<categories>[:<level>].
+   Build with SUMMIT_DISABLE_TRACE to compile every trace point out entirely */
+namespace Trace {
+    enum class Category : uint32_t {
+        Scope  = 1u << 0,  /* scope push/pop and carried globals */
+        Call   = 1u << 1,  /* call lowering and argument conversion */
+        Struct = 1u << 2,  /* struct types, literals, members and methods */
+        Module = 1u << 3,  /* stdlib modules and module aliases */
+        Var    = 1u << 4,  /* variable declarations and lookups */
+        Func   = 1u << 5,  /* function bodies, returns and the entry point */
+        Parse  = 1u << 6,  /* parser decisions */
+    };
+
+    enum class Level : uint32_t {
+        Info = 1,    /* one line per declaration or pass */
+        Detail = 2,  /* per expression, argument and field */
+    };
+
+    extern std::atomic<uint32_t> enabledCategories;
+    extern std::atomic<uint32_t> enabledLevel;
+
+    inline bool enabled(Category category, Level level) {
+        return (enabledCategories.load(std::memory_order_relaxed) & static_cast<uint32_t>(category)) &&
+               static_cast<uint32_t>(level) <= enabledLevel.load(std::memory_order_relaxed);
+    }
+
+    /* Enable from a spec like "scope,call", "all" or "struct:2"; false with error set if invalid */
+    bool configure(const std::string& spec, std::string& error);
+
+    /* Send trace output to a file instead of stderr */
+    bool setOutputFile(const std::string& path, std::string& error);
+
+    /* Write out buffered lines; also runs at exit */
+    void flush();
+
+    /* One trace line, handed to the buffered sink as a unit when destroyed */
+    class Line {
+        std::ostringstream stream;
+
+    public:
+        explicit Line(Category category);
+        ~Line();
+
+        template <typename T>
+        Line& operator<<(const T& value) {
+            stream << value;
+            return *this;
+        }
+    };
+
+    /* Text of anything with an LLVM print(raw_ostream&), e.g. types and values */
+    template <typename T>
+    std::string printed(const T* object) {
+        if (!object) return "<null>";
+        std::string text;
+        llvm::raw_string_ostream out(text);
+        object->print(out);
+        return out.str();
+    }
+}
+
+#if defined(SUMMIT_DISABLE_TRACE)
+#define SUMMIT_TRACE_ENABLED(category, level) false
+#else
+#define SUMMIT_TRACE_ENABLED(category, level) \
+    ::Trace::enabled(::Trace::Category::category, ::Trace::Level::level)
+#endif
+
+/* SUMMIT_TRACE(Struct, Detail, "field '" << name << "'") - the message is only built when enabled */
+#define SUMMIT_TRACE(category, level, message)                          \
+    do {                                                                \
+        if (SUMMIT_TRACE_ENABLED(category, level)) {                    \
+            ::Trace::Line(::Trace::Category::category) << message;      \
+        }                                                               \
+    } while (0)
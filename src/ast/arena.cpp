@@ -0,0 +1,63 @@
+#include "ast/arena.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace AST {
+
+namespace {
+
+thread_local Arena* activeArena = nullptr;
+
+/* Room in front of every node for the Arena* it came from; keeps the node max-aligned */
+constexpr size_t NODE_HEADER = alignof(std::max_align_t);
+static_assert(NODE_HEADER >= sizeof(Arena*), "node header must hold an Arena pointer");
+
+}
+
+void* Arena::allocate(size_t size, size_t align) {
+    auto aligned = [align](std::byte* p) {
+        auto address = reinterpret_cast<uintptr_t>(p);
+        return reinterpret_cast<std::byte*>((address + align - 1) & ~(uintptr_t(align) - 1));
+    };
+
+    std::byte* start = cursor ? aligned(cursor) : nullptr;
+    if (!start || start + size > limit) {
+        size_t blockSize = std::max(nextBlockSize, size + align);
+        blocks.emplace_back(new std::byte[blockSize]); /* not value-initialized */
+        cursor = blocks.back().get();
+        limit = cursor + blockSize;
+        nextBlockSize = std::min(nextBlockSize * 2, MAX_BLOCK_SIZE);
+        start = aligned(cursor);
+    }
+
+    cursor = start + size;
+    allocated += size;
+    return start;
+}
+
+Arena* Arena::current() {
+    return activeArena;
+}
+
+Arena::Scope::Scope(Arena* arena) : previous(activeArena) {
+    activeArena = arena;
+}
+
+Arena::Scope::~Scope() {
+    activeArena = previous;
+}
+
+void* Arena::allocateNode(size_t size) {
+    Arena* arena = activeArena;
+    void* raw = arena ? arena->allocate(size + NODE_HEADER, NODE_HEADER) : ::operator new(size + NODE_HEADER);
+    *static_cast<Arena**>(raw) = arena;
+    return static_cast<std::byte*>(raw) + NODE_HEADER;
+}
+
+void Arena::releaseNode(void* node) noexcept {
+    if (!node) return;
+    void* raw = static_cast<std::byte*>(node) - NODE_HEADER;
+    if (!*static_cast<Arena**>(raw)) ::operator delete(raw);
+}
+
+}
@@ -0,0 +1,620 @@
+#include "ast/semantic_analyzer.h"
+#include "codegen/type_descriptor.h"
+#include <stdexcept>
+#include <string>
+
+namespace AST {
+
+namespace {
+
+bool isComparison(BinaryOp op) {
+    switch (op) {
+        case BinaryOp::GREATER:
+        case BinaryOp::LESS:
+        case BinaryOp::GREATER_EQUAL:
+        case BinaryOp::LESS_EQUAL:
+        case BinaryOp::EQUAL:
+        case BinaryOp::NOT_EQUAL:
+        case BinaryOp::LOGICAL_AND:
+        case BinaryOp::LOGICAL_OR:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool isBitwise(BinaryOp op) {
+    switch (op) {
+        case BinaryOp::BITWISE_AND:
+        case BinaryOp::BITWISE_OR:
+        case BinaryOp::BITWISE_XOR:
+        case BinaryOp::LEFT_SHIFT:
+        case BinaryOp::RIGHT_SHIFT:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/* The bounds diagnostic codegen gives, raised when value does not fit type; name is the
+   variable or field being set, if any */
+void requireInRange(VarType type, const BigInt& value, const std::string& name = "") {
+    if (TypeBounds::checkBounds(type, value)) return;
+    throw std::runtime_error("Value " + value.toString() + " out of bounds for type " + TypeBounds::getTypeName(type) +
+                             (name.empty() ? "" : " '" + name + "'") + ". Valid range: " +
+                             TypeBounds::getTypeRange(type));
+}
+
+std::unique_ptr<Expr> makeNumber(BigInt value) {
+    return std::make_unique<NumberExpr>(std::move(value));
+}
+
+std::unique_ptr<Expr> makeBoolean(bool value) {
+    return std::make_unique<BooleanExpr>(value);
+}
+
+/* value cut to type's storage width and read back with its signedness, as codegen's
+   truncating and reinterpreting casts leave it */
+BigInt wrapToStorage(const BigInt& value, VarType type) {
+    const TypeDescriptor& descriptor = typeDescriptor(type);
+    BigInt modulus = BigInt(1) << descriptor.storageBits;
+    BigInt wrapped = value & (modulus - BigInt(1));
+    if (!descriptor.isUnsigned && wrapped >= (modulus >> 1)) wrapped = wrapped - modulus;
+    return wrapped;
+}
+
+std::unique_ptr<Expr> foldBoolean(BinaryOp op, bool lhs, bool rhs) {
+    switch (op) {
+        case BinaryOp::LOGICAL_AND: return makeBoolean(lhs && rhs);
+        case BinaryOp::LOGICAL_OR: return makeBoolean(lhs || rhs);
+        case BinaryOp::EQUAL: return makeBoolean(lhs == rhs);
+        case BinaryOp::NOT_EQUAL: return makeBoolean(lhs != rhs);
+        default: return nullptr;
+    }
+}
+
+/* lhs op rhs, exactly; type is the type the operation runs in, which the result must fit
+   unless exact is set, for literal-only expressions whose final value alone is checked where
+   it is stored */
+std::unique_ptr<Expr> foldInteger(BinaryOp op, const BigInt& lhs, const BigInt& rhs, VarType type, bool exact) {
+    BigInt result;
+    switch (op) {
+        case BinaryOp::GREATER: return makeBoolean(lhs > rhs);
+        case BinaryOp::LESS: return makeBoolean(lhs < rhs);
+        case BinaryOp::GREATER_EQUAL: return makeBoolean(lhs >= rhs);
+        case BinaryOp::LESS_EQUAL: return makeBoolean(lhs <= rhs);
+        case BinaryOp::EQUAL: return makeBoolean(lhs == rhs);
+        case BinaryOp::NOT_EQUAL: return makeBoolean(lhs != rhs);
+        case BinaryOp::ADD: result = lhs + rhs; break;
+        case BinaryOp::SUBTRACT: result = lhs - rhs; break;
+        case BinaryOp::MULTIPLY: result = lhs * rhs; break;
+        case BinaryOp::DIVIDE:
+        case BinaryOp::MODULUS:
+            if (rhs == BigInt(0)) throw std::runtime_error("Division by zero in constant expression");
+            result = op == BinaryOp::DIVIDE ? lhs / rhs : lhs % rhs;
+            break;
+        case BinaryOp::BITWISE_AND: result = lhs & rhs; break;
+        case BinaryOp::BITWISE_OR: result = lhs | rhs; break;
+        case BinaryOp::BITWISE_XOR: result = lhs ^ rhs; break;
+        case BinaryOp::LEFT_SHIFT:
+        case BinaryOp::RIGHT_SHIFT: {
+            if (rhs < BigInt(0) || rhs >= BigInt(typeDescriptor(type).storageBits)) {
+                throw std::runtime_error("Shift amount " + rhs.toString() + " out of range for type " +
+                                         TypeBounds::getTypeName(type));
+            }
+            unsigned shift = static_cast<unsigned>(rhs.toInt64());
+            result = op == BinaryOp::LEFT_SHIFT ? lhs << shift : lhs >> shift;
+            break;
+        }
+        default:
+            return nullptr;
+    }
+    if (!exact) requireInRange(type, result);
+    return makeNumber(std::move(result));
+}
+
+}
+
+VarType commonOperandType(VarType lhs, VarType rhs) {
+    if (lhs == rhs) return lhs;
+
+    const TypeDescriptor& left = typeDescriptor(lhs);
+    const TypeDescriptor& right = typeDescriptor(rhs);
+    if (left.isFloat || right.isFloat) {
+        return lhs == VarType::FLOAT64 || rhs == VarType::FLOAT64 ? VarType::FLOAT64 : VarType::FLOAT32;
+    }
+    if (!left.storageBits || !right.storageBits) return VarType::VOID;
+
+    if (left.isInteger && right.isInteger && left.isUnsigned != right.isUnsigned) {
+        const TypeDescriptor& signedSide = left.isUnsigned ? right : left;
+        const TypeDescriptor& unsignedSide = left.isUnsigned ? left : right;
+        if (signedSide.maxValue >= unsignedSide.maxValue) return signedSide.type;
+        for (VarType wider : {VarType::INT16, VarType::INT32, VarType::INT64}) {
+            const TypeDescriptor& candidate = typeDescriptor(wider);
+            if (candidate.storageBits > unsignedSide.storageBits && candidate.storageBits >= signedSide.storageBits) {
+                return wider;
+            }
+        }
+        return VarType::INT64;
+    }
+    if (right.storageBits != left.storageBits) return right.storageBits > left.storageBits ? rhs : lhs;
+    return right.bitWidth > left.bitWidth ? rhs : lhs;
+}
+
+void SemanticAnalyzer::analyze(Program& program) {
+    scopes.clear();
+    enterScope();
+    collect(program);
+
+    /* Globals first, so functions see the values of global consts wherever they are declared */
+    for (auto& stmt : program.getStatements()) {
+        if (auto* decl = as<VariableDecl>(stmt.get())) check(*decl);
+    }
+    for (auto& stmt : program.getStatements()) {
+        switch (stmt->getKind()) {
+            case StmtKind::VariableDecl:
+                break;
+            case StmtKind::Function:
+                analyzeFunction(static_cast<FunctionStmt&>(*stmt), nullptr);
+                break;
+            default:
+                analyzeStmt(*stmt);
+                break;
+        }
+    }
+    exitScope();
+}
+
+/* Declarations visible ahead of their position, as codegen emits them in earlier passes */
+void SemanticAnalyzer::collect(Program& program) {
+    functions.clear();
+    structs.clear();
+
+    for (auto& stmt : program.getStatements()) {
+        if (auto* function = as<FunctionStmt>(stmt.get())) {
+            functions[function->getName()] = function;
+        } else if (auto* decl = as<StructDecl>(stmt.get())) {
+            structs[decl->getName()] = decl;
+            for (auto& method : decl->getMethods()) {
+                functions[method->getName()] = method.get();
+            }
+        } else if (auto* decl = as<VariableDecl>(stmt.get())) {
+            Typed typed{decl->getType(), decl->getType() == VarType::STRUCT ? &decl->getStructName() : nullptr};
+            declare(decl->getName(), typed, decl->getIsConst());
+        }
+    }
+}
+
+void SemanticAnalyzer::analyzeFunction(FunctionStmt& function, const std::string* selfStruct) {
+    enterScope();
+    const auto& params = function.getParameters();
+    for (size_t i = 0; i < params.size(); ++i) {
+        Typed typed{params[i].second};
+        if (typed.type == VarType::STRUCT) {
+            const std::string& structName = function.getParameterStructName(i);
+            if (selfStruct && params[i].first == "self") typed.structName = selfStruct;
+            else if (!structName.empty()) typed.structName = &structName;
+        }
+        declare(params[i].first, typed, false);
+    }
+
+    Typed savedReturn = returnType;
+    returnType = {function.getReturnType(),
+                  function.getReturnStructName().empty() ? nullptr : &function.getReturnStructName()};
+    if (function.getBody()) {
+        for (auto& stmt : function.getBody()->getStatements()) analyzeStmt(*stmt);
+    }
+    returnType = savedReturn;
+    exitScope();
+}
+
+void SemanticAnalyzer::analyzeStmt(Stmt& stmt) {
+    visit(stmt, [this](auto& node) { check(node); });
+}
+
+void SemanticAnalyzer::check(VariableDecl& decl) {
+    VarType declared = decl.getType();
+    const Expr* constant = nullptr;
+    if (decl.getValue()) {
+        checkStore(decl.getName(), declared, analyzeExpr(decl.getValue(), declared).type);
+        checkConstant(*decl.getValue(), declared, decl.getName());
+
+        /* A const folded to a literal stands in for its uses */
+        const Expr& value = *decl.getValue();
+        bool literal = TypeBounds::isIntegerType(declared) ? is<NumberExpr>(&value)
+                                                           : declared == VarType::BOOL && is<BooleanExpr>(&value);
+        if (decl.getIsConst() && literal) constant = &value;
+    }
+    declare(decl.getName(), {declared, declared == VarType::STRUCT ? &decl.getStructName() : nullptr},
+            decl.getIsConst(), constant);
+}
+
+void SemanticAnalyzer::check(AssignmentStmt& stmt) {
+    const Binding* binding = lookup(stmt.getName());
+    if (binding && binding->isConst) {
+        throw std::runtime_error("Cannot assign to const variable: " + stmt.getName());
+    }
+    VarType target = binding ? binding->typed.type : VarType::VOID;
+    checkStore(stmt.getName(), target, analyzeExpr(stmt.getValue(), target).type);
+    checkConstant(*stmt.getValue(), target, stmt.getName());
+}
+
+void SemanticAnalyzer::check(BlockStmt& stmt) {
+    for (auto& inner : stmt.getStatements()) analyzeStmt(*inner);
+}
+
+void SemanticAnalyzer::check(IfStmt& stmt) {
+    analyzeExpr(stmt.getCondition());
+    analyzeStmt(*stmt.getThenBranch());
+    if (stmt.getElseBranch()) analyzeStmt(*stmt.getElseBranch());
+}
+
+void SemanticAnalyzer::check(FunctionStmt& stmt) {
+    analyzeFunction(stmt, nullptr);
+}
+
+void SemanticAnalyzer::check(MemberAssignmentStmt& stmt) {
+    Typed object = analyzeExpr(stmt.getObject());
+    VarType target = fieldType(object.structName, stmt.getMemberName());
+    analyzeExpr(stmt.getValue(), target);
+    checkConstant(*stmt.getValue(), target, stmt.getMemberName());
+}
+
+void SemanticAnalyzer::check(WhileStmt& stmt) {
+    analyzeExpr(stmt.getCondition());
+    check(*stmt.getBody());
+}
+
+void SemanticAnalyzer::check(ForLoopStmt& stmt) {
+    enterScope();
+    VarType varType = stmt.getVarType();
+    if (stmt.getInitializer()) {
+        analyzeExpr(stmt.getInitializer(), varType);
+        checkConstant(*stmt.getInitializer(), varType, stmt.getVarName());
+    }
+    declare(stmt.getVarName(), {varType}, false);
+    if (stmt.getCondition()) analyzeExpr(stmt.getCondition());
+    if (stmt.getIncrement()) analyzeExpr(stmt.getIncrement(), varType);
+    check(*stmt.getBody());
+    exitScope();
+}
+
+void SemanticAnalyzer::check(ReturnStmt& stmt) {
+    if (stmt.getValue()) {
+        analyzeExpr(stmt.getValue(), returnType.type);
+        checkConstant(*stmt.getValue(), returnType.type, "");
+    }
+}
+
+void SemanticAnalyzer::check(ExprStmt& stmt) {
+    analyzeExpr(stmt.getExpr());
+}
+
+void SemanticAnalyzer::check(EnumDecl& decl) {
+    for (auto& member : decl.getMembers()) {
+        if (member.second) analyzeExpr(member.second);
+    }
+}
+
+void SemanticAnalyzer::check(StructDecl& decl) {
+    for (auto& field : decl.getFieldDefaults()) {
+        if (field.second) analyzeExpr(field.second);
+    }
+    for (auto& method : decl.getMethods()) {
+        analyzeFunction(*method, &decl.getName());
+    }
+}
+
+SemanticAnalyzer::Typed SemanticAnalyzer::analyzeExpr(std::unique_ptr<Expr>& slot, VarType hint) {
+    Typed typed = visit(*slot, [this, hint](auto& node) { return type(node, hint); });
+    slot->setResolvedType(typed.type, typed.structName);
+
+    if (std::unique_ptr<Expr> folded = fold(*slot, typed.type, typed.literal)) {
+        /* Folded literals are typed like a written one, from the hint when it fits and int64
+           otherwise; consts, casts and anything else typed keep the type they had */
+        if (auto* number = as<NumberExpr>(folded.get())) {
+            bool fitsHint = TypeBounds::isIntegerType(hint) && TypeBounds::checkBounds(hint, number->getValue());
+            VarType literalType = fitsHint ? hint : VarType::INT64;
+            typed = {typed.literal ? literalType : slot->getResolvedType(), nullptr, typed.literal};
+        } else {
+            typed = {VarType::BOOL};
+        }
+        folded->setResolvedType(typed.type);
+        slot = std::move(folded);
+    }
+    return typed;
+}
+
+SemanticAnalyzer::Typed SemanticAnalyzer::type(StringExpr&, VarType) {
+    return {VarType::STRING};
+}
+
+SemanticAnalyzer::Typed SemanticAnalyzer::type(NumberExpr& expr, VarType hint) {
+    if (TypeBounds::isIntegerType(hint) && TypeBounds::checkBounds(hint, expr.getValue())) {
+        return {hint, nullptr, true};
+    }
+    return {VarType::INT64, nullptr, true};
+}
+
+SemanticAnalyzer::Typed SemanticAnalyzer::type(FormatStringExpr& expr, VarType) {
+    for (auto& part : expr.getExpressions()) analyzeExpr(part);
+    return {VarType::STRING};
+}
+
+SemanticAnalyzer::Typed SemanticAnalyzer::type(FloatExpr& expr, VarType) {
+    return {expr.getFloatType()};
+}
+
+SemanticAnalyzer::Typed SemanticAnalyzer::type(BooleanExpr&, VarType) {
+    return {VarType::BOOL};
+}
+
+SemanticAnalyzer::Typed SemanticAnalyzer::type(VariableExpr& expr, VarType) {
+    const Binding* binding = lookup(expr.getName());
+    return binding ? binding->typed : Typed{};
+}
+
+SemanticAnalyzer::Typed SemanticAnalyzer::type(BinaryExpr& expr, VarType hint) {
+    BinaryOp op = expr.getOp();
+    VarType target = !isComparison(op) && TypeBounds::isIntegerType(hint) ? hint : VarType::VOID;
+    Typed lhs = analyzeExpr(expr.getLHS(), target);
+    Typed rhs = analyzeExpr(expr.getRHS(), target);
+
+    /* A literal, written or folded from literals, takes the other operand's type; two
+       literals keep theirs. A folded const is not a literal and keeps its declared type */
+    if (lhs.literal && !rhs.literal) {
+        lhs = analyzeExpr(expr.getLHS(), rhs.type);
+    } else if (rhs.literal && !lhs.literal) {
+        rhs = analyzeExpr(expr.getRHS(), lhs.type);
+    }
+    VarType lhsType = lhs.type;
+    VarType rhsType = rhs.type;
+
+    VarType common = commonOperandType(lhsType, rhsType);
+    if (isComparison(op)) return {VarType::BOOL};
+    if (op == BinaryOp::ADD && (lhsType == VarType::STRING || rhsType == VarType::STRING)) {
+        return {VarType::STRING};
+    }
+
+    /* codegen applies bitwise operators to floats through int64 */
+    if (isBitwise(op) && TypeBounds::isFloatType(common)) return {VarType::INT64};
+
+    /* Integer arithmetic headed for a wider integer is carried out at that width, so b * 3
+       stored into an int32 does not wrap at b's width; a signed common type headed for
+       uint64 uses int64, whose values the store then checks */
+    if (TypeBounds::isIntegerType(common) && TypeBounds::isIntegerType(target) &&
+        typeDescriptor(target).storageBits > typeDescriptor(common).storageBits) {
+        bool signedIntoUint64 = target == VarType::UINT64 && !TypeBounds::isUnsignedType(common);
+        return {signedIntoUint64 ? VarType::INT64 : commonOperandType(common, target), nullptr,
+                lhs.literal && rhs.literal};
+    }
+    return {common, nullptr, lhs.literal && rhs.literal};
+}
+
+SemanticAnalyzer::Typed SemanticAnalyzer::type(CallExpr& expr, VarType) {
+    if (auto* member = as<MemberAccessExpr>(expr.getCalleeExpr().get())) {
+        Typed object = analyzeExpr(member->getObject());
+        if (object.type == VarType::STRUCT && object.structName) {
+            auto method = functions.find(*object.structName + "." + member->getMember());
+            if (method != functions.end()) {
+                analyzeArgs(expr, method->second, 1);
+                const FunctionStmt& callee = *method->second;
+                const std::string& structName = callee.getReturnStructName();
+                return {callee.getReturnType(), structName.empty() ? nullptr : &structName};
+            }
+        }
+        analyzeArgs(expr, nullptr, 0);
+        return {};
+    }
+    if (expr.getCalleeExpr()) {
+        analyzeExpr(expr.getCalleeExpr());
+        analyzeArgs(expr, nullptr, 0);
+        return {};
+    }
+
+    auto function = functions.find(expr.getCallee());
+    if (function == functions.end()) {
+        analyzeArgs(expr, nullptr, 0);
+        return {};
+    }
+    analyzeArgs(expr, function->second, 0);
+    const std::string& structName = function->second->getReturnStructName();
+    return {function->second->getReturnType(), structName.empty() ? nullptr : &structName};
+}
+
+void SemanticAnalyzer::analyzeArgs(CallExpr& expr, const FunctionStmt* callee, size_t firstParam) {
+    auto& args = expr.getArgs();
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (callee && firstParam + i < callee->getParameters().size()) {
+            const auto& param = callee->getParameters()[firstParam + i];
+            analyzeExpr(args[i], param.second);
+            checkConstant(*args[i], param.second, param.first);
+        } else {
+            analyzeExpr(args[i]);
+        }
+    }
+}
+
+SemanticAnalyzer::Typed SemanticAnalyzer::type(CastExpr& expr, VarType) {
+    analyzeExpr(expr.getExprSlot());
+    return {expr.getTargetType()};
+}
+
+SemanticAnalyzer::Typed SemanticAnalyzer::type(ModuleExpr&, VarType) {
+    return {VarType::MODULE};
+}
+
+SemanticAnalyzer::Typed SemanticAnalyzer::type(MemberAccessExpr& expr, VarType) {
+    Typed object = analyzeExpr(expr.getObject());
+    if (object.type == VarType::MODULE) return {VarType::MODULE};
+    return {fieldType(object.structName, expr.getMember())};
+}
+
+SemanticAnalyzer::Typed SemanticAnalyzer::type(UnaryExpr& expr, VarType hint) {
+    switch (expr.getOp()) {
+        case UnaryOp::LOGICAL_NOT:
+            analyzeExpr(expr.getOperandSlot());
+            return {VarType::BOOL};
+        case UnaryOp::NEGATE: {
+            /* A negated literal may only borrow a signed type, or -1 would become uint 255 */
+            bool signedHint = TypeBounds::isIntegerType(hint) && !TypeBounds::isUnsignedType(hint);
+            return analyzeExpr(expr.getOperandSlot(), signedHint ? hint : VarType::VOID);
+        }
+        case UnaryOp::BITWISE_NOT: {
+            Typed operand = analyzeExpr(expr.getOperandSlot(), hint);
+            /* codegen widens bool to int64 first */
+            return {operand.type == VarType::BOOL ? VarType::INT64 : operand.type, nullptr, operand.literal};
+        }
+    }
+    return {};
+}
+
+SemanticAnalyzer::Typed SemanticAnalyzer::type(EnumValueExpr&, VarType) {
+    return {VarType::INT32};
+}
+
+SemanticAnalyzer::Typed SemanticAnalyzer::type(StructLiteralExpr& expr, VarType) {
+    auto decl = structs.find(expr.getStructName());
+    const std::string* structName = decl != structs.end() ? &decl->second->getName() : &expr.getStructName();
+    for (auto& field : expr.getFields()) {
+        if (!field.second) continue;
+        VarType target = fieldType(structName, field.first);
+        analyzeExpr(field.second, target);
+        checkConstant(*field.second, target, field.first);
+    }
+    return {VarType::STRUCT, structName};
+}
+
+/* Literal replacing expr when it is made only of literals and const bindings; type is expr's
+   resolved type, which folded arithmetic must fit unless exact is set: expr is built only from
+   literals and is evaluated without intermediate widths, its value checked where it is stored */
+std::unique_ptr<Expr> SemanticAnalyzer::fold(Expr& expr, VarType type, bool exact) const {
+    switch (expr.getKind()) {
+        case ExprKind::Variable: {
+            const Binding* binding = lookup(static_cast<VariableExpr&>(expr).getName());
+            if (!binding || !binding->constant) return nullptr;
+            if (auto* number = as<NumberExpr>(binding->constant)) return makeNumber(number->getValue());
+            return makeBoolean(static_cast<const BooleanExpr&>(*binding->constant).getValue());
+        }
+        case ExprKind::Binary: {
+            auto& binary = static_cast<BinaryExpr&>(expr);
+            auto* lhsBool = as<BooleanExpr>(binary.getLHS().get());
+            auto* rhsBool = as<BooleanExpr>(binary.getRHS().get());
+            if (lhsBool && rhsBool) return foldBoolean(binary.getOp(), lhsBool->getValue(), rhsBool->getValue());
+
+            auto* lhs = as<NumberExpr>(binary.getLHS().get());
+            auto* rhs = as<NumberExpr>(binary.getRHS().get());
+            if (!lhs || !rhs) return nullptr;
+            if (exact) return foldInteger(binary.getOp(), lhs->getValue(), rhs->getValue(), VarType::INT64, true);
+
+            /* Comparisons are exact in codegen too, uint64 against a signed type included */
+            if (isComparison(binary.getOp())) {
+                return foldInteger(binary.getOp(), lhs->getValue(), rhs->getValue(), VarType::INT64, true);
+            }
+
+            /* codegen converts both operands to their common type first, so only fold when
+               that conversion keeps both values; arithmetic then runs in expr's own type,
+               which may be wider */
+            VarType common = commonOperandType(lhs->getResolvedType(), rhs->getResolvedType());
+            if (!TypeBounds::isIntegerType(common) || !TypeBounds::checkBounds(common, lhs->getValue()) ||
+                !TypeBounds::checkBounds(common, rhs->getValue())) {
+                return nullptr;
+            }
+            VarType operation = TypeBounds::isIntegerType(type) ? type : common;
+            return foldInteger(binary.getOp(), lhs->getValue(), rhs->getValue(), operation, false);
+        }
+        case ExprKind::Unary: {
+            auto& unary = static_cast<UnaryExpr&>(expr);
+            if (auto* operand = as<BooleanExpr>(unary.getOperand())) {
+                return unary.getOp() == UnaryOp::LOGICAL_NOT ? makeBoolean(!operand->getValue()) : nullptr;
+            }
+            auto* operand = as<NumberExpr>(unary.getOperand());
+            if (!operand || !TypeBounds::isIntegerType(type)) return nullptr;
+
+            BigInt result;
+            if (unary.getOp() == UnaryOp::NEGATE) {
+                result = -operand->getValue();
+            } else if (unary.getOp() == UnaryOp::BITWISE_NOT) {
+                /* Flips every storage bit: ~x for signed types, storage max - x for unsigned */
+                result = typeDescriptor(type).isUnsigned ? wrapToStorage(~operand->getValue(), type)
+                                                         : ~operand->getValue();
+            } else {
+                return nullptr;
+            }
+            if (!exact) requireInRange(type, result);
+            return makeNumber(std::move(result));
+        }
+        case ExprKind::Cast: {
+            auto& cast = static_cast<CastExpr&>(expr);
+            VarType target = cast.getTargetType();
+            Expr& operand = *cast.getExpr();
+            VarType source = operand.getResolvedType();
+            if (!TypeBounds::isCastValid(source, target)) return nullptr;
+
+            if (auto* boolean = as<BooleanExpr>(&operand)) {
+                if (target == VarType::BOOL) return makeBoolean(boolean->getValue());
+                if (!TypeBounds::isIntegerType(target) || !TypeBounds::checkBounds(target, BigInt(boolean->getValue()))) {
+                    return nullptr;
+                }
+                return makeNumber(BigInt(boolean->getValue()));
+            }
+
+            auto* number = as<NumberExpr>(&operand);
+            if (!number || !TypeBounds::isIntegerType(source) || !TypeBounds::checkBounds(source, number->getValue())) {
+                return nullptr;
+            }
+            if (target == VarType::BOOL) return makeBoolean(number->getValue() != BigInt(0));
+            if (!TypeBounds::isIntegerType(target)) return nullptr;
+
+            /* Widening keeps the value and narrowing truncates, so the result is the value
+               at the target's storage width; it is left to codegen when that is outside a
+               narrower-than-storage target such as int4 */
+            BigInt result = wrapToStorage(number->getValue(), target);
+            if (!TypeBounds::checkBounds(target, result)) return nullptr;
+            return makeNumber(std::move(result));
+        }
+        default:
+            return nullptr;
+    }
+}
+
+/* An integer literal stored into target must fit it; raised here so a folded expression is
+   reported like a written literal */
+void SemanticAnalyzer::checkConstant(const Expr& value, VarType target, const std::string& name) const {
+    auto* number = as<NumberExpr>(&value);
+    if (number && TypeBounds::isIntegerType(target)) requireInRange(target, number->getValue(), name);
+}
+
+VarType SemanticAnalyzer::fieldType(const std::string* structName, const std::string& field) const {
+    if (!structName) return VarType::VOID;
+    auto decl = structs.find(*structName);
+    if (decl == structs.end()) return VarType::VOID;
+    for (const auto& declared : decl->second->getFields()) {
+        if (declared.first == field) return declared.second;
+    }
+    return VarType::VOID;
+}
+
+/* Strings and numbers never convert into one another implicitly */
+void SemanticAnalyzer::checkStore(const std::string& name, VarType target, VarType value) const {
+    bool targetIsString = target == VarType::STRING;
+    bool valueIsString = value == VarType::STRING;
+    if (targetIsString == valueIsString) return;
+    if (TypeBounds::isNumericType(targetIsString ? value : target)) {
+        throw std::runtime_error("Type mismatch in assignment to variable: " + name);
+    }
+}
+
+void SemanticAnalyzer::declare(const std::string& name, Typed typed, bool isConst, const Expr* constant) {
+    scopes.back()[name] = {typed, isConst, constant};
+}
+
+const SemanticAnalyzer::Binding* SemanticAnalyzer::lookup(std::string_view name) const {
+    for (auto scope = scopes.rbegin(); scope != scopes.rend(); ++scope) {
+        auto it = scope->find(name);
+        if (it != scope->end()) return &it->second;
+    }
+    return nullptr;
+}
+
+}
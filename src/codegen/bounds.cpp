@@ -1,4 +1,5 @@
 #include "bounds.h"
+#include "type_descriptor.h"
 #include "ast/ast.h"
 #include <map>
 #include <string>
@@ -10,128 +11,56 @@ using namespace AST;
 
 /* Check if the value is within type bounds */
 bool TypeBounds::checkBounds(VarType type, const BigInt& value) {
-    switch (type) {
-        case VarType::BOOL:
-            return value == BigInt("0") || value == BigInt("1");
-        case VarType::INT4:
-            return value >= BigInt::MIN_INT4 && value <= BigInt::MAX_INT4;
-        case VarType::INT8:
-            return value >= BigInt::MIN_INT8 && value <= BigInt::MAX_INT8;
-        case VarType::INT12:
-            return value >= BigInt::MIN_INT12 && value <= BigInt::MAX_INT12;
-        case VarType::INT16:
-            return value >= BigInt::MIN_INT16 && value <= BigInt::MAX_INT16;
-        case VarType::INT24:
-            return value >= BigInt::MIN_INT24 && value <= BigInt::MAX_INT24;
-        case VarType::INT32:
-            return value >= BigInt::MIN_INT32 && value <= BigInt::MAX_INT32;
-        case VarType::INT48:
-            return value >= BigInt::MIN_INT48 && value <= BigInt::MAX_INT48;
-        case VarType::INT64:
-            return value >= BigInt::MIN_INT64 && value <= BigInt::MAX_INT64;
-        case VarType::UINT4:
-            return value >= BigInt("0") && value <= BigInt::MAX_UINT4;
-        case VarType::UINT8:
-            return value >= BigInt("0") && value <= BigInt::MAX_UINT8;
-        case VarType::UINT12:
-            return value >= BigInt("0") && value <= BigInt::MAX_UINT12;
-        case VarType::UINT16:
-            return value >= BigInt("0") && value <= BigInt::MAX_UINT16;
-        case VarType::UINT24:
-            return value >= BigInt("0") && value <= BigInt::MAX_UINT24;
-        case VarType::UINT32:
-            return value >= BigInt("0") && value <= BigInt::MAX_UINT32;
-        case VarType::UINT48:
-            return value >= BigInt("0") && value <= BigInt::MAX_UINT48;
-        case VarType::UINT64:
-            return value >= BigInt("0") && value <= BigInt::MAX_UINT64;
-        case VarType::UINT0:
-            return value == BigInt("0");
-        case VarType::STRING:
-            return true;
-        case VarType::MODULE:
-            return true;
-        default:
-            return false;
+    if (value.fitsInInt64()) {
+        return checkBounds(type, value.toInt64());
+    }
+    if (!typeDescriptor(type).hasRange) {
+        return type == VarType::STRING || type == VarType::MODULE;
     }
+    /* Past int64 only the top half of uint64 can still be in range */
+    return typeDescriptor(type).maxValue > uint64_t(INT64_MAX) && !(value < BigInt::MAX_INT64) &&
+           value <= BigInt::MAX_UINT64;
+}
+
+bool TypeBounds::checkBounds(VarType type, int64_t value) {
+    const TypeDescriptor& desc = typeDescriptor(type);
+    if (!desc.hasRange) {
+        return type == VarType::STRING || type == VarType::MODULE;
+    }
+    if (value < desc.minValue) return false;
+    return value < 0 || uint64_t(value) <= desc.maxValue;
+}
+
+bool TypeBounds::checkBounds(VarType type, uint64_t value) {
+    const TypeDescriptor& desc = typeDescriptor(type);
+    if (!desc.hasRange) {
+        return type == VarType::STRING || type == VarType::MODULE;
+    }
+    return value <= desc.maxValue;
 }
 
 /* Get the range of a type as a string */
 std::string TypeBounds::getTypeRange(VarType type) {
+    const TypeDescriptor& desc = typeDescriptor(type);
     switch (type) {
         case VarType::BOOL:
             return "true or false";
-        case VarType::INT4:
-            return BigInt::MIN_INT4.toString() + " to " + BigInt::MAX_INT4.toString();
-        case VarType::INT8:
-            return BigInt::MIN_INT8.toString() + " to " + BigInt::MAX_INT8.toString();
-        case VarType::INT12:
-            return BigInt::MIN_INT12.toString() + " to " + BigInt::MAX_INT12.toString();
-        case VarType::INT16:
-            return BigInt::MIN_INT16.toString() + " to " + BigInt::MAX_INT16.toString();
-        case VarType::INT24:
-            return BigInt::MIN_INT24.toString() + " to " + BigInt::MAX_INT24.toString();
-        case VarType::INT32:
-            return BigInt::MIN_INT32.toString() + " to " + BigInt::MAX_INT32.toString();
-        case VarType::INT48:
-            return BigInt::MIN_INT48.toString() + " to " + BigInt::MAX_INT48.toString();
-        case VarType::INT64:
-            return BigInt::MIN_INT64.toString() + " to " + BigInt::MAX_INT64.toString();
-        case VarType::UINT4:
-            return "0 to " + BigInt::MAX_UINT4.toString();
-        case VarType::UINT8:
-            return "0 to " + BigInt::MAX_UINT8.toString();
-        case VarType::UINT12:
-            return "0 to " + BigInt::MAX_UINT12.toString();
-        case VarType::UINT16:
-            return "0 to " + BigInt::MAX_UINT16.toString();
-        case VarType::UINT24:
-            return "0 to " + BigInt::MAX_UINT24.toString();
-        case VarType::UINT32:
-            return "0 to " + BigInt::MAX_UINT32.toString();
-        case VarType::UINT48:
-            return "0 to " + BigInt::MAX_UINT48.toString();
-        case VarType::UINT64:
-            return "0 to " + BigInt::MAX_UINT64.toString();
-        case VarType::UINT0:
-            return "0 to 0";
         case VarType::STRING:
             return "string (no numeric bounds)";
         case VarType::MODULE:
             return "module (no numeric bounds)";
         default:
-            return "unknown range";
+            break;
+    }
+    if (!desc.hasRange) {
+        return "unknown range";
     }
+    return std::to_string(desc.minValue) + " to " + std::to_string(desc.maxValue);
 }
 
 /* Get the type name as a string */
 std::string TypeBounds::getTypeName(VarType type) {
-    switch (type) {
-        case VarType::BOOL: return "bool";
-        case VarType::INT4: return "int4";
-        case VarType::INT8: return "int8";
-        case VarType::INT12: return "int12";
-        case VarType::INT16: return "int16";
-        case VarType::INT24: return "int24";
-        case VarType::INT32: return "int32";
-        case VarType::INT48: return "int48";
-        case VarType::INT64: return "int64";
-        case VarType::UINT4: return "uint4";
-        case VarType::UINT8: return "uint8";
-        case VarType::UINT12: return "uint12";
-        case VarType::UINT16: return "uint16";
-        case VarType::UINT24: return "uint24";
-        case VarType::UINT32: return "uint32";
-        case VarType::UINT48: return "uint48";
-        case VarType::UINT64: return "uint64";
-        case VarType::UINT0: return "uint0";
-        case VarType::FLOAT32: return "float32";
-        case VarType::FLOAT64: return "float64";
-        case VarType::STRING: return "str";
-        case VarType::VOID: return "void";
-        case VarType::MODULE: return "module";
-        default: return "unknown";
-    }
+    return std::string(typeDescriptor(type).name);
 }
 
 /* Check if a cast from one type to another is valid */
@@ -170,36 +99,17 @@ bool TypeBounds::isNumericType(VarType type) {
 
 /* Check if the type is an integer type */
 bool TypeBounds::isIntegerType(VarType type) {
-    return (type == VarType::INT4 || type == VarType::INT8 || type == VarType::INT12 || 
-            type == VarType::INT16 || type == VarType::INT24 || type == VarType::INT32 || 
-            type == VarType::INT48 || type == VarType::INT64 ||
-            type == VarType::UINT4 || type == VarType::UINT8 || type == VarType::UINT12 || 
-            type == VarType::UINT16 || type == VarType::UINT24 || type == VarType::UINT32 || 
-            type == VarType::UINT48 || type == VarType::UINT64 || type == VarType::UINT0);
+    return typeDescriptor(type).isInteger;
 }
 
 /* Check if the type is a floating point type */
 bool TypeBounds::isFloatType(VarType type) {
-    return (type == VarType::FLOAT32 || type == VarType::FLOAT64);
+    return typeDescriptor(type).isFloat;
 }
 
 /* Get the bit width of the type */
 size_t TypeBounds::getTypeBitWidth(VarType type) {
-    switch (type) {
-        case VarType::BOOL: return 1;
-        case VarType::INT4: case VarType::UINT4: return 4;
-        case VarType::INT8: case VarType::UINT8: return 8;
-        case VarType::INT12: case VarType::UINT12: return 12;
-        case VarType::INT16: case VarType::UINT16: return 16;
-        case VarType::INT24: case VarType::UINT24: return 24;
-        case VarType::INT32: case VarType::UINT32: return 32;
-        case VarType::INT48: case VarType::UINT48: return 48;
-        case VarType::INT64: case VarType::UINT64: return 64;
-        case VarType::FLOAT32: return 32;
-        case VarType::FLOAT64: return 64;
-        case VarType::UINT0: return 1;
-        default: return 0;
-    }
+    return typeDescriptor(type).bitWidth;
 }
 
 /* Check if bounds checking is needed when casting types */
@@ -216,10 +126,7 @@ bool TypeBounds::requiresBoundsCheck(VarType fromType, VarType toType) {
         if (toBits < fromBits) return true;
         
         bool fromUnsigned = isUnsignedType(fromType);
-        bool toSigned = (toType == VarType::INT4 || toType == VarType::INT8 || 
-                        toType == VarType::INT12 || toType == VarType::INT16 || 
-                        toType == VarType::INT24 || toType == VarType::INT32 || 
-                        toType == VarType::INT48 || toType == VarType::INT64);
+        bool toSigned = !isUnsignedType(toType);
         
         if (fromUnsigned && toSigned && fromBits == toBits) return true;
     }
@@ -227,16 +134,25 @@ bool TypeBounds::requiresBoundsCheck(VarType fromType, VarType toType) {
     return false;
 }
 
+bool TypeBounds::storageFitsIn(VarType source, VarType target) {
+    const TypeDescriptor& from = typeDescriptor(source);
+    const TypeDescriptor& to = typeDescriptor(target);
+    if (!from.hasRange || !to.hasRange) return false;
+
+    unsigned bits = from.storageBits;
+    if (from.isUnsigned || source == VarType::BOOL) {
+        return to.minValue <= 0 && (bits == 64 ? UINT64_MAX : (uint64_t(1) << bits) - 1) <= to.maxValue;
+    }
+    int64_t min = bits == 64 ? INT64_MIN : -(int64_t(1) << (bits - 1));
+    uint64_t max = bits == 64 ? uint64_t(INT64_MAX) : (uint64_t(1) << (bits - 1)) - 1;
+    return min >= to.minValue && max <= to.maxValue;
+}
+
 /* Check if the type is unsigned */
 bool TypeBounds::isUnsignedType(VarType type) {
-    return (type == VarType::UINT4 || type == VarType::UINT8 || 
-            type == VarType::UINT12 || type == VarType::UINT16 ||
-            type == VarType::UINT24 || type == VarType::UINT32 || 
-            type == VarType::UINT48 || type == VarType::UINT64 ||
-            type == VarType::UINT0);
+    return typeDescriptor(type).isUnsigned;
 }
 
-
 static std::map<std::string, AST::VarType> typeNameMap = {
     {"int4", AST::VarType::INT4},
     {"int8", AST::VarType::INT8},
@@ -270,26 +186,10 @@ AST::VarType TypeBounds::stringToType(const std::string& typeName) {
 }
 
 std::optional<std::pair<int64_t, int64_t>> TypeBounds::getBounds(VarType type) {
-    switch (type) {
-        case VarType::INT4: return {{-8, 7}};
-        case VarType::INT8: return {{-128, 127}};
-        case VarType::INT12: return {{-2048, 2047}};
-        case VarType::INT16: return {{-32768, 32767}};
-        case VarType::INT24: return {{-8388608, 8388607}};
-        case VarType::INT32: return {{-2147483648, 2147483647}};
-        case VarType::INT48: return {{-140737488355328LL, 140737488355327LL}};
-        case VarType::INT64: return {{-9223372036854775807LL - 1, 9223372036854775807LL}};
-        
-        case VarType::UINT0: return {{0, 0}};
-        case VarType::UINT4: return {{0, 15}};
-        case VarType::UINT8: return {{0, 255}};
-        case VarType::UINT12: return {{0, 4095}};
-        case VarType::UINT16: return {{0, 65535}};
-        case VarType::UINT24: return {{0, 16777215}};
-        case VarType::UINT32: return {{0, 4294967295}};
-        case VarType::UINT48: return {{0, 281474976710655LL}};
-        case VarType::UINT64: return {{0, 18446744073709551615ULL}};
-        
-        default: return std::nullopt;
+    const TypeDescriptor& desc = typeDescriptor(type);
+    if (!desc.isInteger) {
+        return std::nullopt;
     }
-}
\ No newline at end of file
+    /* uint64's maximum does not fit and comes back as -1, as it always has; callers compare unsigned */
+    return {{desc.minValue, static_cast<int64_t>(desc.maxValue)}};
+}
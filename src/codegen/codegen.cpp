@@ -4,6 +4,9 @@
 #include "stmt_codegen.h"
 #include <llvm/IR/Verifier.h>
 #include "codegen/bounds.h"
+#include "codegen/type_descriptor.h"
+#include "codegen/lld_linker.h"
+#include "utils/time_report.h"
 #include "ast.h"
 #include <llvm/Support/TargetSelect.h>
 #include <llvm/Target/TargetMachine.h>
@@ -11,17 +14,39 @@
 #include <llvm/MC/TargetRegistry.h>
 #include <llvm/Support/FileSystem.h>
 #include <llvm/IR/LegacyPassManager.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Passes/OptimizationLevel.h>
+#include <llvm/Support/CodeGen.h>
+#include <llvm/TargetParser/Host.h>
+#include <llvm/TargetParser/SubtargetFeature.h>
+#include <llvm/ADT/StringMap.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
+#include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
+#include <llvm/Linker/Linker.h>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Transforms/IPO/Internalize.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/ADT/StringSet.h>
+#include <llvm/TargetParser/Triple.h>
+#include "stdlib/core/runtime_symbols.h"
 #include <system_error>
 #include <cstdlib>
+#include <cstdio>
 #include <fstream>
 #include <filesystem>
+#include <chrono>
+#include <mutex>
+#include <map>
+#include <thread>
 
 /* Using LLVM and AST namespaces */
 using namespace llvm;
 using namespace AST;
 
 /* Constructor that sets up LLVM context, builder, and module */
-CodeGen::CodeGen() {
+CodeGen::CodeGen(StringInterner& symbolNames) : symbolNames(symbolNames) {
     llvmContext = std::make_unique<LLVMContext>();
     irBuilder = std::make_unique<IRBuilder<>>(*llvmContext);
     llvmModule = std::make_unique<Module>("summit", *llvmContext);
@@ -42,149 +67,89 @@ llvm::Type* CodeGen::getLLVMType(AST::VarType type, const std::string& structNam
         return structType;
     }
 
-    auto& context = getContext();
-    switch (type) {
-        case AST::VarType::BOOL: return Type::getInt1Ty(context);
-        case AST::VarType::INT4: return Type::getInt8Ty(context);
-        case AST::VarType::INT8: return Type::getInt8Ty(context);
-        case AST::VarType::INT12: return Type::getInt16Ty(context);
-        case AST::VarType::INT16: return Type::getInt16Ty(context);
-        case AST::VarType::INT24: return Type::getInt32Ty(context);
-        case AST::VarType::INT32: return Type::getInt32Ty(context);
-        case AST::VarType::INT48: return Type::getInt64Ty(context);
-        case AST::VarType::INT64: return Type::getInt64Ty(context);
-        case AST::VarType::UINT4: return Type::getInt8Ty(context);
-        case AST::VarType::UINT8: return Type::getInt8Ty(context);
-        case AST::VarType::UINT12: return Type::getInt16Ty(context);
-        case AST::VarType::UINT16: return Type::getInt16Ty(context);
-        case AST::VarType::UINT24: return Type::getInt32Ty(context);
-        case AST::VarType::UINT32: return Type::getInt32Ty(context);
-        case AST::VarType::UINT48: return Type::getInt64Ty(context);
-        case AST::VarType::UINT64: return Type::getInt64Ty(context);
-        case AST::VarType::UINT0: return Type::getInt1Ty(context);
-        case AST::VarType::FLOAT32: return Type::getFloatTy(context);
-        case AST::VarType::FLOAT64: return Type::getDoubleTy(context);
-        case AST::VarType::STRING: return PointerType::get(Type::getInt8Ty(context), 0);
-        case AST::VarType::VOID: return Type::getVoidTy(context);
-        case AST::VarType::MODULE: 
-            return StructType::create(context, "module_t");
-        default: throw std::runtime_error("Unknown type");
+    llvm::Type*& cached = typeCache[static_cast<size_t>(type)];
+    if (!cached) {
+        const auto& desc = AST::typeDescriptor(type);
+        if (!desc.llvmType) {
+            throw std::runtime_error("Unknown type");
+        }
+        cached = desc.llvmType(getContext());
     }
+    return cached;
 }
 /* Enter a new scope */
 void CodeGen::enterScope() {
-    std::unordered_map<std::string, llvm::Value*> newNamedValues;
-    std::unordered_map<std::string, AST::VarType> newVariableTypes;
-    std::unordered_set<std::string> newConstVariables;
-    
-    for (const auto& globalName : globalVariables) {
-        for (auto it = namedValuesStack.rbegin(); it != namedValuesStack.rend(); ++it) {
-            auto found = it->find(globalName);
-            if (found != it->end()) {
-                newNamedValues[globalName] = found->second;
-                break;
-            }
-        }
-        
-        for (auto it = variableTypesStack.rbegin(); it != variableTypesStack.rend(); ++it) {
-            auto found = it->find(globalName);
-            if (found != it->end()) {
-                newVariableTypes[globalName] = found->second;
-                break;
-            }
-        }
-
-        for (auto it = constVariablesStack.rbegin(); it != constVariablesStack.rend(); ++it) {
-            if (it->find(globalName) != it->end()) {
-                newConstVariables.insert(globalName);
-                break;
-            }
-        }
-        
-        std::cout << "DEBUG enterScope: Carrying over global '" << globalName << "' to new scope" << std::endl;
-    }
-    
-    std::cout << "DEBUG enterScope: Carried " << newNamedValues.size() << " global variables to new scope" << std::endl;
-    
-    namedValuesStack.push_back(newNamedValues);
-    variableTypesStack.push_back(newVariableTypes);
-    constVariablesStack.push_back(newConstVariables);
-    
-    std::cout << "DEBUG enterScope: Created new scope with " << newNamedValues.size() 
-              << " total variables" << std::endl;
+    symbols.enterScope();
+    SUMMIT_TRACE(Scope, Info, "enterScope: depth " << symbols.depth());
 }
 
 /* Exit current scope */
 void CodeGen::exitScope() {
-    if (!namedValuesStack.empty()) {
-        namedValuesStack.pop_back();
-        variableTypesStack.pop_back();
-        constVariablesStack.pop_back();
-    }
-}
-/* Get variables in current scope */
-std::unordered_map<std::string, llvm::Value*>& CodeGen::getNamedValues() {
-    if (namedValuesStack.empty()) throw std::runtime_error("No active scope");
-    return namedValuesStack.back();
+    symbols.exitScope();
+    SUMMIT_TRACE(Scope, Info, "exitScope: depth " << symbols.depth());
 }
 
-/* Get variable types in current scope */
-std::unordered_map<std::string, AST::VarType>& CodeGen::getVariableTypes() {
-    if (variableTypesStack.empty()) throw std::runtime_error("No active scope");
-    return variableTypesStack.back();
+/* Declare a variable in the current scope */
+void CodeGen::declareVariable(const std::string& name, llvm::Value* value, AST::VarType type) {
+    auto& symbol = symbols.declare(symbolNames.intern(name));
+    symbol.value = value;
+    symbol.type = type;
 }
 
-/* Get const variables in current scope */
-std::unordered_set<std::string>& CodeGen::getConstVariables() {
-    if (constVariablesStack.empty()) throw std::runtime_error("No active scope");
-    return constVariablesStack.back();
+/* Mark the visible declaration of a variable as const */
+void CodeGen::markVariableConst(const std::string& name) {
+    if (auto* symbol = symbols.lookup(symbolNames.find(name))) {
+        symbol->isConst = true;
+    }
 }
 
 /* Look up variable value from inner to outer scope */
 llvm::Value* CodeGen::lookupVariable(const std::string& name) {
-    for (auto it = namedValuesStack.rbegin(); it != namedValuesStack.rend(); ++it) {
-        auto found = it->find(name);
-        if (found != it->end()) return found->second;
-    }
-    return nullptr;
+    auto* symbol = symbols.lookup(symbolNames.find(name));
+    return symbol ? symbol->value : nullptr;
 }
 
 /* Look up variable type from inner to outer scope */
 AST::VarType CodeGen::lookupVariableType(const std::string& name) {
-    for (auto it = variableTypesStack.rbegin(); it != variableTypesStack.rend(); ++it) {
-        auto found = it->find(name);
-        if (found != it->end()) return found->second;
-    }
-    return AST::VarType::VOID;
+    auto* symbol = symbols.lookup(symbolNames.find(name));
+    return symbol ? symbol->type : AST::VarType::VOID;
 }
 
 /* Check if a variable is const */
 bool CodeGen::isVariableConst(const std::string& name) {
-    for (auto it = constVariablesStack.rbegin(); it != constVariablesStack.rend(); ++it) {
-        if (it->find(name) != it->end()) return true;
-    }
-    return false;
+    auto* symbol = symbols.lookup(symbolNames.find(name));
+    return symbol && symbol->isConst;
 }
 
 void CodeGen::registerStructType(const std::string& name, llvm::StructType* type, 
                                 const std::vector<std::pair<std::string, AST::VarType>>& fields) {
-    structTypes[name] = type;
-    structFields_[name] = fields;
-    
-    auto& fieldMap = structFieldIndices[name];
+    StringInterner::Id id = symbolNames.intern(name);
+    StructInfo& info = structs[id];
+    if (!info.declared) {
+        info.declared = true;
+        structOrder.push_back(id);
+    }
+
+    info.type = type;
+    info.fields = fields;
     for (size_t i = 0; i < fields.size(); i++) {
-        fieldMap[fields[i].first] = i;
+        info.fieldIndices[symbolNames.intern(fields[i].first)] = i;
     }
 }
 
+const CodeGen::StructInfo* CodeGen::findStruct(const std::string& name) const {
+    auto it = structs.find(symbolNames.find(name));
+    return it == structs.end() ? nullptr : &it->second;
+}
+
 int CodeGen::getStructFieldIndex(const std::string& structName, const std::string& fieldName) {
-    auto structIt = structFieldIndices.find(structName);
-    if (structIt == structFieldIndices.end()) {
+    const StructInfo* info = findStruct(structName);
+    if (!info) {
         return -1;
     }
     
-    auto fieldIt = structIt->second.find(fieldName);
-    if (fieldIt == structIt->second.end()) {
+    auto fieldIt = info->fieldIndices.find(symbolNames.find(fieldName));
+    if (fieldIt == info->fieldIndices.end()) {
         return -1;
     }
     
@@ -192,14 +157,38 @@ int CodeGen::getStructFieldIndex(const std::string& structName, const std::strin
 }
 
 llvm::Type* CodeGen::getStructType(const std::string& name) {
-    auto it = structTypes.find(name);
-    if (it != structTypes.end()) {
-        return it->second;
+    StructInfo& info = structs[symbolNames.intern(name)];
+    if (!info.type) {
+        /* Referenced before its declaration: an opaque struct the declaration will fill in */
+        info.type = llvm::StructType::create(getContext(), name);
     }
-    
-    llvm::StructType* structType = llvm::StructType::create(getContext(), name);
-    structTypes[name] = structType;
-    return structType;
+    return info.type;
+}
+
+std::pair<llvm::StructType*, int> CodeGen::findStructWithField(const std::string& fieldName) const {
+    StringInterner::Id field = symbolNames.find(fieldName);
+    for (StringInterner::Id id : structOrder) {
+        const StructInfo& info = structs.at(id);
+        auto fieldIt = info.fieldIndices.find(field);
+        if (fieldIt != info.fieldIndices.end()) {
+            return {info.type, fieldIt->second};
+        }
+    }
+    return {nullptr, -1};
+}
+
+void CodeGen::registerStructMethod(const std::string& structName, const std::string& methodName,
+                                   llvm::Function* function) {
+    structs[symbolNames.intern(structName)].methods[symbolNames.intern(methodName)] = function;
+}
+
+llvm::Function* CodeGen::getStructMethod(const std::string& structName, const std::string& methodName) const {
+    const StructInfo* info = findStruct(structName);
+    if (!info) {
+        return nullptr;
+    }
+    auto methodIt = info->methods.find(symbolNames.find(methodName));
+    return methodIt == info->methods.end() ? nullptr : methodIt->second;
 }
 
 /* Create builtin functions */
@@ -271,6 +260,10 @@ llvm::Value* CodeGen::codegen(WhileStmt& stmt) {
 llvm::Value* CodeGen::codegen(ForLoopStmt& stmt) {
     return StatementCodeGen::codegenForLoopStmt(*this, stmt);
 }
+/* @entrypoint only marks the next function; Program::setEntryPointFunction records it */
+llvm::Value* CodeGen::codegen(EntrypointStmt&) {
+    return nullptr;
+}
 
 llvm::Value* CodeGen::codegen(AST::ModuleExpr& expr) {
     return ExpressionCodeGen::codegenModule(*this, expr);
@@ -309,22 +302,25 @@ llvm::Value* CodeGen::codegen(AST::MemberAssignmentStmt& stmt) {
 }
 
 void CodeGen::registerModuleAlias(const std::string& alias, const std::string& actualModuleName, llvm::Value* moduleValue) {
-    moduleAliases[alias] = actualModuleName;
-    moduleReferences[alias] = moduleValue;
-    moduleIdentities[alias] = actualModuleName;
+    StringInterner::Id aliasId = symbolNames.intern(alias);
+    StringInterner::Id moduleId = symbolNames.intern(actualModuleName);
+    moduleAliases[aliasId] = moduleId;
+    moduleReferences[aliasId] = moduleValue;
+    moduleIdentities[aliasId] = moduleId;
     
-    std::cout << "DEBUG: Registered module alias: " << alias << " -> " << actualModuleName << std::endl;
+    SUMMIT_TRACE(Module, Info, "Registered module alias: " << alias << " -> " << actualModuleName);
 }
 
 std::string CodeGen::resolveModuleAlias(const std::string& name) const {
-    auto aliasIt = moduleAliases.find(name);
+    StringInterner::Id id = symbolNames.find(name);
+    auto aliasIt = moduleAliases.find(id);
     if (aliasIt != moduleAliases.end()) {
-        return aliasIt->second;
+        return std::string(symbolNames.text(aliasIt->second));
     }
     
-    auto identityIt = moduleIdentities.find(name);
+    auto identityIt = moduleIdentities.find(id);
     if (identityIt != moduleIdentities.end()) {
-        return identityIt->second;
+        return std::string(symbolNames.text(identityIt->second));
     }
     
     return "";
@@ -341,13 +337,154 @@ void CodeGen::printIRToFile(const std::string& filename) {
     if (EC) throw std::runtime_error("Could not open file: " + filename);
     llvmModule->print(out, nullptr);
 }
-bool CodeGen::compileToExecutable(const std::string& outputFilename, bool verbose, const std::string& targetTriple, bool noStdlib) {
-    llvm::InitializeAllTargetInfos();
-    llvm::InitializeAllTargets();
-    llvm::InitializeAllTargetMCs();
-    llvm::InitializeAllAsmParsers();
-    llvm::InitializeAllAsmPrinters();
 
+/* Map driver opt level to the backend codegen level */
+static llvm::CodeGenOptLevel toCodeGenOptLevel(OptLevel level) {
+    switch (level) {
+        case OptLevel::O0: return llvm::CodeGenOptLevel::None;
+        case OptLevel::O1: return llvm::CodeGenOptLevel::Less;
+        case OptLevel::O3: return llvm::CodeGenOptLevel::Aggressive;
+        case OptLevel::O2:
+        case OptLevel::Os:
+        default: return llvm::CodeGenOptLevel::Default;
+    }
+}
+
+/* Map driver opt level to the new pass manager pipeline level */
+static llvm::OptimizationLevel toPipelineLevel(OptLevel level) {
+    switch (level) {
+        case OptLevel::O1: return llvm::OptimizationLevel::O1;
+        case OptLevel::O2: return llvm::OptimizationLevel::O2;
+        case OptLevel::O3: return llvm::OptimizationLevel::O3;
+        case OptLevel::Os: return llvm::OptimizationLevel::Os;
+        case OptLevel::O0:
+        default: return llvm::OptimizationLevel::O0;
+    }
+}
+
+/* Run the default per-module optimization pipeline for the given level */
+static void runOptimizationPipeline(llvm::Module& module, llvm::TargetMachine* targetMachine, OptLevel level) {
+    llvm::LoopAnalysisManager LAM;
+    llvm::FunctionAnalysisManager FAM;
+    llvm::CGSCCAnalysisManager CGAM;
+    llvm::ModuleAnalysisManager MAM;
+
+    llvm::PassBuilder PB(targetMachine);
+    PB.registerModuleAnalyses(MAM);
+    PB.registerCGSCCAnalyses(CGAM);
+    PB.registerFunctionAnalyses(FAM);
+    PB.registerLoopAnalyses(LAM);
+    PB.crossRegisterProxies(LAM, FAM, CGAM, MAM);
+
+    llvm::OptimizationLevel pipelineLevel = toPipelineLevel(level);
+    llvm::ModulePassManager MPM = (pipelineLevel == llvm::OptimizationLevel::O0)
+        ? PB.buildO0DefaultPipeline(pipelineLevel)
+        : PB.buildPerModuleDefaultPipeline(pipelineLevel);
+    MPM.run(module, MAM);
+}
+
+/* Idle TargetMachines by configuration; a machine is used by one compile at a time,
+   but batch builds and --server reuse them instead of creating one per module */
+namespace {
+class TargetMachinePool {
+    std::mutex mutex;
+    std::map<std::string, std::vector<std::unique_ptr<llvm::TargetMachine>>> idle;
+
+public:
+    static TargetMachinePool& get() {
+        static TargetMachinePool pool;
+        return pool;
+    }
+
+    std::unique_ptr<llvm::TargetMachine> acquire(const std::string& key) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = idle.find(key);
+        if (it == idle.end() || it->second.empty()) return nullptr;
+        auto machine = std::move(it->second.back());
+        it->second.pop_back();
+        return machine;
+    }
+
+    void release(const std::string& key, std::unique_ptr<llvm::TargetMachine> machine) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto& machines = idle[key];
+        if (machines.size() < std::max(1u, std::thread::hardware_concurrency())) {
+            machines.push_back(std::move(machine));
+        }
+    }
+};
+
+/* Returns its machine to the pool when the compile finishes */
+struct TargetMachineLease {
+    std::string key;
+    std::unique_ptr<llvm::TargetMachine> machine;
+
+    ~TargetMachineLease() {
+        if (machine) TargetMachinePool::get().release(key, std::move(machine));
+    }
+};
+}
+
+/* Flag spelling of an opt level, for verbose output */
+static const char* optLevelName(OptLevel level) {
+    switch (level) {
+        case OptLevel::O0: return "-O0";
+        case OptLevel::O1: return "-O1";
+        case OptLevel::O2: return "-O2";
+        case OptLevel::O3: return "-O3";
+        case OptLevel::Os: return "-Os";
+    }
+    return "-O0";
+}
+
+/* Resolve "native" to the host CPU and merge host features with explicit ones */
+void CodeGen::resolveCpuAndFeatures(const CompileOptions& options, std::string& cpu, std::string& features) {
+    cpu = options.cpu.empty() ? "generic" : options.cpu;
+    features.clear();
+
+    if (cpu == "native") {
+        /* Host CPU names and features only mean something for the host's architecture */
+        if (!options.targetTriple.empty()) {
+            llvm::Triple target(llvm::Triple::normalize(options.targetTriple));
+            llvm::Triple host(llvm::sys::getProcessTriple());
+            if (target.getArch() != host.getArch()) {
+                throw std::runtime_error("-march=native cannot be used with --target " + options.targetTriple +
+                                         " (host is " + host.str() + ")");
+            }
+        }
+        cpu = llvm::sys::getHostCPUName().str();
+
+        llvm::SubtargetFeatures hostFeatures;
+        llvm::StringMap<bool> featureMap;
+        if (llvm::sys::getHostCPUFeatures(featureMap)) {
+            for (auto& feature : featureMap) {
+                hostFeatures.AddFeature(feature.first(), feature.second);
+            }
+        }
+        features = hostFeatures.getString();
+    }
+
+    /* Explicit --features come last so they override detected ones */
+    if (!options.features.empty()) {
+        if (!features.empty()) features += ",";
+        features += options.features;
+    }
+}
+
+/* Register every LLVM target exactly once per process, safe to call from any thread */
+void CodeGen::initializeTargets() {
+    static std::once_flag targetsInitialized;
+    std::call_once(targetsInitialized, []() {
+        llvm::InitializeAllTargetInfos();
+        llvm::InitializeAllTargets();
+        llvm::InitializeAllTargetMCs();
+        llvm::InitializeAllAsmParsers();
+        llvm::InitializeAllAsmPrinters();
+    });
+}
+
+/* Default target triple for the host platform when none is given */
+std::string CodeGen::resolveTargetTriple(const std::string& targetTriple) {
     std::string triple = targetTriple;
     if (triple.empty()) {
 #if defined(_WIN32)
@@ -359,10 +496,171 @@ bool CodeGen::compileToExecutable(const std::string& outputFilename, bool verbos
 #endif
     }
 
+    return triple;
+}
+
+/* Locate libsummit via SUMMIT_LIB or the default search paths; dllPath is set for shared builds */
+std::string CodeGen::findStandardLibrary(const std::string& triple, std::string& dllPath) {
+    bool isWindows = (triple.find("windows") != std::string::npos ||
+                      triple.find("mingw") != std::string::npos ||
+                      triple.find("win32") != std::string::npos);
+    bool isLinux = (triple.find("linux") != std::string::npos);
+    bool isMac = (triple.find("darwin") != std::string::npos || triple.find("apple") != std::string::npos);
+
+    std::string stdlibPath;
+    const char* envLib = std::getenv("SUMMIT_LIB");
+    if (envLib) {
+        std::filesystem::path libPath(envLib);
+        if (std::filesystem::is_directory(libPath)) {
+            if (isWindows) {
+                std::vector<std::string> winLibNames = {"libsummit.lib", "libsummit.a"};
+                for (const auto& libName : winLibNames) {
+                    std::filesystem::path fullPath = libPath / libName;
+                    if (std::filesystem::exists(fullPath)) { stdlibPath = fullPath.string(); break; }
+                }
+                std::vector<std::string> winDllNames = {"libsummit.dll", "libsummit.dll"};
+                for (const auto& dllName : winDllNames) {
+                    std::filesystem::path fullDllPath = libPath / dllName;
+                    if (std::filesystem::exists(fullDllPath)) { dllPath = fullDllPath.string(); break; }
+                }
+            } else {
+                std::vector<std::string> unixLibNames = {"libsummit.a", "libsummit.so", "libsummit.dylib"};
+                for (const auto& libName : unixLibNames) {
+                    std::filesystem::path fullPath = libPath / libName;
+                    if (std::filesystem::exists(fullPath)) {
+                        stdlibPath = fullPath.string();
+                        if (libName.find(".so") != std::string::npos || libName.find(".dylib") != std::string::npos)
+                            dllPath = stdlibPath;
+                        break;
+                    }
+                }
+            }
+        } else if (std::filesystem::exists(libPath)) {
+            stdlibPath = envLib;
+            std::string ext = libPath.extension().string();
+            if (ext == ".dll" || ext == ".so" || ext == ".dylib") dllPath = envLib;
+        }
+    }
+    
+    if (stdlibPath.empty()) {
+        std::vector<std::string> searchPaths = {
+            "./lib",
+            "/usr/local/lib",
+            "/usr/lib",
+            "/lib"
+        };
+        
+        std::vector<std::string> libNames;
+        if (isWindows) {
+            libNames = {"libsummit.lib", "libsummit.a"};
+        } else if (isLinux) {
+            libNames = {"libsummit.so", "libsummit.a"};
+        } else if (isMac) {
+            libNames = {"libsummit.dylib", "libsummit.a"};
+        } else {
+            libNames = {"libsummit.a", "libsummit.so", "libsummit.dylib"};
+        }
+        
+        for (const auto& searchPath : searchPaths) {
+            for (const auto& libName : libNames) {
+                std::filesystem::path fullPath = std::filesystem::path(searchPath) / libName;
+                if (std::filesystem::exists(fullPath)) {
+                    stdlibPath = fullPath.string();
+                    std::string ext = fullPath.extension().string();
+                    if (ext == ".so" || ext == ".dylib") dllPath = stdlibPath;
+                    break;
+                }
+            }
+            if (!stdlibPath.empty()) break;
+        }
+    }
+    return stdlibPath;
+}
+
+/* libsummit.bc from $SUMMIT_RUNTIME_BC or next to libsummit; empty when not installed */
+std::string CodeGen::findRuntimeBitcode(const std::string& triple) {
+    if (const char* envBitcode = std::getenv("SUMMIT_RUNTIME_BC")) {
+        if (std::filesystem::exists(envBitcode)) return envBitcode;
+    }
+
+    std::string dllPath;
+    std::string stdlibPath = findStandardLibrary(triple, dllPath);
+    std::filesystem::path libDir = stdlibPath.empty()
+        ? std::filesystem::path("./lib")
+        : std::filesystem::path(stdlibPath).parent_path();
+    std::filesystem::path bitcodePath = libDir / "libsummit.bc";
+    return std::filesystem::exists(bitcodePath) ? bitcodePath.string() : "";
+}
+
+/* Link the runtime bitcode into the module so calls into it can be inlined */
+bool CodeGen::linkRuntimeBitcode(const std::string& triple, bool verbose) {
+    std::string path = findRuntimeBitcode(triple);
+    if (path.empty()) {
+        if (verbose) std::cerr << "Runtime bitcode: not found, calling libsummit externally" << std::endl;
+        return false;
+    }
+
+    auto buffer = llvm::MemoryBuffer::getFile(path);
+    if (!buffer) {
+        if (verbose) std::cerr << "Runtime bitcode: cannot read " << path << std::endl;
+        return false;
+    }
+
+    auto runtime = llvm::parseBitcodeFile((*buffer)->getMemBufferRef(), *llvmContext);
+    if (!runtime) {
+        std::string message = llvm::toString(runtime.takeError());
+        if (verbose) std::cerr << "Runtime bitcode: " << message << std::endl;
+        return false;
+    }
+
+    llvm::Triple runtimeTriple((*runtime)->getTargetTriple());
+    llvm::Triple moduleTriple(triple);
+    if (runtimeTriple.getArch() != moduleTriple.getArch() || runtimeTriple.getOS() != moduleTriple.getOS()) {
+        if (verbose) std::cerr << "Runtime bitcode: built for " << runtimeTriple.str() << ", skipping" << std::endl;
+        return false;
+    }
+
+    /* Let runtime functions inherit the CPU/features chosen for this build */
+    for (auto& function : **runtime) {
+        function.removeFnAttr("target-cpu");
+        function.removeFnAttr("target-features");
+        function.removeFnAttr("tune-cpu");
+    }
+    (*runtime)->setTargetTriple(llvmModule->getTargetTriple());
+    (*runtime)->setDataLayout(llvmModule->getDataLayout());
+
+    /* Only pull in what the program references, and make it internal so unused copies are dropped */
+    bool failed = llvm::Linker::linkModules(
+        *llvmModule, std::move(*runtime), llvm::Linker::Flags::LinkOnlyNeeded,
+        [](llvm::Module& module, const llvm::StringSet<>& linkedNames) {
+            llvm::internalizeModule(module, [&linkedNames](const llvm::GlobalValue& value) {
+                return !value.hasName() || !linkedNames.count(value.getName());
+            });
+        });
+    if (failed) {
+        std::cerr << "Warning: failed to link runtime bitcode " << path << std::endl;
+        return false;
+    }
+
+    if (verbose) std::cerr << "Linked runtime bitcode: " << path << std::endl;
+    return true;
+}
+
+/* Optimize the module and emit a relocatable object into objBuffer */
+bool CodeGen::emitObject(llvm::SmallVectorImpl<char>& objBuffer, const CompileOptions& options) {
+    const std::string& targetTriple = options.targetTriple;
+    bool verbose = options.verbose;
+    bool noStdlib = options.noStdlib;
+    OptLevel optLevel = options.optLevel;
+
+    initializeTargets();
+
+    std::string triple = resolveTargetTriple(targetTriple);
     llvmModule->setTargetTriple(triple);
 
     if (verbose) {
         std::cerr << "Target triple: " << triple << std::endl;
+        std::cerr << "Optimization level: " << optLevelName(optLevel) << std::endl;
         if (noStdlib) std::cerr << "Standard library: disabled" << std::endl;
     }
 
@@ -373,20 +671,45 @@ bool CodeGen::compileToExecutable(const std::string& outputFilename, bool verbos
         return false;
     }
 
-    auto cpu = "generic";
-    auto features = "";
-    llvm::TargetOptions opt;
-    auto targetMachine = target->createTargetMachine(triple, cpu, features, opt, llvm::Reloc::PIC_);
+    std::string cpu, features;
+    resolveCpuAndFeatures(options, cpu, features);
+
+    if (verbose) {
+        std::cerr << "CPU: " << cpu << std::endl;
+        std::cerr << "Features: " << (features.empty() ? "(none)" : features) << std::endl;
+    }
+
+    TargetMachineLease lease;
+    lease.key = triple + "|" + cpu + "|" + features + "|" + optLevelName(optLevel);
+    lease.machine = TargetMachinePool::get().acquire(lease.key);
+    if (!lease.machine) {
+        llvm::TargetOptions opt;
+        lease.machine.reset(target->createTargetMachine(triple, cpu, features, opt, llvm::Reloc::PIC_,
+                                                        std::nullopt, toCodeGenOptLevel(optLevel)));
+    } else if (verbose) {
+        std::cerr << "Reusing cached target machine" << std::endl;
+    }
+    llvm::TargetMachine* targetMachine = lease.machine.get();
     llvmModule->setDataLayout(targetMachine->createDataLayout());
 
-    std::string objFilename = outputFilename + ".o";
-    std::error_code EC;
-    llvm::raw_fd_ostream dest(objFilename, EC, llvm::sys::fs::OF_None);
-    if (EC) {
-        std::cerr << "Could not open file: " << EC.message() << std::endl;
-        return false;
+    TimeReport::Scope optimizePhase(options.timeReport, "optimize");
+    if (!noStdlib && options.linkRuntimeBitcode) {
+        linkRuntimeBitcode(triple, verbose);
     }
 
+    runOptimizationPipeline(*llvmModule, targetMachine, optLevel);
+    optimizePhase.stop();
+
+    if (options.timeReport) {
+        uint64_t functions = 0, instructions = 0;
+        countIR(*llvmModule, functions, instructions);
+        options.timeReport->setCounter("ir_functions_optimized", functions);
+        options.timeReport->setCounter("ir_instructions_optimized", instructions);
+    }
+
+    TimeReport::Scope emitPhase(options.timeReport, "emit");
+    llvm::raw_svector_ostream dest(objBuffer);
+
     llvm::legacy::PassManager pass;
     auto fileType = llvm::CodeGenFileType::ObjectFile;
     if (targetMachine->addPassesToEmitFile(pass, dest, nullptr, fileType)) {
@@ -395,9 +718,20 @@ bool CodeGen::compileToExecutable(const std::string& outputFilename, bool verbos
     }
 
     pass.run(*llvmModule);
-    dest.flush();
+    emitPhase.stop();
 
-    if (verbose) std::cerr << "Generated object file: " << objFilename << std::endl;
+    if (options.timeReport) options.timeReport->setCounter("object_bytes", objBuffer.size());
+    if (verbose) std::cerr << "Generated object: " << objBuffer.size() << " bytes" << std::endl;
+
+    return true;
+}
+
+/* Link an emitted object with libsummit into the final executable */
+bool CodeGen::linkObject(llvm::ArrayRef<char> objBuffer, const std::string& outputFilename, const CompileOptions& options) {
+    bool verbose = options.verbose;
+    bool noStdlib = options.noStdlib;
+    std::string triple = resolveTargetTriple(options.targetTriple);
+    std::string objFilename = outputFilename + ".o";
 
     bool isWindows = (triple.find("windows") != std::string::npos ||
                       triple.find("mingw") != std::string::npos ||
@@ -409,73 +743,7 @@ bool CodeGen::compileToExecutable(const std::string& outputFilename, bool verbos
     bool useStdlib = !noStdlib;
 
     if (useStdlib) {
-        const char* envLib = std::getenv("SUMMIT_LIB");
-        if (envLib) {
-            std::filesystem::path libPath(envLib);
-            if (std::filesystem::is_directory(libPath)) {
-                if (isWindows) {
-                    std::vector<std::string> winLibNames = {"libsummit.lib", "libsummit.a"};
-                    for (const auto& libName : winLibNames) {
-                        std::filesystem::path fullPath = libPath / libName;
-                        if (std::filesystem::exists(fullPath)) { stdlibPath = fullPath.string(); break; }
-                    }
-                    std::vector<std::string> winDllNames = {"libsummit.dll", "libsummit.dll"};
-                    for (const auto& dllName : winDllNames) {
-                        std::filesystem::path fullDllPath = libPath / dllName;
-                        if (std::filesystem::exists(fullDllPath)) { dllPath = fullDllPath.string(); break; }
-                    }
-                } else {
-                    std::vector<std::string> unixLibNames = {"libsummit.a", "libsummit.so", "libsummit.dylib"};
-                    for (const auto& libName : unixLibNames) {
-                        std::filesystem::path fullPath = libPath / libName;
-                        if (std::filesystem::exists(fullPath)) {
-                            stdlibPath = fullPath.string();
-                            if (libName.find(".so") != std::string::npos || libName.find(".dylib") != std::string::npos)
-                                dllPath = stdlibPath;
-                            break;
-                        }
-                    }
-                }
-            } else if (std::filesystem::exists(libPath)) {
-                stdlibPath = envLib;
-                std::string ext = libPath.extension().string();
-                if (ext == ".dll" || ext == ".so" || ext == ".dylib") dllPath = envLib;
-            }
-        }
-        
-        if (stdlibPath.empty()) {
-            std::vector<std::string> searchPaths = {
-                "./lib",
-                "/usr/local/lib",
-                "/usr/lib",
-                "/lib"
-            };
-            
-            std::vector<std::string> libNames;
-            if (isWindows) {
-                libNames = {"libsummit.lib", "libsummit.a"};
-            } else if (isLinux) {
-                libNames = {"libsummit.so", "libsummit.a"};
-            } else if (isMac) {
-                libNames = {"libsummit.dylib", "libsummit.a"};
-            } else {
-                libNames = {"libsummit.a", "libsummit.so", "libsummit.dylib"};
-            }
-            
-            for (const auto& searchPath : searchPaths) {
-                for (const auto& libName : libNames) {
-                    std::filesystem::path fullPath = std::filesystem::path(searchPath) / libName;
-                    if (std::filesystem::exists(fullPath)) {
-                        stdlibPath = fullPath.string();
-                        std::string ext = fullPath.extension().string();
-                        if (ext == ".so" || ext == ".dylib") dllPath = stdlibPath;
-                        break;
-                    }
-                }
-                if (!stdlibPath.empty()) break;
-            }
-        }
-        
+        stdlibPath = findStandardLibrary(triple, dllPath);
         if (stdlibPath.empty()) {
             std::cerr << "Warning: Standard library not found.\n";
             std::cerr << "Set SUMMIT_LIB to point to the library directory or specific library file.\n";
@@ -490,8 +758,40 @@ bool CodeGen::compileToExecutable(const std::string& outputFilename, bool verbos
 
     std::string linkCmd;
     int result = 0;
+    bool linkedInProcess = false;
+    auto linkStart = std::chrono::steady_clock::now();
+    TimeReport::Scope linkPhase(options.timeReport, "link");
+
+    if (isLinux && !options.externalLinker) {
+        std::string linkError;
+        auto status = LldLinker::linkExecutable(objBuffer, outputFilename, triple, stdlibPath, verbose, linkError);
+        if (status == LldLinker::LinkStatus::Linked) {
+            linkedInProcess = true;
+            std::cout << "Successfully created executable: " << outputFilename << std::endl;
+        } else if (status == LldLinker::LinkStatus::Failed) {
+            linkedInProcess = true;
+            std::cerr << linkError;
+            result = 1;
+        } else if (verbose) {
+            std::cerr << "In-process linker unavailable (" << linkError << "), using external linker" << std::endl;
+        }
+    }
+
+    if (!linkedInProcess) {
+        std::error_code EC;
+        llvm::raw_fd_ostream objFile(objFilename, EC, llvm::sys::fs::OF_None);
+        if (EC) {
+            std::cerr << "Could not open file: " << EC.message() << std::endl;
+            return false;
+        }
+        objFile.write(objBuffer.data(), objBuffer.size());
+        objFile.close();
+        if (verbose) std::cerr << "Generated object file: " << objFilename << std::endl;
+    }
 
-    if (isWindows) {
+    if (linkedInProcess) {
+        /* Already linked by lld */
+    } else if (isWindows) {
         std::string exeName = outputFilename;
         if (exeName.length() < 4 || exeName.substr(exeName.length()-4) != ".exe") 
             exeName += ".exe";
@@ -604,7 +904,7 @@ std::string wrapperSource =
     "    return result;\n"
     "}\n";
 
-        std::string wrapperFile = "console_wrapper.cpp";
+        std::string wrapperFile = outputFilename + "_console_wrapper.cpp";
         std::ofstream outFile(wrapperFile);
         if (!outFile) {
             std::cerr << "Error: Could not create console wrapper file" << std::endl;
@@ -614,7 +914,7 @@ std::string wrapperSource =
         outFile << wrapperSource;
         outFile.close();
 
-        std::string wrapperObj = "console_wrapper.o";
+        std::string wrapperObj = outputFilename + "_console_wrapper.o";
         std::string compileWrapperCmd = "g++ -c \"" + wrapperFile + "\" -o \"" + wrapperObj + "\"";
         if (verbose) std::cerr << "Compiling wrapper: " << compileWrapperCmd << std::endl;
         int compileResult = std::system(compileWrapperCmd.c_str());
@@ -707,7 +1007,13 @@ std::string wrapperSource =
             std::cout << "Successfully created executable: " << outputFilename << std::endl;
         }
     }
-    std::remove(objFilename.c_str());
+    if (!linkedInProcess) std::remove(objFilename.c_str());
+    linkPhase.stop();
+
+    if (verbose) {
+        auto linkMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - linkStart).count();
+        std::cerr << "Link time (" << (linkedInProcess ? "lld" : "external") << "): " << linkMs << " ms" << std::endl;
+    }
 
     if (result != 0) {
         std::cerr << "Linking failed" << std::endl;
@@ -717,12 +1023,126 @@ std::string wrapperSource =
     return true;
 }
 
+void CodeGen::countIR(const llvm::Module& module, uint64_t& functions, uint64_t& instructions) {
+    functions = 0;
+    instructions = 0;
+    for (const auto& function : module) {
+        if (function.isDeclaration()) continue;
+        ++functions;
+        instructions += function.getInstructionCount();
+    }
+}
+
+bool CodeGen::compileToExecutable(const std::string& outputFilename, const CompileOptions& options) {
+    llvm::SmallVector<char, 0> objBuffer;
+    if (!emitObject(objBuffer, options)) {
+        return false;
+    }
+    return linkObject(objBuffer, outputFilename, options);
+}
+
+/* Run the program through ORC LLJIT, skipping object emission and linking */
+int CodeGen::runJIT(const CompileOptions& options) {
+    llvm::InitializeNativeTarget();
+    llvm::InitializeNativeTargetAsmPrinter();
+    llvm::InitializeNativeTargetAsmParser();
+
+    auto jitTargetBuilder = llvm::orc::JITTargetMachineBuilder::detectHost();
+    if (!jitTargetBuilder) {
+        throw std::runtime_error("JIT: " + llvm::toString(jitTargetBuilder.takeError()));
+    }
+
+    if (!options.cpu.empty()) {
+        std::string cpu, features;
+        resolveCpuAndFeatures(options, cpu, features);
+        jitTargetBuilder->setCPU(cpu);
+        jitTargetBuilder->getFeatures() = llvm::SubtargetFeatures(features);
+    } else if (!options.features.empty()) {
+        llvm::SubtargetFeatures extra(options.features);
+        jitTargetBuilder->getFeatures().addFeaturesVector(extra.getFeatures());
+    }
+    jitTargetBuilder->setCodeGenOptLevel(toCodeGenOptLevel(options.optLevel));
+
+    if (options.verbose) {
+        std::cerr << "JIT target: " << jitTargetBuilder->getTargetTriple().str() << std::endl;
+        std::cerr << "CPU: " << jitTargetBuilder->getCPU() << std::endl;
+        std::cerr << "Optimization level: " << optLevelName(options.optLevel) << std::endl;
+    }
+
+    auto targetMachine = jitTargetBuilder->createTargetMachine();
+    if (!targetMachine) {
+        throw std::runtime_error("JIT: " + llvm::toString(targetMachine.takeError()));
+    }
+    llvmModule->setTargetTriple(jitTargetBuilder->getTargetTriple().str());
+    llvmModule->setDataLayout((*targetMachine)->createDataLayout());
+    TimeReport::Scope optimizePhase(options.timeReport, "optimize");
+    if (!options.noStdlib && options.linkRuntimeBitcode) {
+        linkRuntimeBitcode(llvmModule->getTargetTriple(), options.verbose);
+    }
+    runOptimizationPipeline(*llvmModule, targetMachine->get(), options.optLevel);
+    optimizePhase.stop();
+
+    TimeReport::Scope jitPhase(options.timeReport, "jit");
+
+    auto jit = llvm::orc::LLJITBuilder()
+        .setJITTargetMachineBuilder(std::move(*jitTargetBuilder))
+        .create();
+    if (!jit) {
+        throw std::runtime_error("JIT: " + llvm::toString(jit.takeError()));
+    }
+    auto& mainDylib = (*jit)->getMainJITDylib();
+
+    /* Runtime functions come from the copy of the C runtime in stdlib/ linked into the compiler */
+    if (!options.noStdlib) {
+        llvm::orc::SymbolMap runtime;
+        for (const auto& [name, address] : RuntimeSymbols::getAll()) {
+            runtime[(*jit)->mangleAndIntern(name)] = llvm::orc::ExecutorSymbolDef(
+                llvm::orc::ExecutorAddr::fromPtr(address),
+                llvm::JITSymbolFlags::Exported | llvm::JITSymbolFlags::Callable);
+        }
+        if (auto err = mainDylib.define(llvm::orc::absoluteSymbols(std::move(runtime)))) {
+            throw std::runtime_error("JIT: " + llvm::toString(std::move(err)));
+        }
+    }
+
+    /* libc (printf, malloc, exit, stderr, ...) resolves against the compiler process */
+    auto processSymbols = llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(
+        (*jit)->getDataLayout().getGlobalPrefix());
+    if (!processSymbols) {
+        throw std::runtime_error("JIT: " + llvm::toString(processSymbols.takeError()));
+    }
+    mainDylib.addGenerator(std::move(*processSymbols));
+
+    irBuilder.reset();
+    llvm::orc::ThreadSafeModule threadSafeModule(std::move(llvmModule), std::move(llvmContext));
+    if (auto err = (*jit)->addIRModule(std::move(threadSafeModule))) {
+        throw std::runtime_error("JIT: " + llvm::toString(std::move(err)));
+    }
+    if (auto err = (*jit)->initialize(mainDylib)) {
+        throw std::runtime_error("JIT: " + llvm::toString(std::move(err)));
+    }
+
+    auto mainAddr = (*jit)->lookup("main");
+    if (!mainAddr) {
+        throw std::runtime_error("JIT: " + llvm::toString(mainAddr.takeError()));
+    }
+
+    jitPhase.stop();
+
+    std::cout.flush();
+    auto mainFn = mainAddr->toPtr<int (*)()>();
+    int exitCode = mainFn();
+    std::fflush(stdout);
+
+    if (auto err = (*jit)->deinitialize(mainDylib)) {
+        llvm::consumeError(std::move(err));
+    }
+    return exitCode;
+}
+
 const std::vector<std::pair<std::string, AST::VarType>>& CodeGen::getStructFields(const std::string& structName) const {
     static std::vector<std::pair<std::string, AST::VarType>> empty;
     
-    auto it = structFields_.find(structName);
-    if (it != structFields_.end()) {
-        return it->second;
-    }
-    return empty;
+    const StructInfo* info = findStruct(structName);
+    return info ? info->fields : empty;
 }
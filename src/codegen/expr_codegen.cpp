@@ -1,7 +1,7 @@
 #include "expr_codegen.h"
 #include "type_inference.h"
 #include "string_conversions.h"
-#include "format_utils.h"
+#include "ast/semantic_analyzer.h"
 #include "codegen/bounds.h"
 #include "stdlib/core/stdlib_manager.h"
 
@@ -44,6 +44,15 @@ llvm::Value* ExpressionCodeGen::codegenString(CodeGen& context, StringExpr& expr
 
 llvm::Value* ExpressionCodeGen::codegenNumber(CodeGen& context, NumberExpr& expr) {
     const BigInt& value = expr.getValue();
+    if (value.fitsInInt64()) {
+        /* SemanticAnalyzer only gives a literal an integer type it fits */
+        VarType type = expr.getResolvedType();
+        if (TypeBounds::isIntegerType(type) && type != VarType::INT64) {
+            return ConstantInt::get(context.getLLVMType(type), value.toInt64(), !TypeBounds::isUnsignedType(type));
+        }
+        return ConstantInt::get(context.getContext(), APInt(64, value.toInt64(), true));
+    }
+
     std::string strValue = value.toString();
    
     bool isNegative = false;
@@ -133,26 +142,26 @@ llvm::Value* ExpressionCodeGen::codegenFloat(CodeGen& context, FloatExpr& expr)
 llvm::Value* ExpressionCodeGen::codegenVariable(CodeGen& context, VariableExpr& expr) {
     std::string name = expr.getName();
     
-    std::cout << "DEBUG codegenVariable: Looking for variable '" << name << "'" << std::endl;
+    SUMMIT_TRACE(Var, Detail, "codegenVariable: Looking for variable '" << name << "'");
     
     auto var = context.lookupVariable(name);
     if (!var) {
         throw std::runtime_error("Unknown variable: " + name);
     }
     
-    std::cout << "DEBUG codegenVariable: Found variable '" << name << "' with value " << var << std::endl;
+    SUMMIT_TRACE(Var, Detail, "codegenVariable: Found variable '" << name << "' with value " << var);
     
     VarType varType = context.lookupVariableType(name);
-    std::cout << "DEBUG codegenVariable: Variable type = " << static_cast<int>(varType) << std::endl;
+    SUMMIT_TRACE(Var, Detail, "codegenVariable: Variable type = " << static_cast<int>(varType));
 
     if (varType == VarType::MODULE) {
-        std::cout << "DEBUG codegenVariable: Returning module reference without loading for: " << name << std::endl;
+        SUMMIT_TRACE(Var, Detail, "codegenVariable: Returning module reference without loading for: " << name);
         return var;
     }
     
     auto& builder = context.getBuilder();
     
-    std::cout << "DEBUG codegenVariable: Loading value from pointer for: " << name << std::endl;
+    SUMMIT_TRACE(Var, Detail, "codegenVariable: Loading value from pointer for: " << name);
     
     llvm::Type* pointedType = nullptr;
     if (auto* allocaInst = llvm::dyn_cast<llvm::AllocaInst>(var)) {
@@ -161,12 +170,7 @@ llvm::Value* ExpressionCodeGen::codegenVariable(CodeGen& context, VariableExpr&
         pointedType = globalVar->getValueType();
     }
     
-    if (pointedType) {
-        std::string typeStr;
-        llvm::raw_string_ostream rso(typeStr);
-        pointedType->print(rso);
-        std::cout << "DEBUG codegenVariable: Pointed type = " << rso.str() << std::endl;
-    }
+    SUMMIT_TRACE(Var, Detail, "codegenVariable: Pointed type = " << Trace::printed(pointedType));
     
     if (!pointedType) {
         throw std::runtime_error("Unable to determine type for variable: " + name);
@@ -228,6 +232,8 @@ llvm::Value* ExpressionCodeGen::codegenBinary(CodeGen& context, BinaryExpr& expr
     auto lhs = expr.getLHS()->codegen(context);
     auto rhs = expr.getRHS()->codegen(context);
     auto& builder = context.getBuilder();
+    VarType lhsType = AST::resolvedSourceType(*expr.getLHS(), lhs);
+    VarType rhsType = AST::resolvedSourceType(*expr.getRHS(), rhs);
 
     if (expr.getOp() == BinaryOp::ADD) {
         bool lhsIsString = lhs->getType()->isPointerTy();
@@ -333,7 +339,8 @@ llvm::Value* ExpressionCodeGen::codegenBinary(CodeGen& context, BinaryExpr& expr
         }
 
         if (lhs->getType()->isIntegerTy()) {
-            lhs = builder.CreateSIToFP(lhs, resultType);
+            lhs = TypeBounds::isUnsignedType(lhsType) ? builder.CreateUIToFP(lhs, resultType)
+                                                      : builder.CreateSIToFP(lhs, resultType);
         } else if (lhs->getType() != resultType) {
             if (lhs->getType()->isFloatTy() && resultType->isDoubleTy()) {
                 lhs = builder.CreateFPExt(lhs, resultType);
@@ -341,7 +348,8 @@ llvm::Value* ExpressionCodeGen::codegenBinary(CodeGen& context, BinaryExpr& expr
         }
         
         if (rhs->getType()->isIntegerTy()) {
-            rhs = builder.CreateSIToFP(rhs, resultType);
+            rhs = TypeBounds::isUnsignedType(rhsType) ? builder.CreateUIToFP(rhs, resultType)
+                                                      : builder.CreateSIToFP(rhs, resultType);
         } else if (rhs->getType() != resultType) {
             if (rhs->getType()->isFloatTy() && resultType->isDoubleTy()) {
                 rhs = builder.CreateFPExt(rhs, resultType);
@@ -386,6 +394,7 @@ llvm::Value* ExpressionCodeGen::codegenBinary(CodeGen& context, BinaryExpr& expr
                     
                     lhs = builder.CreateFPToSI(lhs, Type::getInt64Ty(context.getContext()));
                     rhs = builder.CreateFPToSI(rhs, Type::getInt64Ty(context.getContext()));
+                    lhsType = rhsType = VarType::INT64;
                 } else {
                     throw std::runtime_error("Unknown binary operator for floats");
                 }
@@ -412,28 +421,60 @@ llvm::Value* ExpressionCodeGen::codegenBinary(CodeGen& context, BinaryExpr& expr
         }
     }
 
-    if (lhs->getType() != rhs->getType()) {
+    /* Both operands are converted to their common type, whose signedness picks the
+       instruction; operands without a resolved type meet at the wider width, signed */
+    VarType operationType = AST::commonOperandType(lhsType, rhsType);
+    if (TypeBounds::isIntegerType(operationType)) {
+        /* Arithmetic headed for a wider integer was typed at that width by SemanticAnalyzer */
+        if (TypeBounds::isIntegerType(expr.getResolvedType())) operationType = expr.getResolvedType();
+        llvm::Type* operationLLVMType = context.getLLVMType(operationType);
+        if (lhs->getType() != operationLLVMType) lhs = AST::widenInteger(context, lhs, operationLLVMType, lhsType);
+        if (rhs->getType() != operationLLVMType) rhs = AST::widenInteger(context, rhs, operationLLVMType, rhsType);
+    } else if (lhs->getType() != rhs->getType()) {
         if (lhs->getType()->getIntegerBitWidth() < rhs->getType()->getIntegerBitWidth()) {
-            lhs = builder.CreateSExt(lhs, rhs->getType());
+            lhs = AST::widenInteger(context, lhs, rhs->getType(), lhsType);
         } else {
-            rhs = builder.CreateSExt(rhs, lhs->getType());
+            rhs = AST::widenInteger(context, rhs, lhs->getType(), rhsType);
         }
     }
+    bool isUnsigned = TypeBounds::isUnsignedType(operationType);
 
-    llvm::Type* resultType = lhs->getType();
+    /* uint64 against a signed integer meets in int64, which misreads uint64 values above
+       int64's max; comparisons instead compare unsigned and let a negative signed operand
+       decide by its sign alone */
+    bool lhsUint64 = lhsType == VarType::UINT64 && TypeBounds::isIntegerType(rhsType) && !TypeBounds::isUnsignedType(rhsType);
+    bool rhsUint64 = rhsType == VarType::UINT64 && TypeBounds::isIntegerType(lhsType) && !TypeBounds::isUnsignedType(lhsType);
+    if (lhsUint64 || rhsUint64) {
+        llvm::Value* compare = nullptr;
+        bool whenNegative = false; /* the result when the signed operand is negative */
+        switch (expr.getOp()) {
+            case BinaryOp::GREATER: compare = builder.CreateICmpUGT(lhs, rhs, "gttmp"); whenNegative = lhsUint64; break;
+            case BinaryOp::LESS: compare = builder.CreateICmpULT(lhs, rhs, "lttmp"); whenNegative = rhsUint64; break;
+            case BinaryOp::GREATER_EQUAL: compare = builder.CreateICmpUGE(lhs, rhs, "getmp"); whenNegative = lhsUint64; break;
+            case BinaryOp::LESS_EQUAL: compare = builder.CreateICmpULE(lhs, rhs, "letmp"); whenNegative = rhsUint64; break;
+            case BinaryOp::EQUAL: compare = builder.CreateICmpEQ(lhs, rhs, "eqtmp"); break;
+            case BinaryOp::NOT_EQUAL: compare = builder.CreateICmpNE(lhs, rhs, "netmp"); whenNegative = true; break;
+            default: break;
+        }
+        if (compare) {
+            llvm::Value* signedSide = lhsUint64 ? rhs : lhs;
+            llvm::Value* negative = builder.CreateICmpSLT(signedSide, ConstantInt::get(signedSide->getType(), 0), "negtmp");
+            return builder.CreateSelect(negative, builder.getInt1(whenNegative), compare, "cmptmp");
+        }
+    }
 
     switch (expr.getOp()) {
         case BinaryOp::ADD: return builder.CreateAdd(lhs, rhs, "addtmp");
         case BinaryOp::SUBTRACT: return builder.CreateSub(lhs, rhs, "subtmp");
         case BinaryOp::MULTIPLY: return builder.CreateMul(lhs, rhs, "multmp");
         case BinaryOp::DIVIDE: 
-            if (TypeBounds::isUnsignedType(AST::inferSourceType(lhs, context))) {
+            if (isUnsigned) {
                 return builder.CreateUDiv(lhs, rhs, "udivtmp");
             } else {
                 return builder.CreateSDiv(lhs, rhs, "sdivtmp");
             }
         case BinaryOp::MODULUS:
-            if (TypeBounds::isUnsignedType(AST::inferSourceType(lhs, context))) {
+            if (isUnsigned) {
                 return builder.CreateURem(lhs, rhs, "uremtmp");
             } else {
                 return builder.CreateSRem(lhs, rhs, "sremtmp");
@@ -443,15 +484,19 @@ llvm::Value* ExpressionCodeGen::codegenBinary(CodeGen& context, BinaryExpr& expr
         case BinaryOp::BITWISE_XOR: return builder.CreateXor(lhs, rhs, "xortmp");
         case BinaryOp::LEFT_SHIFT: return builder.CreateShl(lhs, rhs, "shltmp");
         case BinaryOp::RIGHT_SHIFT:
-            if (TypeBounds::isUnsignedType(AST::inferSourceType(lhs, context))) {
+            if (isUnsigned) {
                 return builder.CreateLShr(lhs, rhs, "lshrtmp");
             } else {
                 return builder.CreateAShr(lhs, rhs, "ashrtmp");
             }
-        case BinaryOp::GREATER: return builder.CreateICmpSGT(lhs, rhs, "gttmp");
-        case BinaryOp::LESS: return builder.CreateICmpSLT(lhs, rhs, "lttmp");
-        case BinaryOp::GREATER_EQUAL: return builder.CreateICmpSGE(lhs, rhs, "getmp");
-        case BinaryOp::LESS_EQUAL: return builder.CreateICmpSLE(lhs, rhs, "letmp");
+        case BinaryOp::GREATER:
+            return isUnsigned ? builder.CreateICmpUGT(lhs, rhs, "gttmp") : builder.CreateICmpSGT(lhs, rhs, "gttmp");
+        case BinaryOp::LESS:
+            return isUnsigned ? builder.CreateICmpULT(lhs, rhs, "lttmp") : builder.CreateICmpSLT(lhs, rhs, "lttmp");
+        case BinaryOp::GREATER_EQUAL:
+            return isUnsigned ? builder.CreateICmpUGE(lhs, rhs, "getmp") : builder.CreateICmpSGE(lhs, rhs, "getmp");
+        case BinaryOp::LESS_EQUAL:
+            return isUnsigned ? builder.CreateICmpULE(lhs, rhs, "letmp") : builder.CreateICmpSLE(lhs, rhs, "letmp");
         case BinaryOp::EQUAL: return builder.CreateICmpEQ(lhs, rhs, "eqtmp");
         case BinaryOp::NOT_EQUAL: return builder.CreateICmpNE(lhs, rhs, "netmp");
         default: throw std::runtime_error("Unknown binary operator");
@@ -465,12 +510,12 @@ llvm::Value* ExpressionCodeGen::codegenCall(CodeGen& context, CallExpr& expr) {
     auto& manager = StdLibManager::getInstance();
     
     std::string calleeName = expr.getCalleeExpr() ? "(member call)" : expr.getCallee();
-    std::cout << "DEBUG: Generating call to: '" << calleeName 
-              << "' with " << expr.getArgs().size() << " args\n";
+    SUMMIT_TRACE(Call, Detail, "Generating call to: '" << calleeName 
+              << "' with " << expr.getArgs().size() << " args");
 
     if (expr.getCalleeExpr()) {
-        if (auto* memberAccess = dynamic_cast<MemberAccessExpr*>(expr.getCalleeExpr().get())) {
-            std::cout << "DEBUG: Detected method call via member access" << std::endl;
+        if (auto* memberAccess = as<MemberAccessExpr>(expr.getCalleeExpr().get())) {
+            SUMMIT_TRACE(Call, Detail, "Detected method call via member access");
             
             auto* object = memberAccess->getObject().get();
             const std::string& methodName = memberAccess->getMember();
@@ -478,7 +523,7 @@ llvm::Value* ExpressionCodeGen::codegenCall(CodeGen& context, CallExpr& expr) {
             llvm::Value* selfPtr = nullptr;
             std::string structName;
             
-            if (auto* varExpr = dynamic_cast<VariableExpr*>(object)) {
+            if (auto* varExpr = as<VariableExpr>(object)) {
                 std::string varName = varExpr->getName();
                 auto varType = context.lookupVariableType(varName);
                 
@@ -488,8 +533,8 @@ llvm::Value* ExpressionCodeGen::codegenCall(CodeGen& context, CallExpr& expr) {
                     if (auto* arg = llvm::dyn_cast<llvm::Argument>(selfPtr)) {
                         if (arg->getType()->isPointerTy()) {
                             structName = context.getVariableStructName(varName);
-                            std::cout << "DEBUG: Method call on function parameter '" << varName 
-                                      << "' (struct: " << structName << ")" << std::endl;
+                            SUMMIT_TRACE(Call, Detail, "Method call on function parameter '" << varName 
+                                      << "' (struct: " << structName << ")");
                         }
                     }
                     else if (auto* alloca = llvm::dyn_cast<llvm::AllocaInst>(selfPtr)) {
@@ -509,16 +554,15 @@ llvm::Value* ExpressionCodeGen::codegenCall(CodeGen& context, CallExpr& expr) {
             }
             
             if (!structName.empty() && selfPtr) {
-                std::string mangledMethodName = structName + "." + methodName;
-                auto methodFunc = module.getFunction(mangledMethodName);
+                auto methodFunc = context.getStructMethod(structName, methodName);
                 
                 if (methodFunc) {
-                    std::cout << "DEBUG: Calling method '" << mangledMethodName << "'" << std::endl;
+                    SUMMIT_TRACE(Call, Detail, "Calling method '" << methodFunc->getName().str() << "'");
                     
                     std::vector<llvm::Value*> args;
                     
                     args.push_back(selfPtr);
-                    std::cout << "DEBUG: Added self pointer to method call" << std::endl;
+                    SUMMIT_TRACE(Call, Detail, "Added self pointer to method call");
                     
                     unsigned argIdx = 0;
                     for (auto& argExpr : expr.getArgs()) {
@@ -531,35 +575,35 @@ llvm::Value* ExpressionCodeGen::codegenCall(CodeGen& context, CallExpr& expr) {
                         if (paramIter != methodFunc->arg_end()) {
                             llvm::Type* expectedType = paramIter->getType();
                             shouldPassAsPointer = expectedType->isPointerTy();
-                            std::cout << "DEBUG: Argument " << argIdx << " expected type is pointer: " 
-                                      << shouldPassAsPointer << std::endl;
+                            SUMMIT_TRACE(Call, Detail, "Argument " << argIdx << " expected type is pointer: " 
+                                      << shouldPassAsPointer);
                         }
                         
                         if (shouldPassAsPointer) {
-                            if (auto* varExpr = dynamic_cast<VariableExpr*>(argExpr.get())) {
-                                std::cout << "DEBUG: Argument " << argIdx << " is a VariableExpr: " 
-                                          << varExpr->getName() << std::endl;
+                            if (auto* varExpr = as<VariableExpr>(argExpr.get())) {
+                                SUMMIT_TRACE(Call, Detail, "Argument " << argIdx << " is a VariableExpr: " 
+                                          << varExpr->getName());
                                 
                                 auto varPtr = context.lookupVariable(varExpr->getName());
                                 auto varType = context.lookupVariableType(varExpr->getName());
                                 
-                                std::cout << "DEBUG: Variable type is: " << static_cast<int>(varType) << std::endl;
+                                SUMMIT_TRACE(Call, Detail, "Variable type is: " << static_cast<int>(varType));
                                 
                                 if (varPtr && varType == VarType::STRUCT) {
                                     argValue = varPtr;
-                                    std::cout << "DEBUG: Passing struct pointer directly for argument '" 
-                                              << varExpr->getName() << "'" << std::endl;
+                                    SUMMIT_TRACE(Call, Detail, "Passing struct pointer directly for argument '" 
+                                              << varExpr->getName() << "'");
                                 } else {
-                                    std::cout << "DEBUG: Not passing as pointer - varPtr: " << (varPtr != nullptr) 
-                                              << ", is STRUCT: " << (varType == VarType::STRUCT) << std::endl;
+                                    SUMMIT_TRACE(Call, Detail, "Not passing as pointer - varPtr: " << (varPtr != nullptr) 
+                                              << ", is STRUCT: " << (varType == VarType::STRUCT));
                                 }
                             } else {
-                                std::cout << "DEBUG: Argument " << argIdx << " is NOT a VariableExpr" << std::endl;
+                                SUMMIT_TRACE(Call, Detail, "Argument " << argIdx << " is NOT a VariableExpr");
                             }
                         }
                         
                         if (!argValue) {
-                            std::cout << "DEBUG: Calling codegen() for argument " << argIdx << std::endl;
+                            SUMMIT_TRACE(Call, Detail, "Calling codegen() for argument " << argIdx);
                             argValue = argExpr->codegen(context);
                         }
                         
@@ -567,24 +611,25 @@ llvm::Value* ExpressionCodeGen::codegenCall(CodeGen& context, CallExpr& expr) {
                         argIdx++;
                     }
                     
-                    std::cout << "DEBUG: Function '" << mangledMethodName << "' expects " 
-                              << methodFunc->arg_size() << " arguments, got " << args.size() << std::endl;
+                    SUMMIT_TRACE(Call, Detail, "Function '" << methodFunc->getName().str() << "' expects " 
+                              << methodFunc->arg_size() << " arguments, got " << args.size());
                     
-                    unsigned i = 0;
-                    for (auto& arg : methodFunc->args()) {
-                        std::cout << "  Param " << i << ": " << arg.getName().str() << " - ";
-                        arg.getType()->print(llvm::errs());
-                        if (i < args.size()) {
-                            std::cout << " | Arg " << i << ": ";
-                            args[i]->getType()->print(llvm::errs());
+                    if (SUMMIT_TRACE_ENABLED(Call, Detail)) {
+                        unsigned i = 0;
+                        for (auto& arg : methodFunc->args()) {
+                            Trace::Line line(Trace::Category::Call);
+                            line << "  Param " << i << ": " << arg.getName().str() << " - "
+                                 << Trace::printed(arg.getType());
+                            if (i < args.size()) {
+                                line << " | Arg " << i << ": " << Trace::printed(args[i]->getType());
+                            }
+                            i++;
                         }
-                        std::cout << std::endl;
-                        i++;
                     }
 
                     if (args.size() != methodFunc->arg_size()) {
                         std::string errorMsg = "Incorrect number of arguments passed to called function!\n";
-                        errorMsg += "  Function: " + mangledMethodName + "\n";
+                        errorMsg += "  Function: " + methodFunc->getName().str() + "\n";
                         errorMsg += "  Expected: " + std::to_string(methodFunc->arg_size()) + "\n";
                         errorMsg += "  Got: " + std::to_string(args.size()) + "\n";
                         errorMsg += "  Args: ";
@@ -641,8 +686,12 @@ llvm::Value* ExpressionCodeGen::codegenCall(CodeGen& context, CallExpr& expr) {
                         llvm::Type* expectedType = funcType->getParamType(argIndex);
                         
                         if (expectedType->isFloatTy() && argValue->getType()->isIntegerTy()) {
-                            std::cout << "DEBUG: Converting integer to float for math function argument" << std::endl;
-                            argValue = builder.CreateSIToFP(argValue, Type::getFloatTy(llvmContext));
+                            SUMMIT_TRACE(Call, Detail, "Converting integer to float for math function argument");
+                            if (TypeBounds::isUnsignedType(AST::resolvedSourceType(*argExpr, argValue))) {
+                                argValue = builder.CreateUIToFP(argValue, Type::getFloatTy(llvmContext));
+                            } else {
+                                argValue = builder.CreateSIToFP(argValue, Type::getFloatTy(llvmContext));
+                            }
                         }
                         else if (expectedType->isFloatTy() && argValue->getType()->isDoubleTy()) {
                             argValue = builder.CreateFPTrunc(argValue, Type::getFloatTy(llvmContext));
@@ -652,7 +701,7 @@ llvm::Value* ExpressionCodeGen::codegenCall(CodeGen& context, CallExpr& expr) {
             }
             
             if ((isPrintlnCall || isPrintCall) && !argValue->getType()->isPointerTy()) {
-                argValue = AST::convertToString(context, argValue);
+                argValue = AST::convertToString(context, argValue, AST::resolvedSourceType(*argExpr, argValue));
             }
             
             args.push_back(argValue);
@@ -669,22 +718,18 @@ llvm::Value* ExpressionCodeGen::codegenCall(CodeGen& context, CallExpr& expr) {
                 llvm::Type* actualType = args[i]->getType();
                 
                 if (actualType != expectedType) {
-                    std::cout << "DEBUG: Type mismatch in argument " << i 
-                              << ": expected ";
-                    expectedType->print(llvm::errs());
-                    std::cout << ", got ";
-                    actualType->print(llvm::errs());
-                    std::cout << std::endl;
+                    SUMMIT_TRACE(Call, Detail, "Type mismatch in argument " << i << ": expected "
+                                 << Trace::printed(expectedType) << ", got " << Trace::printed(actualType));
                     
                     if (expectedType->isFloatTy() && actualType->isIntegerTy()) {
                         args[i] = builder.CreateSIToFP(args[i], Type::getFloatTy(llvmContext));
-                        std::cout << "DEBUG: Converted integer to float" << std::endl;
+                        SUMMIT_TRACE(Call, Detail, "Converted integer to float");
                     } else if (expectedType->isFloatTy() && actualType->isDoubleTy()) {
                         args[i] = builder.CreateFPTrunc(args[i], Type::getFloatTy(llvmContext));
-                        std::cout << "DEBUG: Converted double to float" << std::endl;
+                        SUMMIT_TRACE(Call, Detail, "Converted double to float");
                     } else if (expectedType->isIntegerTy() && actualType->isFloatTy()) {
                         args[i] = builder.CreateFPToSI(args[i], expectedType);
-                        std::cout << "DEBUG: Converted float to integer" << std::endl;
+                        SUMMIT_TRACE(Call, Detail, "Converted float to integer");
                     } else {
                         std::string expectedTypeStr;
                         llvm::raw_string_ostream expectedOS(expectedTypeStr);
@@ -734,9 +779,10 @@ llvm::Value* ExpressionCodeGen::codegenCall(CodeGen& context, CallExpr& expr) {
         
         std::string functionName = expr.getCallee();
 
-        auto functionHandler = manager.findFunctionHandler(functionName, expr.getArgs().size());
+        auto functionHandler = context.isStdlibEnabled()
+            ? manager.findFunctionHandler(functionName, expr.getArgs().size()) : nullptr;
         if (functionHandler) {
-            std::cout << "DEBUG: Using function handler for: " << functionName << std::endl;
+            SUMMIT_TRACE(Call, Detail, "Using function handler for: " << functionName);
             llvm::Value* callResult = functionHandler->generateCall(context, expr);
             
             if (functionName == "read_int") {
@@ -748,14 +794,14 @@ llvm::Value* ExpressionCodeGen::codegenCall(CodeGen& context, CallExpr& expr) {
             
             return callResult;
         } else {
-            std::cout << "DEBUG: No function handler found for: " << functionName << std::endl;
+            SUMMIT_TRACE(Call, Detail, "No function handler found for: " << functionName);
         }
 
         auto func = module.getFunction(functionName);
         if (!func) {
-            std::cout << "DEBUG: Function '" << functionName << "' not found in module. Available functions:\n";
+            SUMMIT_TRACE(Call, Detail, "Function '" << functionName << "' not found in module. Available functions:");
             for (auto& f : module) {
-                std::cout << "  - " << f.getName().str() << std::endl;
+                SUMMIT_TRACE(Call, Detail, "  - " << f.getName().str());
             }
             throw std::runtime_error("Unknown function: " + functionName);
         }
@@ -777,13 +823,13 @@ llvm::Value* ExpressionCodeGen::codegenCall(CodeGen& context, CallExpr& expr) {
             llvm::Value* argValue = nullptr;
             
             if (expectsPointer) {
-                if (auto* varExpr = dynamic_cast<VariableExpr*>(argExpr.get())) {
+                if (auto* varExpr = as<VariableExpr>(argExpr.get())) {
                     std::string varName = varExpr->getName();
                     VarType varType = context.lookupVariableType(varName);
                     
                     if (varType == VarType::STRUCT) {
                         argValue = context.lookupVariable(varName);
-                        std::cout << "DEBUG: Passing struct '" << varName << "' as pointer directly" << std::endl;
+                        SUMMIT_TRACE(Call, Detail, "Passing struct '" << varName << "' as pointer directly");
                     }
                 }
             }
@@ -800,7 +846,7 @@ llvm::Value* ExpressionCodeGen::codegenCall(CodeGen& context, CallExpr& expr) {
             if (expectedType->isPointerTy() && !argValue->getType()->isPointerTy()) {
                 VarType argVarType = AST::inferSourceType(argValue, context);
                 if (argVarType == VarType::STRUCT) {
-                    std::cout << "DEBUG: Converting struct value to pointer for function call" << std::endl;
+                    SUMMIT_TRACE(Call, Detail, "Converting struct value to pointer for function call");
 
                     llvm::AllocaInst* tempAlloca = builder.CreateAlloca(argValue->getType(), nullptr, "struct_arg");
                     builder.CreateStore(argValue, tempAlloca);
@@ -816,12 +862,8 @@ llvm::Value* ExpressionCodeGen::codegenCall(CodeGen& context, CallExpr& expr) {
                     if (actualBits > expectedBits) {
                         argValue = builder.CreateTrunc(argValue, expectedType);
                     } else if (actualBits < expectedBits) {
-                        VarType sourceType = AST::inferSourceType(argValue, context);
-                        if (TypeBounds::isUnsignedType(sourceType)) {
-                            argValue = builder.CreateZExt(argValue, expectedType);
-                        } else {
-                            argValue = builder.CreateSExt(argValue, expectedType);
-                        }
+                        argValue = AST::widenInteger(context, argValue, expectedType,
+                                                     AST::sourceTypeOf(*argExpr, argValue, context));
                     }
                 }
                 else if (expectedType->isFPOrFPVectorTy() && argValue->getType()->isFPOrFPVectorTy()) {
@@ -832,7 +874,11 @@ llvm::Value* ExpressionCodeGen::codegenCall(CodeGen& context, CallExpr& expr) {
                     }
                 }
                 else if (expectedType->isFPOrFPVectorTy() && argValue->getType()->isIntegerTy()) {
-                    argValue = builder.CreateSIToFP(argValue, expectedType);
+                    if (TypeBounds::isUnsignedType(AST::resolvedSourceType(*argExpr, argValue))) {
+                        argValue = builder.CreateUIToFP(argValue, expectedType);
+                    } else {
+                        argValue = builder.CreateSIToFP(argValue, expectedType);
+                    }
                 }
                 else if (expectedType->isIntegerTy() && argValue->getType()->isFPOrFPVectorTy()) {
                     argValue = builder.CreateFPToSI(argValue, expectedType);
@@ -862,7 +908,7 @@ llvm::Value* ExpressionCodeGen::codegenCall(CodeGen& context, CallExpr& expr) {
             argIdx++;
         }
         
-        std::cout << "DEBUG: Creating call to function: " << functionName << std::endl;
+        SUMMIT_TRACE(Call, Detail, "Creating call to function: " << functionName);
         llvm::Value* callResult = builder.CreateCall(func, args);
         
         if (functionName == "read_int") {
@@ -884,13 +930,13 @@ llvm::Value* ExpressionCodeGen::addSimpleBoundsChecking(CodeGen& context, llvm::
     
     VarType varType = TypeBounds::stringToType(targetType);
     if (varType == VarType::VOID) {
-        std::cout << "DEBUG: Unknown target type for bounds checking: " << targetType << std::endl;
+        SUMMIT_TRACE(Call, Detail, "Unknown target type for bounds checking: " << targetType);
         return value;
     }
     
     auto bounds = TypeBounds::getBounds(varType);
     if (!bounds.has_value()) {
-        std::cout << "DEBUG: No bounds available for type: " << targetType << std::endl;
+        SUMMIT_TRACE(Call, Detail, "No bounds available for type: " << targetType);
         return value;
     }
     
@@ -969,7 +1015,8 @@ llvm::Value* ExpressionCodeGen::codegenCast(CodeGen& context, CastExpr& expr) {
     
     VarType targetType = expr.getTargetType();
     
-    VarType sourceType = AST::inferSourceType(value, context);
+    VarType resolvedType = AST::resolvedSourceType(*expr.getExpr(), value);
+    VarType sourceType = resolvedType != VarType::VOID ? resolvedType : AST::inferSourceType(value, context);
     if (!TypeBounds::isCastValid(sourceType, targetType)) {
         throw std::runtime_error("Invalid cast from " + TypeBounds::getTypeName(sourceType) + 
                                " to " + TypeBounds::getTypeName(targetType));
@@ -991,12 +1038,9 @@ llvm::Value* ExpressionCodeGen::codegenCast(CodeGen& context, CastExpr& expr) {
         unsigned targetBits = targetLLVMType->getIntegerBitWidth();
         
         if (sourceBits < targetBits) {
-            bool isUnsigned = TypeBounds::isUnsignedType(targetType);
-            if (isUnsigned) {
-                return builder.CreateZExt(value, targetLLVMType);
-            } else {
-                return builder.CreateSExt(value, targetLLVMType);
-            }
+            /* Widening keeps the value, so it follows the source's signedness once that is known */
+            return AST::widenInteger(context, value, targetLLVMType,
+                                     resolvedType != VarType::VOID ? resolvedType : targetType);
         } else if (sourceBits > targetBits) {
             return builder.CreateTrunc(value, targetLLVMType);
         }
@@ -1037,7 +1081,7 @@ llvm::Value* ExpressionCodeGen::codegenCast(CodeGen& context, CastExpr& expr) {
     }
     
     if (targetType == VarType::STRING) {
-        return AST::convertToString(context, value);
+        return AST::convertToString(context, value, sourceType);
     }
     
     if (sourceLLVMType->isPointerTy() && targetType != VarType::STRING) {
@@ -1071,34 +1115,21 @@ llvm::Value* ExpressionCodeGen::codegenFormatString(CodeGen& context, FormatStri
         mallocFunc = Function::Create(mallocType, Function::ExternalLinkage, "malloc", &module);
     }
 
+    /* Literal text is escaped for snprintf; each placeholder becomes a %s */
     std::string formatSpecifiers;
-    size_t lastPos = 0;
-    const std::string& formatStr = expr.getFormatStr();
-    
-    size_t pos = 0;
-    while ((pos = formatStr.find('{', lastPos)) != std::string::npos) {
-        if (pos > lastPos) {
-            formatSpecifiers += formatStr.substr(lastPos, pos - lastPos);
-        }
-        
-        size_t endPos = formatStr.find('}', pos);
-        if (endPos == std::string::npos) {
-            throw std::runtime_error("Unclosed '{' in format string");
+    const auto& literals = expr.getLiterals();
+    for (size_t i = 0; i < literals.size(); ++i) {
+        if (i > 0) formatSpecifiers += "%s";
+        for (char c : literals[i]) {
+            if (c == '%') formatSpecifiers += '%';
+            formatSpecifiers += c;
         }
-        
-        formatSpecifiers += "%s";
-        
-        lastPos = endPos + 1;
-    }
-    
-    if (lastPos < formatStr.length()) {
-        formatSpecifiers += formatStr.substr(lastPos);
     }
 
     std::vector<llvm::Value*> stringArgs;
     for (auto& exprPtr : expr.getExpressions()) {
         auto exprValue = exprPtr->codegen(context);
-        auto stringValue = AST::convertToString(context, exprValue);
+        auto stringValue = AST::convertToString(context, exprValue, AST::resolvedSourceType(*exprPtr, exprValue));
         stringArgs.push_back(stringValue);
     }
     
@@ -1137,13 +1168,13 @@ llvm::Value* ExpressionCodeGen::codegenModule(CodeGen& context, ModuleExpr& expr
 llvm::Value* ExpressionCodeGen::codegenMemberAccess(CodeGen& context, MemberAccessExpr& expr) {
     const std::string& member = expr.getMember();
 
-    std::cout << "DEBUG codegenMemberAccess: Accessing member '" << member << "'" << std::endl;
+    SUMMIT_TRACE(Struct, Detail, "codegenMemberAccess: Accessing member '" << member << "'");
 
-    if (auto* varExpr = dynamic_cast<AST::VariableExpr*>(expr.getObject().get())) {
+    if (auto* varExpr = AST::as<AST::VariableExpr>(expr.getObject().get())) {
         std::string varName = varExpr->getName();
         auto varType = context.lookupVariableType(varName);
         
-        std::cout << "DEBUG: Member access on variable '" << varName << "' with type " << static_cast<int>(varType) << std::endl;
+        SUMMIT_TRACE(Struct, Detail, "Member access on variable '" << varName << "' with type " << static_cast<int>(varType));
         
         if (varType == AST::VarType::STRUCT) {
             auto var = context.lookupVariable(varName);
@@ -1155,14 +1186,14 @@ llvm::Value* ExpressionCodeGen::codegenMemberAccess(CodeGen& context, MemberAcce
             llvm::StructType* structType = nullptr;
             
             if (auto* globalVar = llvm::dyn_cast<llvm::GlobalVariable>(var)) {
-                std::cout << "DEBUG: Global variable detected for member access: " << varName << std::endl;
+                SUMMIT_TRACE(Struct, Detail, "Global variable detected for member access: " << varName);
                 
                 llvm::Type* valueType = globalVar->getValueType();
                 if (valueType->isStructTy()) {
                     structType = llvm::cast<llvm::StructType>(valueType);
                     structName = structType->getName().str();
                     
-                    std::cout << "DEBUG: Global struct member access on struct '" << structName << "'" << std::endl;
+                    SUMMIT_TRACE(Struct, Detail, "Global struct member access on struct '" << structName << "'");
 
                     int fieldIndex = context.getStructFieldIndex(structName, member);
                     if (fieldIndex != -1) {
@@ -1173,9 +1204,7 @@ llvm::Value* ExpressionCodeGen::codegenMemberAccess(CodeGen& context, MemberAcce
                         return builder.CreateLoad(fieldType, fieldPtr, member);
                     }
                     
-                    std::string methodName = structName + "." + member;
-                    auto methodFunc = context.getModule().getFunction(methodName);
-                    if (methodFunc) {
+                    if (auto methodFunc = context.getStructMethod(structName, member)) {
                         return methodFunc;
                     }
                     
@@ -1193,7 +1222,7 @@ llvm::Value* ExpressionCodeGen::codegenMemberAccess(CodeGen& context, MemberAcce
                     throw std::runtime_error("Could not determine struct type for parameter: " + varName);
                 }
                 
-                std::cout << "DEBUG: Function parameter struct member access on struct '" << structName << "'" << std::endl;
+                SUMMIT_TRACE(Struct, Detail, "Function parameter struct member access on struct '" << structName << "'");
                 
                 int fieldIndex = context.getStructFieldIndex(structName, member);
                 if (fieldIndex != -1) {
@@ -1211,9 +1240,7 @@ llvm::Value* ExpressionCodeGen::codegenMemberAccess(CodeGen& context, MemberAcce
                     return builder.CreateLoad(fieldType, fieldPtr, member);
                 }
                 
-                std::string methodName = structName + "." + member;
-                auto methodFunc = context.getModule().getFunction(methodName);
-                if (methodFunc) {
+                if (auto methodFunc = context.getStructMethod(structName, member)) {
                     return methodFunc;
                 }
                 
@@ -1225,7 +1252,7 @@ llvm::Value* ExpressionCodeGen::codegenMemberAccess(CodeGen& context, MemberAcce
                     structType = llvm::cast<llvm::StructType>(allocatedType);
                     structName = structType->getName().str();
                     
-                    std::cout << "DEBUG: Local struct variable member access on struct '" << structName << "'" << std::endl;
+                    SUMMIT_TRACE(Struct, Detail, "Local struct variable member access on struct '" << structName << "'");
                     
                     int fieldIndex = context.getStructFieldIndex(structName, member);
                     if (fieldIndex != -1) {
@@ -1236,14 +1263,13 @@ llvm::Value* ExpressionCodeGen::codegenMemberAccess(CodeGen& context, MemberAcce
                         return builder.CreateLoad(fieldType, fieldPtr, member);
                     }
                     
-                    std::string methodName = structName + "." + member;
-                    auto methodFunc = context.getModule().getFunction(methodName);
+                    auto methodFunc = context.getStructMethod(structName, member);
                     if (methodFunc) {
                         if (methodFunc->arg_size() > 0) {
                             auto firstParam = methodFunc->arg_begin();
                             if (firstParam->getType()->isPointerTy() && 
                                 firstParam->getName() == "self") {
-                                std::cout << "DEBUG: Found method '" << methodName << "' with self parameter" << std::endl;
+                                SUMMIT_TRACE(Struct, Detail, "Found method '" << methodFunc->getName().str() << "' with self parameter");
                                 return methodFunc;
                             }
                         }
@@ -1273,30 +1299,15 @@ llvm::Value* ExpressionCodeGen::codegenMemberAccess(CodeGen& context, MemberAcce
     if (object->getType()->isPointerTy()) {
         auto& builder = context.getBuilder();
         
-        std::cout << "DEBUG: Pointer type detected, trying to determine struct type for member '" << member << "'" << std::endl;
-
-        std::string foundStructName;
-        int foundFieldIndex = -1;
+        SUMMIT_TRACE(Struct, Detail, "Pointer type detected, trying to determine struct type for member '" << member << "'");
 
-        auto structTypes = context.getStructTypes();
-        for (const auto& [structName, structInfo] : structTypes) {
-            int fieldIndex = context.getStructFieldIndex(structName, member);
-            if (fieldIndex != -1) {
-                foundStructName = structName;
-                foundFieldIndex = fieldIndex;
-                break;
-            }
-        }
-        
-        if (!foundStructName.empty() && foundFieldIndex != -1) {
-            llvm::StructType* structType = llvm::dyn_cast<llvm::StructType>(context.getStructType(foundStructName));
-            if (structType) {
-                std::cout << "DEBUG: Found struct '" << foundStructName << "' for member '" << member << "'" << std::endl;
-                
-                llvm::Value* fieldPtr = builder.CreateStructGEP(structType, object, foundFieldIndex, member);
-                llvm::Type* fieldType = structType->getElementType(foundFieldIndex);
-                return builder.CreateLoad(fieldType, fieldPtr, member);
-            }
+        auto [structType, foundFieldIndex] = context.findStructWithField(member);
+        if (structType && foundFieldIndex != -1) {
+            SUMMIT_TRACE(Struct, Detail, "Found struct '" << structType->getName().str() << "' for member '" << member << "'");
+            
+            llvm::Value* fieldPtr = builder.CreateStructGEP(structType, object, foundFieldIndex, member);
+            llvm::Type* fieldType = structType->getElementType(foundFieldIndex);
+            return builder.CreateLoad(fieldType, fieldPtr, member);
         }
     }
 
@@ -1304,7 +1315,7 @@ llvm::Value* ExpressionCodeGen::codegenMemberAccess(CodeGen& context, MemberAcce
         llvm::StructType* structType = llvm::cast<llvm::StructType>(object->getType());
         std::string structName = structType->getName().str();
         
-        std::cout << "DEBUG: Loaded struct value member access on struct '" << structName << "'" << std::endl;
+        SUMMIT_TRACE(Struct, Detail, "Loaded struct value member access on struct '" << structName << "'");
         
         int fieldIndex = context.getStructFieldIndex(structName, member);
         if (fieldIndex != -1) {
@@ -1313,9 +1324,7 @@ llvm::Value* ExpressionCodeGen::codegenMemberAccess(CodeGen& context, MemberAcce
             return builder.CreateExtractValue(object, fieldIndex, member);
         }
         
-        std::string methodName = structName + "." + member;
-        auto methodFunc = context.getModule().getFunction(methodName);
-        if (methodFunc) {
+        if (auto methodFunc = context.getStructMethod(structName, member)) {
             return methodFunc;
         }
         
@@ -1337,7 +1346,7 @@ llvm::Value* ExpressionCodeGen::codegenMemberAccess(CodeGen& context, MemberAcce
         }
     }
     
-    if (auto* memberAccess = dynamic_cast<AST::MemberAccessExpr*>(expr.getObject().get())) {
+    if (auto* memberAccess = AST::as<AST::MemberAccessExpr>(expr.getObject().get())) {
         auto baseObject = memberAccess->codegen(context);
         
         if (auto* globalVar = llvm::dyn_cast<llvm::GlobalVariable>(baseObject)) {
@@ -1363,9 +1372,9 @@ llvm::Value* ExpressionCodeGen::handleModuleMemberAccess(CodeGen& context, const
 
     auto& manager = StdLibManager::getInstance();
     
-    auto moduleHandler = manager.findModuleHandler(actualModuleName);
+    auto moduleHandler = context.isStdlibEnabled() ? manager.findModuleHandler(actualModuleName) : nullptr;
     
-    if (!moduleHandler) {
+    if (!moduleHandler && context.isStdlibEnabled()) {
         size_t lastDotPos = actualModuleName.find_last_of('.');
         if (lastDotPos != std::string::npos) {
             std::string shortName = actualModuleName.substr(lastDotPos + 1);
@@ -1415,14 +1424,14 @@ llvm::Value* ExpressionCodeGen::codegenStructLiteral(CodeGen& context, StructLit
         throw std::runtime_error("No field information found for struct: " + structName);
     }
     
-    std::cout << "DEBUG: Generating struct literal for '" << structName << "' with " 
-              << expr.getFields().size() << " provided fields\n";
+    SUMMIT_TRACE(Struct, Detail, "Generating struct literal for '" << structName << "' with " 
+              << expr.getFields().size() << " provided fields");
     
     llvm::AllocaInst* alloca = builder.CreateAlloca(structTy, nullptr, structName + "_tmp");
     
     std::unordered_map<std::string, llvm::Value*> providedFields;
     for (const auto& field : expr.getFields()) {
-        std::cout << "DEBUG: Processing field '" << field.first << "' in struct literal\n";
+        SUMMIT_TRACE(Struct, Detail, "Processing field '" << field.first << "' in struct literal");
         providedFields[field.first] = field.second->codegen(context);
     }
     
@@ -1434,17 +1443,14 @@ llvm::Value* ExpressionCodeGen::codegenStructLiteral(CodeGen& context, StructLit
         llvm::Value* fieldPtr = builder.CreateStructGEP(structTy, alloca, i, fieldName);
         llvm::Type* expectedFieldType = structTy->getElementType(i);
         
-        std::cout << "DEBUG: Initializing field '" << fieldName << "' type: ";
-        expectedFieldType->print(llvm::errs());
-        llvm::errs() << "\n";
+        SUMMIT_TRACE(Struct, Detail, "Initializing field '" << fieldName << "' type: " << Trace::printed(expectedFieldType));
         
         auto providedIt = providedFields.find(fieldName);
         if (providedIt != providedFields.end()) {
             llvm::Value* providedValue = providedIt->second;
             
-            std::cout << "DEBUG: Field '" << fieldName << "' provided with value type: ";
-            providedValue->getType()->print(llvm::errs());
-            llvm::errs() << "\n";
+            SUMMIT_TRACE(Struct, Detail, "Field '" << fieldName << "' provided with value type: "
+                         << Trace::printed(providedValue->getType()));
             
             if (providedValue->getType() != expectedFieldType) {
                 if (expectedFieldType->isFPOrFPVectorTy() && providedValue->getType()->isIntegerTy()) {
@@ -1499,14 +1505,14 @@ llvm::Value* ExpressionCodeGen::codegenStructLiteral(CodeGen& context, StructLit
             }
             
             builder.CreateStore(providedValue, fieldPtr);
-            std::cout << "DEBUG: Stored provided value for field '" << fieldName << "'\n";
+            SUMMIT_TRACE(Struct, Detail, "Stored provided value for field '" << fieldName << "'");
         } else {
             llvm::Constant* defaultVal = context.getStructFieldDefault(structName, fieldName);
             if (defaultVal) {
-                std::cout << "DEBUG: Using stored default value for field '" << fieldName << "'\n";
+                SUMMIT_TRACE(Struct, Detail, "Using stored default value for field '" << fieldName << "'");
                 builder.CreateStore(defaultVal, fieldPtr);
             } else {
-                std::cout << "DEBUG: Field '" << fieldName << "' not provided and no default, using zero\n";
+                SUMMIT_TRACE(Struct, Detail, "Field '" << fieldName << "' not provided and no default, using zero");
                 llvm::Type* fieldLLVMType = structTy->getElementType(i);
                 llvm::Constant* zeroVal = createDefaultValue(fieldLLVMType, fieldType);
                 builder.CreateStore(zeroVal, fieldPtr);
@@ -1515,9 +1521,7 @@ llvm::Value* ExpressionCodeGen::codegenStructLiteral(CodeGen& context, StructLit
     }
     
     llvm::Value* loadedStruct = builder.CreateLoad(structTy, alloca, structName + "_val");
-    std::cout << "DEBUG: Struct literal generated, returning type: ";
-    loadedStruct->getType()->print(llvm::errs());
-    llvm::errs() << "\n";
+    SUMMIT_TRACE(Struct, Detail, "Struct literal generated, returning type: " << Trace::printed(loadedStruct->getType()));
     
     return loadedStruct;
 }
\ No newline at end of file
@@ -0,0 +1,229 @@
+#include "codegen/lld_linker.h"
+#include <filesystem>
+#include <vector>
+#include <mutex>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <llvm/TargetParser/Triple.h>
+#include <llvm/TargetParser/Host.h>
+#include <llvm/Support/raw_ostream.h>
+
+#ifdef SUMMIT_HAVE_LLD
+#include <lld/Common/Driver.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+LLD_HAS_DRIVER(elf)
+#endif
+
+namespace fs = std::filesystem;
+
+namespace LldLinker {
+
+#ifdef SUMMIT_HAVE_LLD
+
+/* Host startup files and loader that the clang driver would normally supply */
+struct HostLinkFiles {
+    std::string libDir;
+    std::string gccDir;
+    std::string dynamicLinker;
+};
+
+static bool findHostLinkFiles(const llvm::Triple& target, HostLinkFiles& files, std::string& error) {
+    std::string arch = target.getArchName().str();
+    std::string multiarch = arch + "-linux-gnu";
+
+    std::vector<std::string> libDirs = {
+        "/usr/lib/" + multiarch,
+        "/lib/" + multiarch,
+        "/usr/lib64",
+        "/lib64",
+        "/usr/lib"
+    };
+    for (const auto& dir : libDirs) {
+        if (fs::exists(fs::path(dir) / "Scrt1.o") && fs::exists(fs::path(dir) / "crti.o") &&
+            fs::exists(fs::path(dir) / "crtn.o")) {
+            files.libDir = dir;
+            break;
+        }
+    }
+    if (files.libDir.empty()) {
+        error = "Scrt1.o/crti.o/crtn.o not found";
+        return false;
+    }
+
+    /* Pick the newest gcc install that ships crtbeginS.o */
+    std::vector<std::string> gccRoots = {
+        "/usr/lib/gcc/" + multiarch,
+        "/usr/lib/gcc/" + arch + "-redhat-linux",
+        "/usr/lib/gcc/" + arch + "-pc-linux-gnu",
+        "/usr/lib64/gcc/" + arch + "-suse-linux"
+    };
+    int bestMajor = -1;
+    for (const auto& root : gccRoots) {
+        std::error_code ec;
+        if (!fs::is_directory(root, ec)) continue;
+        for (const auto& entry : fs::directory_iterator(root, ec)) {
+            if (!fs::exists(entry.path() / "crtbeginS.o") || !fs::exists(entry.path() / "crtendS.o")) continue;
+            int major = std::atoi(entry.path().filename().string().c_str());
+            if (major > bestMajor) {
+                bestMajor = major;
+                files.gccDir = entry.path().string();
+            }
+        }
+    }
+    if (files.gccDir.empty()) {
+        error = "crtbeginS.o/crtendS.o not found";
+        return false;
+    }
+
+    switch (target.getArch()) {
+        case llvm::Triple::x86_64:  files.dynamicLinker = "/lib64/ld-linux-x86-64.so.2"; break;
+        case llvm::Triple::aarch64: files.dynamicLinker = "/lib/ld-linux-aarch64.so.1"; break;
+        case llvm::Triple::riscv64: files.dynamicLinker = "/lib/ld-linux-riscv64-lp64d.so.1"; break;
+        default:
+            error = "no known dynamic linker for " + arch;
+            return false;
+    }
+    if (!fs::exists(files.dynamicLinker)) {
+        error = files.dynamicLinker + " not found";
+        return false;
+    }
+    return true;
+}
+
+/* Hand the object to lld as a path; memfd keeps it off disk */
+static std::string exposeObject(llvm::ArrayRef<char> object, const std::string& outputFilename, int& fd) {
+    fd = memfd_create("summit-object", 0);
+    if (fd >= 0) {
+        size_t written = 0;
+        while (written < object.size()) {
+            ssize_t n = ::write(fd, object.data() + written, object.size() - written);
+            if (n <= 0) break;
+            written += static_cast<size_t>(n);
+        }
+        if (written == object.size()) {
+            return "/proc/self/fd/" + std::to_string(fd);
+        }
+        ::close(fd);
+        fd = -1;
+    }
+
+    std::string objFilename = outputFilename + ".o";
+    std::error_code EC;
+    llvm::raw_fd_ostream out(objFilename, EC);
+    if (EC) return "";
+    out.write(object.data(), object.size());
+    return objFilename;
+}
+
+LinkStatus linkExecutable(llvm::ArrayRef<char> object, const std::string& outputFilename,
+                          const std::string& triple, const std::string& stdlibPath,
+                          bool verbose, std::string& error) {
+    /* lld keeps global state; a run that cannot be repeated disables it */
+    static std::mutex lldMutex;
+    static bool lldUsable = true;
+
+    llvm::Triple target(triple);
+    if (!target.isOSLinux()) {
+        error = "target is not Linux";
+        return LinkStatus::Unavailable;
+    }
+    if (target.getArch() != llvm::Triple(llvm::sys::getProcessTriple()).getArch()) {
+        error = "cross-linking needs a sysroot";
+        return LinkStatus::Unavailable;
+    }
+
+    HostLinkFiles files;
+    if (!findHostLinkFiles(target, files, error)) {
+        return LinkStatus::Unavailable;
+    }
+
+    int fd = -1;
+    std::string objectPath = exposeObject(object, outputFilename, fd);
+    if (objectPath.empty()) {
+        error = "could not stage object for lld";
+        return LinkStatus::Unavailable;
+    }
+
+    fs::path libDir(files.libDir), gccDir(files.gccDir);
+    std::vector<std::string> args = {
+        "ld.lld", "--eh-frame-hdr", "-pie",
+        "-dynamic-linker", files.dynamicLinker,
+        "-o", outputFilename,
+        (libDir / "Scrt1.o").string(),
+        (libDir / "crti.o").string(),
+        (gccDir / "crtbeginS.o").string(),
+        "-L" + files.gccDir,
+        "-L" + files.libDir,
+        objectPath
+    };
+
+    if (!stdlibPath.empty()) {
+        fs::path libPath(stdlibPath);
+        std::string summitDir = libPath.parent_path().string();
+        std::string baseLibName = libPath.stem().string();
+        if (baseLibName.find("lib") == 0) baseLibName = baseLibName.substr(3);
+        args.push_back("-L" + summitDir);
+        args.push_back("-l" + baseLibName);
+        args.push_back("-rpath");
+        args.push_back(summitDir);
+    }
+
+    for (const char* tail : {"-lm", "-ldl", "-lpthread", "-lc", "-lgcc", "--as-needed", "-lgcc_s", "--no-as-needed"}) {
+        args.push_back(tail);
+    }
+    args.push_back((gccDir / "crtendS.o").string());
+    args.push_back((libDir / "crtn.o").string());
+
+    if (verbose) {
+        std::cerr << "Linking with lld:";
+        for (const auto& arg : args) std::cerr << " " << arg;
+        std::cerr << std::endl;
+    }
+
+    std::vector<const char*> argv;
+    argv.reserve(args.size());
+    for (const auto& arg : args) argv.push_back(arg.c_str());
+
+    std::string diagnostics;
+    llvm::raw_string_ostream diagStream(diagnostics);
+    int retCode = 1;
+    {
+        std::lock_guard<std::mutex> lock(lldMutex);
+        if (!lldUsable) {
+            error = "lld cannot be rerun in this process";
+        } else {
+            lld::Result r = lld::lldMain(argv, verbose ? llvm::outs() : llvm::nulls(), diagStream,
+                                         {{lld::Gnu, &lld::elf::link}});
+            retCode = r.retCode;
+            lldUsable = r.canRunAgain;
+        }
+    }
+
+    if (fd >= 0) {
+        ::close(fd);
+    } else {
+        std::remove(objectPath.c_str());
+    }
+
+    if (!error.empty()) return LinkStatus::Unavailable;
+    if (retCode != 0) {
+        error = diagStream.str();
+        return LinkStatus::Failed;
+    }
+    return LinkStatus::Linked;
+}
+
+#else
+
+LinkStatus linkExecutable(llvm::ArrayRef<char>, const std::string&, const std::string&,
+                          const std::string&, bool, std::string& error) {
+    error = "built without lld";
+    return LinkStatus::Unavailable;
+}
+
+#endif
+
+}
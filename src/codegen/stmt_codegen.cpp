@@ -9,10 +9,25 @@
 #include <llvm/IR/Verifier.h>
 #include <llvm/IR/BasicBlock.h>
 #include <llvm/IR/Type.h>
+#include <optional>
+#include <string>
 
 using namespace llvm;
 using namespace AST;
 
+/* Range-check a folded integer constant against its declared type; returns the value as
+   written in the diagnostic when it does not fit */
+static std::optional<std::string> constantOutOfBounds(VarType type, const llvm::ConstantInt& constant) {
+    if (TypeBounds::isUnsignedType(type)) {
+        uint64_t value = constant.getZExtValue();
+        if (TypeBounds::checkBounds(type, value)) return std::nullopt;
+        return std::to_string(value);
+    }
+    int64_t value = constant.getSExtValue();
+    if (TypeBounds::checkBounds(type, value)) return std::nullopt;
+    return std::to_string(value);
+}
+
 llvm::Constant* createDefaultValue(llvm::Type* type, VarType varType) {
     if (type->isIntegerTy()) {
         if (TypeBounds::isUnsignedType(varType)) {
@@ -41,14 +56,14 @@ llvm::Value* StatementCodeGen::codegenVariableDecl(CodeGen& context, VariableDec
     
     bool isGlobal = !builder.GetInsertBlock();
     
-    std::cout << "DEBUG codegenVariableDecl: Processing variable '" << name 
+    SUMMIT_TRACE(Var, Detail, "codegenVariableDecl: Processing variable '" << name 
               << "' type=" << static_cast<int>(type)
               << " isGlobal=" << isGlobal 
-              << " structName='" << decl.getStructName() << "'" << std::endl;
+              << " structName='" << decl.getStructName() << "'");
     
     if (isGlobal) {
         context.registerGlobalVariable(decl.getName());
-        std::cout << "DEBUG: Registered global variable in codegen: " << decl.getName() << std::endl;
+        SUMMIT_TRACE(Var, Detail, "Registered global variable in codegen: " << decl.getName());
         llvm::Type* llvmType;
         if (type == VarType::STRUCT) {
             const std::string& structName = decl.getStructName();
@@ -65,7 +80,7 @@ llvm::Value* StatementCodeGen::codegenVariableDecl(CodeGen& context, VariableDec
         }
         
         if (valueExpr) {
-            if (auto* numberExpr = dynamic_cast<NumberExpr*>(valueExpr.get())) {
+            if (auto* numberExpr = as<NumberExpr>(valueExpr.get())) {
                 const BigInt& bigValue = numberExpr->getValue();
                 if (!TypeBounds::checkBounds(type, bigValue)) {
                     throw std::runtime_error(
@@ -75,7 +90,7 @@ llvm::Value* StatementCodeGen::codegenVariableDecl(CodeGen& context, VariableDec
                     );
                 }
             }
-            else if (auto* floatExpr = dynamic_cast<FloatExpr*>(valueExpr.get())) {
+            else if (auto* floatExpr = as<FloatExpr>(valueExpr.get())) {
                 if (TypeBounds::isIntegerType(type)) {
                     double floatValue = floatExpr->getValue();
                     BigInt bigValue(static_cast<int64_t>(floatValue));
@@ -89,7 +104,7 @@ llvm::Value* StatementCodeGen::codegenVariableDecl(CodeGen& context, VariableDec
                 }
             }
             
-            if (auto* moduleExpr = dynamic_cast<ModuleExpr*>(valueExpr.get())) {
+            if (auto* moduleExpr = as<ModuleExpr>(valueExpr.get())) {
                 auto moduleValue = ExpressionCodeGen::codegenModule(context, *moduleExpr);
                 if (moduleValue) {
                     auto globalVar = new llvm::GlobalVariable(
@@ -100,17 +115,16 @@ llvm::Value* StatementCodeGen::codegenVariableDecl(CodeGen& context, VariableDec
                         llvm::cast<llvm::Constant>(moduleValue),
                         name
                     );
-                    context.getNamedValues()[name] = globalVar;
-                    context.getVariableTypes()[name] = VarType::MODULE;
+                    context.declareVariable(name, globalVar, VarType::MODULE);
                     context.setModuleReference(name, globalVar, moduleExpr->getModuleName());
                     return globalVar;
                 }
             }
-            else if (auto* memberAccess = dynamic_cast<MemberAccessExpr*>(valueExpr.get())) {
+            else if (auto* memberAccess = as<MemberAccessExpr>(valueExpr.get())) {
                 auto object = memberAccess->getObject().get();
                 auto member = memberAccess->getMember();
                 
-                if (auto* varExpr = dynamic_cast<VariableExpr*>(object)) {
+                if (auto* varExpr = as<VariableExpr>(object)) {
                     auto baseVar = context.lookupVariable(varExpr->getName());
                     if (baseVar) {
                         auto baseType = context.lookupVariableType(varExpr->getName());
@@ -126,8 +140,7 @@ llvm::Value* StatementCodeGen::codegenVariableDecl(CodeGen& context, VariableDec
                                     llvm::ConstantAggregateZero::get(placeholderType),
                                     name
                                 );
-                                context.getNamedValues()[name] = globalVar;
-                                context.getVariableTypes()[name] = VarType::MODULE;
+                                context.declareVariable(name, globalVar, VarType::MODULE);
                                 context.setModuleReference(name, globalVar, moduleName + "." + member);
                                 return globalVar;
                             }
@@ -144,14 +157,13 @@ llvm::Value* StatementCodeGen::codegenVariableDecl(CodeGen& context, VariableDec
                         llvm::cast<llvm::Constant>(value),
                         name
                     );
-                    context.getNamedValues()[name] = globalVar;
-                    context.getVariableTypes()[name] = type;
+                    context.declareVariable(name, globalVar, type);
                     return globalVar;
                 } else {
                     throw std::runtime_error("Global variables can only be initialized with constant expressions");
                 }
             }
-            else if (auto* enumValue = dynamic_cast<EnumValueExpr*>(valueExpr.get())) {
+            else if (auto* enumValue = as<EnumValueExpr>(valueExpr.get())) {
                 auto enumVal = ExpressionCodeGen::codegenEnumValue(context, *enumValue);
                 if (llvm::isa<llvm::Constant>(enumVal)) {
                     auto globalVar = new llvm::GlobalVariable(
@@ -162,14 +174,13 @@ llvm::Value* StatementCodeGen::codegenVariableDecl(CodeGen& context, VariableDec
                         llvm::cast<llvm::Constant>(enumVal),
                         name
                     );
-                    context.getNamedValues()[name] = globalVar;
-                    context.getVariableTypes()[name] = type;
+                    context.declareVariable(name, globalVar, type);
                     return globalVar;
                 } else {
                     throw std::runtime_error("Enum value is not constant");
                 }
             }
-            else if (auto* numberExpr = dynamic_cast<NumberExpr*>(valueExpr.get())) {
+            else if (auto* numberExpr = as<NumberExpr>(valueExpr.get())) {
                 const BigInt& bigValue = numberExpr->getValue();
                 if (!TypeBounds::checkBounds(decl.getType(), bigValue)) {
                     throw std::runtime_error(
@@ -188,12 +199,11 @@ llvm::Value* StatementCodeGen::codegenVariableDecl(CodeGen& context, VariableDec
                         llvm::cast<llvm::Constant>(value),
                         name
                     );
-                    context.getNamedValues()[name] = globalVar;
-                    context.getVariableTypes()[name] = type;
+                    context.declareVariable(name, globalVar, type);
                     return globalVar;
                 }
             }
-            else if (auto* floatExpr = dynamic_cast<FloatExpr*>(valueExpr.get())) {
+            else if (auto* floatExpr = as<FloatExpr>(valueExpr.get())) {
                 auto value = ExpressionCodeGen::codegenFloat(context, *floatExpr);
                 if (llvm::isa<llvm::Constant>(value)) {
                     auto globalVar = new llvm::GlobalVariable(
@@ -204,12 +214,11 @@ llvm::Value* StatementCodeGen::codegenVariableDecl(CodeGen& context, VariableDec
                         llvm::cast<llvm::Constant>(value),
                         name
                     );
-                    context.getNamedValues()[name] = globalVar;
-                    context.getVariableTypes()[name] = type;
+                    context.declareVariable(name, globalVar, type);
                     return globalVar;
                 }
             }
-            else if (auto* stringExpr = dynamic_cast<StringExpr*>(valueExpr.get())) {
+            else if (auto* stringExpr = as<StringExpr>(valueExpr.get())) {
                 auto value = ExpressionCodeGen::codegenString(context, *stringExpr);
                 if (llvm::isa<llvm::Constant>(value)) {
                     auto globalVar = new llvm::GlobalVariable(
@@ -220,12 +229,11 @@ llvm::Value* StatementCodeGen::codegenVariableDecl(CodeGen& context, VariableDec
                         llvm::cast<llvm::Constant>(value),
                         name
                     );
-                    context.getNamedValues()[name] = globalVar;
-                    context.getVariableTypes()[name] = type;
+                    context.declareVariable(name, globalVar, type);
                     return globalVar;
                 }
             }
-            else if (auto* boolExpr = dynamic_cast<BooleanExpr*>(valueExpr.get())) {
+            else if (auto* boolExpr = as<BooleanExpr>(valueExpr.get())) {
                 auto value = ExpressionCodeGen::codegenBoolean(context, *boolExpr);
                 if (llvm::isa<llvm::Constant>(value)) {
                     auto globalVar = new llvm::GlobalVariable(
@@ -236,12 +244,11 @@ llvm::Value* StatementCodeGen::codegenVariableDecl(CodeGen& context, VariableDec
                         llvm::cast<llvm::Constant>(value),
                         name
                     );
-                    context.getNamedValues()[name] = globalVar;
-                    context.getVariableTypes()[name] = type;
+                    context.declareVariable(name, globalVar, type);
                     return globalVar;
                 }
             }
-            else if (auto* structLiteral = dynamic_cast<StructLiteralExpr*>(valueExpr.get())) {
+            else if (auto* structLiteral = as<StructLiteralExpr>(valueExpr.get())) {
                 auto value = ExpressionCodeGen::codegenStructLiteral(context, *structLiteral);
                 if (llvm::isa<llvm::Constant>(value)) {
                     auto globalVar = new llvm::GlobalVariable(
@@ -252,8 +259,7 @@ llvm::Value* StatementCodeGen::codegenVariableDecl(CodeGen& context, VariableDec
                         llvm::cast<llvm::Constant>(value),
                         name
                     );
-                    context.getNamedValues()[name] = globalVar;
-                    context.getVariableTypes()[name] = type;
+                    context.declareVariable(name, globalVar, type);
                     return globalVar;
                 } else {
                     throw std::runtime_error("Global struct variables can only be initialized with constant expressions");
@@ -270,8 +276,7 @@ llvm::Value* StatementCodeGen::codegenVariableDecl(CodeGen& context, VariableDec
                         llvm::cast<llvm::Constant>(value),
                         name
                     );
-                    context.getNamedValues()[name] = globalVar;
-                    context.getVariableTypes()[name] = type;
+                    context.declareVariable(name, globalVar, type);
                     return globalVar;
                 } else {
                     throw std::runtime_error("Global variables can only be initialized with constant expressions");
@@ -286,19 +291,18 @@ llvm::Value* StatementCodeGen::codegenVariableDecl(CodeGen& context, VariableDec
                 llvm::Constant::getNullValue(llvmType),
                 name
             );
-            context.getNamedValues()[name] = globalVar;
-            context.getVariableTypes()[name] = type;
+            context.declareVariable(name, globalVar, type);
             return globalVar;
         }
     } else {
-        std::cout << "DEBUG: codegenVariableDecl - LOCAL variable '" << name 
+        SUMMIT_TRACE(Var, Detail, "codegenVariableDecl - LOCAL variable '" << name 
                   << "' type=" << static_cast<int>(type) 
-                  << " structName='" << decl.getStructName() << "'" << std::endl;
+                  << " structName='" << decl.getStructName() << "'");
         
         llvm::Type* llvmType;
         if (type == VarType::STRUCT) {
             const std::string& structName = decl.getStructName();
-            std::cout << "DEBUG: Local variable '" << name << "' declared with struct type, structName from decl = '" << structName << "'" << std::endl;
+            SUMMIT_TRACE(Var, Detail, "Local variable '" << name << "' declared with struct type, structName from decl = '" << structName << "'");
             if (structName.empty()) {
                 std::cout << "ERROR: structName is empty!" << std::endl;
                 throw std::runtime_error("Struct type requires a struct name for variable: " + name);
@@ -325,25 +329,19 @@ llvm::Value* StatementCodeGen::codegenVariableDecl(CodeGen& context, VariableDec
             auto value = valueExpr->codegen(context);
             
             context.clearCurrentTargetType();
+            VarType valueType = AST::resolvedSourceType(*valueExpr, value);
             
             if (type != VarType::STRUCT && TypeBounds::isIntegerType(type) && value->getType()->isIntegerTy()) {
                 if (auto* constInt = llvm::dyn_cast<llvm::ConstantInt>(value)) {
-                    BigInt bigValue;
-                    if (TypeBounds::isUnsignedType(type)) {
-                        bigValue = BigInt(constInt->getZExtValue());
-                    } else {
-                        bigValue = BigInt(constInt->getSExtValue());
-                    }
-                    
-                    if (!TypeBounds::checkBounds(type, bigValue)) {
+                    if (auto outOfBounds = constantOutOfBounds(type, *constInt)) {
                         throw std::runtime_error(
-                            "Value " + bigValue.toString() + " out of bounds for type " + 
+                            "Value " + *outOfBounds + " out of bounds for type " + 
                             TypeBounds::getTypeName(type) + " '" + name + "'. " +
                             "Valid range: " + TypeBounds::getTypeRange(type)
                         );
                     }
-                } else {
-                    value = addRuntimeBoundsChecking(context, value, type, name);
+                } else if (!TypeBounds::storageFitsIn(valueType, type)) {
+                    value = addRuntimeBoundsChecking(context, value, type, name, valueType);
                 }
             }
             
@@ -355,14 +353,10 @@ llvm::Value* StatementCodeGen::codegenVariableDecl(CodeGen& context, VariableDec
                     if (sourceBits > targetBits) {
                         value = builder.CreateTrunc(value, llvmType);
                     } else if (sourceBits < targetBits) {
-                        if (TypeBounds::isUnsignedType(type)) {
-                            value = builder.CreateZExt(value, llvmType);
-                        } else {
-                            value = builder.CreateSExt(value, llvmType);
-                        }
+                        value = AST::widenInteger(context, value, llvmType, valueType != VarType::VOID ? valueType : type);
                     }
                 } else if (llvmType->isFPOrFPVectorTy() && value->getType()->isIntegerTy()) {
-                    if (TypeBounds::isUnsignedType(AST::inferSourceType(value, context))) {
+                    if (TypeBounds::isUnsignedType(valueType)) {
                         value = builder.CreateUIToFP(value, llvmType);
                     } else {
                         value = builder.CreateSIToFP(value, llvmType);
@@ -387,10 +381,9 @@ llvm::Value* StatementCodeGen::codegenVariableDecl(CodeGen& context, VariableDec
             builder.CreateStore(llvm::Constant::getNullValue(llvmType), alloca);
         }
         
-        context.getNamedValues()[name] = alloca;
-        context.getVariableTypes()[name] = type;
+        context.declareVariable(name, alloca, type);
         if (isConst) {
-            context.getConstVariables().insert(name);
+            context.markVariableConst(name);
         }
         
         return alloca;
@@ -419,27 +412,21 @@ llvm::Value* StatementCodeGen::codegenAssignment(CodeGen& context, AssignmentStm
 
     auto value = stmt.getValue()->codegen(context);
     auto& builder = context.getBuilder();
+    VarType valueType = AST::resolvedSourceType(*stmt.getValue(), value);
     
     llvm::Type* expectedType = context.getLLVMType(varType);
 
     if (TypeBounds::isIntegerType(varType) && value->getType()->isIntegerTy()) {
         if (auto* constInt = llvm::dyn_cast<llvm::ConstantInt>(value)) {
-            BigInt bigValue;
-            if (TypeBounds::isUnsignedType(varType)) {
-                bigValue = BigInt(constInt->getZExtValue());
-            } else {
-                bigValue = BigInt(constInt->getSExtValue());
-            }
-            
-            if (!TypeBounds::checkBounds(varType, bigValue)) {
+            if (auto outOfBounds = constantOutOfBounds(varType, *constInt)) {
                 throw std::runtime_error(
-                    "Value " + bigValue.toString() + " out of bounds for type " + 
+                    "Value " + *outOfBounds + " out of bounds for type " + 
                     TypeBounds::getTypeName(varType) + " '" + stmt.getName() + "'. " +
                     "Valid range: " + TypeBounds::getTypeRange(varType)
                 );
             }
-        } else {
-            value = addRuntimeBoundsChecking(context, value, varType, stmt.getName());
+        } else if (!TypeBounds::storageFitsIn(valueType, varType)) {
+            value = addRuntimeBoundsChecking(context, value, varType, stmt.getName(), valueType);
         }
     }
     
@@ -451,15 +438,15 @@ llvm::Value* StatementCodeGen::codegenAssignment(CodeGen& context, AssignmentStm
             if (sourceBits > targetBits) {
                 value = builder.CreateTrunc(value, expectedType);
             } else if (sourceBits < targetBits) {
-                if (TypeBounds::isUnsignedType(varType)) {
-                    value = builder.CreateZExt(value, expectedType);
-                } else {
-                    value = builder.CreateSExt(value, expectedType);
-                }
+                value = AST::widenInteger(context, value, expectedType, valueType != VarType::VOID ? valueType : varType);
             }
         }
         else if (expectedType->isFPOrFPVectorTy() && value->getType()->isIntegerTy()) {
-            value = builder.CreateSIToFP(value, expectedType);
+            if (TypeBounds::isUnsignedType(valueType)) {
+                value = builder.CreateUIToFP(value, expectedType);
+            } else {
+                value = builder.CreateSIToFP(value, expectedType);
+            }
         }
         else if (expectedType->isIntegerTy() && value->getType()->isFPOrFPVectorTy()) {
             value = builder.CreateFPToSI(value, expectedType);
@@ -493,12 +480,12 @@ llvm::Value* StatementCodeGen::codegenGlobalVariable(CodeGen& context, VariableD
     auto& llvmContext = context.getContext();
     
     context.registerGlobalVariable(decl.getName());
-    std::cout << "DEBUG codegenGlobalVariable: Registering global variable '" << decl.getName() << "'" << std::endl;
+    SUMMIT_TRACE(Var, Detail, "codegenGlobalVariable: Registering global variable '" << decl.getName() << "'");
     
     llvm::Type* varType = nullptr;
     if (decl.getType() == VarType::STRUCT) {
         const std::string& structName = decl.getStructName();
-        std::cout << "DEBUG: Global variable '" << decl.getName() << "' has struct type: '" << structName << "'" << std::endl;
+        SUMMIT_TRACE(Var, Detail, "Global variable '" << decl.getName() << "' has struct type: '" << structName << "'");
         
         if (structName.empty()) {
             throw std::runtime_error("Struct type requires a struct name for global variable: " + decl.getName());
@@ -508,7 +495,7 @@ llvm::Value* StatementCodeGen::codegenGlobalVariable(CodeGen& context, VariableD
         if (!varType) {
             throw std::runtime_error("Unknown struct type: " + structName);
         }
-        std::cout << "DEBUG: Found struct type for global variable '" << decl.getName() << "'" << std::endl;
+        SUMMIT_TRACE(Var, Detail, "Found struct type for global variable '" << decl.getName() << "'");
     } else {
         varType = context.getLLVMType(decl.getType());
     }
@@ -520,8 +507,8 @@ llvm::Value* StatementCodeGen::codegenGlobalVariable(CodeGen& context, VariableD
     llvm::Constant* initialValue = nullptr;
     
     if (decl.getValue()) {
-        if (auto* structLiteral = dynamic_cast<StructLiteralExpr*>(decl.getValue().get())) {
-            std::cout << "DEBUG: Global variable '" << decl.getName() << "' initialized with struct literal" << std::endl;
+        if (auto* structLiteral = as<StructLiteralExpr>(decl.getValue().get())) {
+            SUMMIT_TRACE(Var, Detail, "Global variable '" << decl.getName() << "' initialized with struct literal");
             
             if (decl.getType() != VarType::STRUCT) {
                 throw std::runtime_error("Struct literal can only initialize struct variables");
@@ -553,7 +540,7 @@ llvm::Value* StatementCodeGen::codegenGlobalVariable(CodeGen& context, VariableD
                 auto fieldExpr = field.second.get();
                 llvm::Constant* fieldConstant = nullptr;
                 
-                if (auto* numberExpr = dynamic_cast<NumberExpr*>(fieldExpr)) {
+                if (auto* numberExpr = as<NumberExpr>(fieldExpr)) {
                     const BigInt& bigValue = numberExpr->getValue();
                     llvm::Type* fieldType = structType->getElementType(fieldIndex);
                     
@@ -563,7 +550,7 @@ llvm::Value* StatementCodeGen::codegenGlobalVariable(CodeGen& context, VariableD
                         fieldConstant = ConstantInt::get(fieldType, bigValue.toInt64(), true);
                     }
                 }
-                else if (auto* floatExpr = dynamic_cast<FloatExpr*>(fieldExpr)) {
+                else if (auto* floatExpr = as<FloatExpr>(fieldExpr)) {
                     llvm::Type* fieldType = structType->getElementType(fieldIndex);
                     if (fieldType->isFloatTy()) {
                         fieldConstant = ConstantFP::get(fieldType, (float)floatExpr->getValue());
@@ -571,7 +558,7 @@ llvm::Value* StatementCodeGen::codegenGlobalVariable(CodeGen& context, VariableD
                         fieldConstant = ConstantFP::get(fieldType, floatExpr->getValue());
                     }
                 }
-                else if (auto* boolExpr = dynamic_cast<BooleanExpr*>(fieldExpr)) {
+                else if (auto* boolExpr = as<BooleanExpr>(fieldExpr)) {
                     llvm::Type* fieldType = structType->getElementType(fieldIndex);
                     fieldConstant = ConstantInt::get(fieldType, boolExpr->getValue() ? 1 : 0);
                 }
@@ -585,7 +572,7 @@ llvm::Value* StatementCodeGen::codegenGlobalVariable(CodeGen& context, VariableD
             
             initialValue = llvm::ConstantStruct::get(structType, fieldValues);
         }
-        else if (auto* moduleExpr = dynamic_cast<ModuleExpr*>(decl.getValue().get())) {
+        else if (auto* moduleExpr = as<ModuleExpr>(decl.getValue().get())) {
             const std::string& moduleName = moduleExpr->getModuleName();
             
             if (moduleName == "std") {
@@ -604,15 +591,14 @@ llvm::Value* StatementCodeGen::codegenGlobalVariable(CodeGen& context, VariableD
                     decl.getName()
                 );
                 
-                context.getNamedValues()[decl.getName()] = globalVar;
-                context.getVariableTypes()[decl.getName()] = VarType::MODULE;
+                context.declareVariable(decl.getName(), globalVar, VarType::MODULE);
                 
                 context.registerModuleAlias(decl.getName(), "std", globalVar);
                 
-                std::cout << "DEBUG: Created global module alias: " << decl.getName() << " -> std" << std::endl;
+                SUMMIT_TRACE(Module, Detail, "Created global module alias: " << decl.getName() << " -> std");
                 
                 if (decl.getIsConst()) {
-                    context.getConstVariables().insert(decl.getName());
+                    context.markVariableConst(decl.getName());
                 }
                 
                 return globalVar;
@@ -620,13 +606,13 @@ llvm::Value* StatementCodeGen::codegenGlobalVariable(CodeGen& context, VariableD
                 throw std::runtime_error("Unknown module: " + moduleName);
             }
         }
-        else if (auto* memberAccess = dynamic_cast<MemberAccessExpr*>(decl.getValue().get())) {
-            std::cout << "DEBUG: Global variable initialized with member access: " << decl.getName() << std::endl;
+        else if (auto* memberAccess = as<MemberAccessExpr>(decl.getValue().get())) {
+            SUMMIT_TRACE(Var, Detail, "Global variable initialized with member access: " << decl.getName());
 
             try {
                 auto value = decl.getValue()->codegen(context);
                 if (llvm::isa<llvm::Constant>(value)) {
-                    std::cout << "DEBUG: Creating global variable with constant member access value" << std::endl;
+                    SUMMIT_TRACE(Var, Detail, "Creating global variable with constant member access value");
                     
                     auto globalVar = new llvm::GlobalVariable(
                         module,
@@ -637,10 +623,9 @@ llvm::Value* StatementCodeGen::codegenGlobalVariable(CodeGen& context, VariableD
                         decl.getName()
                     );
                     
-                    context.getNamedValues()[decl.getName()] = globalVar;
-                    context.getVariableTypes()[decl.getName()] = VarType::MODULE;
+                    context.declareVariable(decl.getName(), globalVar, VarType::MODULE);
                     
-                    if (auto* varExpr = dynamic_cast<VariableExpr*>(memberAccess->getObject().get())) {
+                    if (auto* varExpr = as<VariableExpr>(memberAccess->getObject().get())) {
                         std::string baseVarName = varExpr->getName();
                         std::string memberName = memberAccess->getMember();
                         
@@ -648,22 +633,22 @@ llvm::Value* StatementCodeGen::codegenGlobalVariable(CodeGen& context, VariableD
                         if (!actualModuleName.empty()) {
                             std::string targetModule = actualModuleName + "." + memberName;
                             context.registerModuleAlias(decl.getName(), targetModule, globalVar);
-                            std::cout << "DEBUG: Registered module alias for " << decl.getName() 
-                                    << " -> " << targetModule << std::endl;
+                            SUMMIT_TRACE(Var, Detail, "Registered module alias for " << decl.getName() 
+                                    << " -> " << targetModule);
                         }
                     }
                     
-                    std::cout << "DEBUG: Created global variable '" << decl.getName() << "' with type MODULE" << std::endl;
+                    SUMMIT_TRACE(Var, Detail, "Created global variable '" << decl.getName() << "' with type MODULE");
                     
                     if (decl.getIsConst()) {
-                        context.getConstVariables().insert(decl.getName());
+                        context.markVariableConst(decl.getName());
                     }
                     
                     return globalVar;
                 } else {
-                    std::cout << "DEBUG: Member access is not constant, creating module alias" << std::endl;
+                    SUMMIT_TRACE(Module, Detail, "Member access is not constant, creating module alias");
                     
-                    if (auto* varExpr = dynamic_cast<VariableExpr*>(memberAccess->getObject().get())) {
+                    if (auto* varExpr = as<VariableExpr>(memberAccess->getObject().get())) {
                         std::string baseVarName = varExpr->getName();
                         std::string memberName = memberAccess->getMember();
                         
@@ -681,17 +666,16 @@ llvm::Value* StatementCodeGen::codegenGlobalVariable(CodeGen& context, VariableD
                                 decl.getName()
                             );
                             
-                            context.getNamedValues()[decl.getName()] = globalVar;
-                            context.getVariableTypes()[decl.getName()] = VarType::MODULE;
+                            context.declareVariable(decl.getName(), globalVar, VarType::MODULE);
                             
                             context.registerModuleAlias(decl.getName(), memberName, globalVar);
                             
-                            std::cout << "DEBUG: Created module member alias: " << decl.getName() 
+                            SUMMIT_TRACE(Var, Detail, "Created module member alias: " << decl.getName() 
                                       << " -> " << memberName << " (via " << baseVarName << " -> " 
-                                      << actualModuleName << ")" << std::endl;
+                                      << actualModuleName << ")");
                             
                             if (decl.getIsConst()) {
-                                context.getConstVariables().insert(decl.getName());
+                                context.markVariableConst(decl.getName());
                             }
                             
                             return globalVar;
@@ -715,17 +699,16 @@ llvm::Value* StatementCodeGen::codegenGlobalVariable(CodeGen& context, VariableD
                                         decl.getName()
                                     );
                                     
-                                    context.getNamedValues()[decl.getName()] = globalVar;
-                                    context.getVariableTypes()[decl.getName()] = VarType::MODULE;
+                                    context.declareVariable(decl.getName(), globalVar, VarType::MODULE);
                                     
                                     std::string targetModule = actualModuleName + "." + memberName;
                                     context.registerModuleAlias(decl.getName(), targetModule, globalVar);
                                     
-                                    std::cout << "DEBUG: Created module member alias: " << decl.getName() 
-                                              << " -> " << targetModule << std::endl;
+                                    SUMMIT_TRACE(Var, Detail, "Created module member alias: " << decl.getName() 
+                                              << " -> " << targetModule);
                                     
                                     if (decl.getIsConst()) {
-                                        context.getConstVariables().insert(decl.getName());
+                                        context.markVariableConst(decl.getName());
                                     }
                                     
                                     return globalVar;
@@ -737,11 +720,11 @@ llvm::Value* StatementCodeGen::codegenGlobalVariable(CodeGen& context, VariableD
                     throw std::runtime_error("Global variables can only be initialized with constant expressions or valid module members");
                 }
             } catch (const std::exception& e) {
-                std::cout << "DEBUG: Error generating member access value: " << e.what() << std::endl;
+                SUMMIT_TRACE(Var, Detail, "Error generating member access value: " << e.what());
                 throw std::runtime_error("Global variables can only be initialized with constant expressions or module members: " + std::string(e.what()));
             }
         }
-        else if (auto* enumValue = dynamic_cast<EnumValueExpr*>(decl.getValue().get())) {
+        else if (auto* enumValue = as<EnumValueExpr>(decl.getValue().get())) {
             std::string fullEnumName = enumValue->getEnumName() + "." + enumValue->getMemberName();
             
             auto enumVar = context.lookupVariable(fullEnumName);
@@ -749,12 +732,12 @@ llvm::Value* StatementCodeGen::codegenGlobalVariable(CodeGen& context, VariableD
                 auto globalEnumVar = llvm::cast<llvm::GlobalVariable>(enumVar);
                 initialValue = globalEnumVar->getInitializer();
                 
-                std::cout << "DEBUG: Using enum value " << fullEnumName << " for global " << decl.getName() << std::endl;
+                SUMMIT_TRACE(Var, Detail, "Using enum value " << fullEnumName << " for global " << decl.getName());
             } else {
                 throw std::runtime_error("Unknown enum value: " + fullEnumName);
             }
         }
-        else if (auto numberExpr = dynamic_cast<NumberExpr*>(decl.getValue().get())) {
+        else if (auto numberExpr = as<NumberExpr>(decl.getValue().get())) {
             const BigInt& bigValue = numberExpr->getValue();
             if (!TypeBounds::checkBounds(decl.getType(), bigValue)) {
                 throw std::runtime_error(
@@ -780,14 +763,14 @@ llvm::Value* StatementCodeGen::codegenGlobalVariable(CodeGen& context, VariableD
                 initialValue = ConstantInt::get(varType, bigValue.toInt64(), true);
             }
         }
-        else if (auto stringExpr = dynamic_cast<StringExpr*>(decl.getValue().get())) {
+        else if (auto stringExpr = as<StringExpr>(decl.getValue().get())) {
             if (decl.getType() != VarType::STRING) {
                 throw std::runtime_error("String literal can only initialize string variables");
             }
             initialValue = llvm::ConstantDataArray::getString(llvmContext, stringExpr->getValue());
             varType = initialValue->getType();
         }
-        else if (auto floatExpr = dynamic_cast<FloatExpr*>(decl.getValue().get())) {
+        else if (auto floatExpr = as<FloatExpr>(decl.getValue().get())) {
             if (decl.getType() == VarType::FLOAT32) {
                 initialValue = ConstantFP::get(Type::getFloatTy(llvmContext), (float)floatExpr->getValue());
             } else if (decl.getType() == VarType::FLOAT64) {
@@ -796,7 +779,7 @@ llvm::Value* StatementCodeGen::codegenGlobalVariable(CodeGen& context, VariableD
                 throw std::runtime_error("Float literal can only initialize float variables");
             }
         }
-        else if (auto boolExpr = dynamic_cast<BooleanExpr*>(decl.getValue().get())) {
+        else if (auto boolExpr = as<BooleanExpr>(decl.getValue().get())) {
             if (decl.getType() != VarType::UINT0) {
                 throw std::runtime_error("Boolean literal can only initialize uint0 variables");
             }
@@ -814,8 +797,7 @@ llvm::Value* StatementCodeGen::codegenGlobalVariable(CodeGen& context, VariableD
                         llvm::cast<llvm::Constant>(value),
                         decl.getName()
                     );
-                    context.getNamedValues()[decl.getName()] = globalVar;
-                    context.getVariableTypes()[decl.getName()] = decl.getType();
+                    context.declareVariable(decl.getName(), globalVar, decl.getType());
                     return globalVar;
                 } else {
                     throw std::runtime_error("Global variables can only be initialized with constant expressions");
@@ -872,15 +854,14 @@ llvm::Value* StatementCodeGen::codegenGlobalVariable(CodeGen& context, VariableD
         decl.getName()
     );
     
-    context.getNamedValues()[decl.getName()] = globalVar;
-    context.getVariableTypes()[decl.getName()] = decl.getType();
+    context.declareVariable(decl.getName(), globalVar, decl.getType());
     
     if (decl.getIsConst()) {
-        context.getConstVariables().insert(decl.getName());
+        context.markVariableConst(decl.getName());
     }
     
-    std::cout << "DEBUG: Created global variable '" << decl.getName() << "' with type " 
-              << static_cast<int>(decl.getType()) << std::endl;
+    SUMMIT_TRACE(Var, Detail, "Created global variable '" << decl.getName() << "' with type " 
+              << static_cast<int>(decl.getType()));
     
     return globalVar;
 }
@@ -889,53 +870,71 @@ llvm::Value* StatementCodeGen::codegenProgram(CodeGen& context, Program& program
     auto& module = context.getModule();
     auto& llvmContext = context.getContext();
     
-    std::cout << "DEBUG: First pass - generating enum and struct declarations" << std::endl;
-    
-    for (size_t i = 0; i < program.getStatements().size(); i++) {
-        auto& stmt = program.getStatements()[i];
-        if (auto* enumDecl = dynamic_cast<EnumDecl*>(stmt.get())) {
-            std::cout << "DEBUG: Generating enum: " << enumDecl->getName() << std::endl;
-            enumDecl->codegen(context);
+    /* One walk over the top level sorts it into the passes below, keeping source order in each */
+    std::vector<Stmt*> typeDecls;
+    std::vector<VariableDecl*> globals;
+    std::vector<FunctionStmt*> functions;
+    std::vector<StructDecl*> structs;
+    std::vector<Stmt*> topLevelCode;
+
+    for (auto& stmt : program.getStatements()) {
+        switch (stmt->getKind()) {
+            case StmtKind::EnumDecl:
+                typeDecls.push_back(stmt.get());
+                break;
+            case StmtKind::StructDecl:
+                typeDecls.push_back(stmt.get());
+                structs.push_back(static_cast<StructDecl*>(stmt.get()));
+                break;
+            case StmtKind::VariableDecl:
+                globals.push_back(static_cast<VariableDecl*>(stmt.get()));
+                break;
+            case StmtKind::Function:
+                functions.push_back(static_cast<FunctionStmt*>(stmt.get()));
+                break;
+            case StmtKind::Entrypoint:
+                break;
+            default:
+                topLevelCode.push_back(stmt.get());
+                break;
         }
-        else if (auto* structDecl = dynamic_cast<StructDecl*>(stmt.get())) {
-            std::cout << "DEBUG: Generating struct: " << structDecl->getName() << std::endl;
-            structDecl->codegen(context);
+    }
+
+    SUMMIT_TRACE(Func, Info, "First pass - generating enum and struct declarations");
+    
+    for (Stmt* decl : typeDecls) {
+        if (auto* enumDecl = as<EnumDecl>(decl)) {
+            SUMMIT_TRACE(Func, Info, "Generating enum: " << enumDecl->getName());
+        } else {
+            SUMMIT_TRACE(Func, Info, "Generating struct: " << static_cast<StructDecl*>(decl)->getName());
         }
+        decl->codegen(context);
     }
     
-    std::cout << "DEBUG: Second pass - generating global variables" << std::endl;
+    SUMMIT_TRACE(Func, Info, "Second pass - generating global variables");
 
-    for (size_t i = 0; i < program.getStatements().size(); i++) {
-        auto& stmt = program.getStatements()[i];
-        if (auto* varDecl = dynamic_cast<VariableDecl*>(stmt.get())) {
-            std::cout << "DEBUG: Generating global variable: " << varDecl->getName() << std::endl;
-            codegenGlobalVariable(context, *varDecl);
-        }
+    for (VariableDecl* varDecl : globals) {
+        SUMMIT_TRACE(Func, Info, "Generating global variable: " << varDecl->getName());
+        codegenGlobalVariable(context, *varDecl);
     }
 
-    std::cout << "DEBUG: Third pass - generating functions" << std::endl;
+    SUMMIT_TRACE(Func, Info, "Third pass - generating functions");
 
-    for (size_t i = 0; i < program.getStatements().size(); i++) {
-        auto& stmt = program.getStatements()[i];
-        if (auto* funcStmt = dynamic_cast<FunctionStmt*>(stmt.get())) {
-            std::cout << "DEBUG: Generating function: " << funcStmt->getName() << std::endl;
-            funcStmt->codegen(context);
-        }
+    for (FunctionStmt* funcStmt : functions) {
+        SUMMIT_TRACE(Func, Info, "Generating function: " << funcStmt->getName());
+        funcStmt->codegen(context);
     }
     
-    std::cout << "DEBUG: Fourth pass - generating struct method bodies" << std::endl;
+    SUMMIT_TRACE(Func, Info, "Fourth pass - generating struct method bodies");
 
-    for (size_t i = 0; i < program.getStatements().size(); i++) {
-        auto& stmt = program.getStatements()[i];
-        if (auto* structDecl = dynamic_cast<StructDecl*>(stmt.get())) {
-            std::cout << "DEBUG: Generating method bodies for struct: " << structDecl->getName() << std::endl;
-            codegenStructMethodBodies(context, *structDecl);
-        }
+    for (StructDecl* structDecl : structs) {
+        SUMMIT_TRACE(Func, Info, "Generating method bodies for struct: " << structDecl->getName());
+        codegenStructMethodBodies(context, *structDecl);
     }
 
     if (program.getHasEntryPoint()) {
         const std::string& entryPointName = program.getEntryPointFunction();
-        std::cout << "DEBUG: Using entry point function: " << entryPointName << std::endl;
+        SUMMIT_TRACE(Func, Info, "Using entry point function: " << entryPointName);
         
         llvm::Function* entryFunc = module.getFunction(entryPointName);
         if (!entryFunc) {
@@ -961,7 +960,7 @@ llvm::Value* StatementCodeGen::codegenProgram(CodeGen& context, Program& program
         }
 
         if (returnType->isVoidTy() || returnType->isIntegerTy(1)) {
-            std::cout << "DEBUG: Creating wrapper for entry point function" << std::endl;
+            SUMMIT_TRACE(Func, Info, "Creating wrapper for entry point function");
             
             entryFunc->setName("__entry_" + entryPointName);
             
@@ -997,17 +996,17 @@ llvm::Value* StatementCodeGen::codegenProgram(CodeGen& context, Program& program
             return mainFunc;
         } else {
             entryFunc->setName("main");
-            std::cout << "DEBUG: Using entry point function as main directly" << std::endl;
+            SUMMIT_TRACE(Func, Info, "Using entry point function as main directly");
             return entryFunc;
         }
     }
     else {
-        std::cout << "DEBUG: No entry point found, checking for main() function" << std::endl;
+        SUMMIT_TRACE(Func, Info, "No entry point found, checking for main() function");
         llvm::Function* userMainFunc = module.getFunction("main");
         bool hasUserMain = (userMainFunc != nullptr);
         
         if (hasUserMain) {
-            std::cout << "DEBUG: Found user-defined main() function" << std::endl;
+            SUMMIT_TRACE(Func, Info, "Found user-defined main() function");
             
             auto returnType = userMainFunc->getReturnType();
             bool isValidReturnType = returnType->isIntegerTy(32) || 
@@ -1029,9 +1028,9 @@ llvm::Value* StatementCodeGen::codegenProgram(CodeGen& context, Program& program
             
             if (returnType->isVoidTy() || returnType->isIntegerTy(1)) {
                 if (returnType->isVoidTy()) {
-                    std::cout << "DEBUG: main() returns void, creating wrapper" << std::endl;
+                    SUMMIT_TRACE(Func, Info, "main() returns void, creating wrapper");
                 } else {
-                    std::cout << "DEBUG: main() returns uint0, creating wrapper" << std::endl;
+                    SUMMIT_TRACE(Func, Info, "main() returns uint0, creating wrapper");
                 }
                 
                 userMainFunc->setName("__user_main");
@@ -1067,11 +1066,11 @@ llvm::Value* StatementCodeGen::codegenProgram(CodeGen& context, Program& program
                 
                 return wrapperMain;
             } else {
-                std::cout << "DEBUG: main() returns int32, using as-is" << std::endl;
+                SUMMIT_TRACE(Func, Info, "main() returns int32, using as-is");
                 return userMainFunc;
             }
         } else {
-            std::cout << "DEBUG: No user-defined main() found, generating auto-main" << std::endl;
+            SUMMIT_TRACE(Func, Info, "No user-defined main() found, generating auto-main");
             
             auto mainFuncType = llvm::FunctionType::get(
                 llvm::Type::getInt32Ty(llvmContext), 
@@ -1087,29 +1086,7 @@ llvm::Value* StatementCodeGen::codegenProgram(CodeGen& context, Program& program
             auto entryBlock = llvm::BasicBlock::Create(llvmContext, "entry", autoMain);
             builder.SetInsertPoint(entryBlock);
 
-            for (size_t i = 0; i < program.getStatements().size(); i++) {
-                auto& stmt = program.getStatements()[i];
-
-                if (dynamic_cast<FunctionStmt*>(stmt.get())) {
-                    continue;
-                }
-                
-                if (dynamic_cast<EntrypointStmt*>(stmt.get())) {
-                    continue;
-                }
-                
-                if (dynamic_cast<VariableDecl*>(stmt.get())) {
-                    continue;
-                }
-                
-                if (dynamic_cast<StructDecl*>(stmt.get())) {
-                    continue;
-                }
-                
-                if (dynamic_cast<EnumDecl*>(stmt.get())) {
-                    continue;
-                }
-                
+            for (Stmt* stmt : topLevelCode) {
                 if (builder.GetInsertBlock()->getTerminator()) {
                     break;
                 }
@@ -1166,13 +1143,13 @@ llvm::Value* StatementCodeGen::codegenFunctionStmt(CodeGen& context, FunctionStm
     llvm::Type* returnType = nullptr;
     if (stmt.getReturnType() == VarType::STRUCT) {
         std::string returnStructName = stmt.getReturnStructName();
-        std::cout << "DEBUG: Function '" << stmt.getName() << "' returns struct: '" << returnStructName << "'" << std::endl;
+        SUMMIT_TRACE(Func, Detail, "Function '" << stmt.getName() << "' returns struct: '" << returnStructName << "'");
         
         if (returnStructName.empty()) {
             if (stmt.getName().find('.') != std::string::npos) {
                 size_t dotPos = stmt.getName().find('.');
                 returnStructName = stmt.getName().substr(0, dotPos);
-                std::cout << "DEBUG: Inferred struct name from method: " << returnStructName << std::endl;
+                SUMMIT_TRACE(Func, Detail, "Inferred struct name from method: " << returnStructName);
             }
         }
         
@@ -1215,20 +1192,18 @@ llvm::Value* StatementCodeGen::codegenFunctionStmt(CodeGen& context, FunctionStm
             arg.setName(param.first);
             
             if (param.first == "self" && isMethod) {
-                context.getNamedValues()[param.first] = &arg;
-                context.getVariableTypes()[param.first] = param.second;
+                context.declareVariable(param.first, &arg, param.second);
 
                 if (param.second == VarType::STRUCT) {
                     std::string structName = stmt.getName().substr(0, stmt.getName().find('.'));
                     context.setVariableStructName(param.first, structName);
-                    std::cout << "DEBUG: Set 'self' parameter to struct '" << structName << "' without alloca" << std::endl;
+                    SUMMIT_TRACE(Func, Detail, "Set 'self' parameter to struct '" << structName << "' without alloca");
                 }
             } else {
                 auto alloca = builder.CreateAlloca(arg.getType(), nullptr, param.first);
                 builder.CreateStore(&arg, alloca);
                 
-                context.getNamedValues()[param.first] = alloca;
-                context.getVariableTypes()[param.first] = param.second;
+                context.declareVariable(param.first, alloca, param.second);
 
                 if (param.second == VarType::STRUCT) {
                     std::string paramStructName = stmt.getParameterStructName(idx);
@@ -1351,14 +1326,11 @@ llvm::Value* StatementCodeGen::codegenReturnStmt(CodeGen& context, ReturnStmt& s
             throw std::runtime_error("Failed to generate return value");
         }
         
-        std::cout << "DEBUG: Return statement - expected type: ";
-        expectedReturnType->print(llvm::errs());
-        llvm::errs() << ", actual type: ";
-        retValue->getType()->print(llvm::errs());
-        llvm::errs() << "\n";
+        SUMMIT_TRACE(Func, Detail, "Return statement - expected type: " << Trace::printed(expectedReturnType)
+                     << ", actual type: " << Trace::printed(retValue->getType()));
         
         if (expectedReturnType->isStructTy()) {
-            std::cout << "DEBUG: Handling struct return type\n";
+            SUMMIT_TRACE(Func, Detail, "Handling struct return type");
             
             if (retValue->getType() != expectedReturnType) {
                 if (auto* alloca = llvm::dyn_cast<llvm::AllocaInst>(retValue)) {
@@ -1400,7 +1372,7 @@ llvm::Value* StatementCodeGen::codegenReturnStmt(CodeGen& context, ReturnStmt& s
                 if (actualBits > expectedBits) {
                     retValue = builder.CreateTrunc(retValue, expectedReturnType, "truncret");
                 } else {
-                    VarType sourceType = AST::inferSourceType(retValue, context);
+                    VarType sourceType = AST::sourceTypeOf(*stmt.getValue(), retValue, context);
                     if (TypeBounds::isUnsignedType(sourceType)) {
                         retValue = builder.CreateZExt(retValue, expectedReturnType, "zextret");
                     } else {
@@ -1416,7 +1388,7 @@ llvm::Value* StatementCodeGen::codegenReturnStmt(CodeGen& context, ReturnStmt& s
                 }
             }
             else if (expectedReturnType->isFPOrFPVectorTy() && retValue->getType()->isIntegerTy()) {
-                VarType sourceType = AST::inferSourceType(retValue, context);
+                VarType sourceType = AST::sourceTypeOf(*stmt.getValue(), retValue, context);
                 if (TypeBounds::isUnsignedType(sourceType)) {
                     retValue = builder.CreateUIToFP(retValue, expectedReturnType, "uitofpret");
                 } else {
@@ -1550,25 +1522,19 @@ llvm::Value* StatementCodeGen::codegenForLoopStmt(CodeGen& context, ForLoopStmt&
    
     if (stmt.getInitializer()) {
         auto initValue = stmt.getInitializer()->codegen(context);
+        VarType initType = AST::resolvedSourceType(*stmt.getInitializer(), initValue);
 
         if (TypeBounds::isIntegerType(varType) && initValue->getType()->isIntegerTy()) {
             if (auto* constInt = llvm::dyn_cast<llvm::ConstantInt>(initValue)) {
-                BigInt bigValue;
-                if (TypeBounds::isUnsignedType(varType)) {
-                    bigValue = BigInt(constInt->getZExtValue());
-                } else {
-                    bigValue = BigInt(constInt->getSExtValue());
-                }
-                
-                if (!TypeBounds::checkBounds(varType, bigValue)) {
+                if (auto outOfBounds = constantOutOfBounds(varType, *constInt)) {
                     throw std::runtime_error(
-                        "Value " + bigValue.toString() + " out of bounds for type " + 
+                        "Value " + *outOfBounds + " out of bounds for type " + 
                         TypeBounds::getTypeName(varType) + " '" + stmt.getVarName() + "'. " +
                         "Valid range: " + TypeBounds::getTypeRange(varType)
                     );
                 }
-            } else {
-                initValue = addRuntimeBoundsChecking(context, initValue, varType, stmt.getVarName());
+            } else if (!TypeBounds::storageFitsIn(initType, varType)) {
+                initValue = addRuntimeBoundsChecking(context, initValue, varType, stmt.getVarName(), initType);
             }
         }
 
@@ -1580,11 +1546,8 @@ llvm::Value* StatementCodeGen::codegenForLoopStmt(CodeGen& context, ForLoopStmt&
                 if (sourceBits > targetBits) {
                     initValue = builder.CreateTrunc(initValue, llvmVarType);
                 } else if (sourceBits < targetBits) {
-                    if (TypeBounds::isUnsignedType(varType)) {
-                        initValue = builder.CreateZExt(initValue, llvmVarType);
-                    } else {
-                        initValue = builder.CreateSExt(initValue, llvmVarType);
-                    }
+                    initValue = AST::widenInteger(context, initValue, llvmVarType,
+                                                  initType != VarType::VOID ? initType : varType);
                 }
             }
         }
@@ -1595,8 +1558,7 @@ llvm::Value* StatementCodeGen::codegenForLoopStmt(CodeGen& context, ForLoopStmt&
         builder.CreateStore(zero, alloca);
     }
 
-    context.getNamedValues()[stmt.getVarName()] = alloca;
-    context.getVariableTypes()[stmt.getVarName()] = stmt.getVarType();
+    context.declareVariable(stmt.getVarName(), alloca, stmt.getVarType());
    
     builder.CreateBr(conditionBlock);
    
@@ -1632,24 +1594,19 @@ llvm::Value* StatementCodeGen::codegenForLoopStmt(CodeGen& context, ForLoopStmt&
     if (stmt.getIncrement()) {
         auto incrementValue = stmt.getIncrement()->codegen(context);
         if (incrementValue) {
+            VarType incrementType = AST::resolvedSourceType(*stmt.getIncrement(), incrementValue);
             if (TypeBounds::isIntegerType(varType) && incrementValue->getType()->isIntegerTy()) {
                 if (auto* constInt = llvm::dyn_cast<llvm::ConstantInt>(incrementValue)) {
-                    BigInt bigValue;
-                    if (TypeBounds::isUnsignedType(varType)) {
-                        bigValue = BigInt(constInt->getZExtValue());
-                    } else {
-                        bigValue = BigInt(constInt->getSExtValue());
-                    }
-                    
-                    if (!TypeBounds::checkBounds(varType, bigValue)) {
+                    if (auto outOfBounds = constantOutOfBounds(varType, *constInt)) {
                         throw std::runtime_error(
-                            "Increment value " + bigValue.toString() + " out of bounds for type " + 
+                            "Increment value " + *outOfBounds + " out of bounds for type " + 
                             TypeBounds::getTypeName(varType) + " '" + stmt.getVarName() + "'. " +
                             "Valid range: " + TypeBounds::getTypeRange(varType)
                         );
                     }
-                } else {
-                    incrementValue = addRuntimeBoundsChecking(context, incrementValue, varType, stmt.getVarName() + "_increment");
+                } else if (!TypeBounds::storageFitsIn(incrementType, varType)) {
+                    incrementValue = addRuntimeBoundsChecking(context, incrementValue, varType,
+                                                              stmt.getVarName() + "_increment", incrementType);
                 }
             }
             
@@ -1663,7 +1620,7 @@ llvm::Value* StatementCodeGen::codegenForLoopStmt(CodeGen& context, ForLoopStmt&
                     if (sourceBits > targetBits) {
                         incrementValue = builder.CreateTrunc(incrementValue, llvmVarType);
                     } else if (sourceBits < targetBits) {
-                        incrementValue = builder.CreateSExt(incrementValue, llvmVarType);
+                        incrementValue = AST::widenInteger(context, incrementValue, llvmVarType, incrementType);
                     }
                 }
             }
@@ -1711,8 +1668,7 @@ llvm::Value* StatementCodeGen::codegenEnumDecl(CodeGen& context, EnumDecl& decl)
             fullName
         );
         
-        context.getNamedValues()[fullName] = enumValue;
-        context.getVariableTypes()[fullName] = VarType::INT32;
+        context.declareVariable(fullName, enumValue, VarType::INT32);
     }
     
     return nullptr;
@@ -1743,7 +1699,8 @@ llvm::Value* StatementCodeGen::codegenContinueStmt(CodeGen& context, ContinueStm
     return nullptr;
 }
 
-llvm::Value* StatementCodeGen::addRuntimeBoundsChecking(CodeGen& context, llvm::Value* value, AST::VarType targetType, const std::string& varName) {
+llvm::Value* StatementCodeGen::addRuntimeBoundsChecking(CodeGen& context, llvm::Value* value, AST::VarType targetType,
+                                                        const std::string& varName, AST::VarType sourceType) {
     auto& builder = context.getBuilder();
     auto& llvmContext = context.getContext();
     auto& module = context.getModule();
@@ -1760,11 +1717,8 @@ llvm::Value* StatementCodeGen::addRuntimeBoundsChecking(CodeGen& context, llvm::
 
     llvm::Value* value64;
     if (value->getType()->isIntegerTy()) {
-        if (AST::TypeBounds::isUnsignedType(targetType)) {
-            value64 = builder.CreateZExt(value, llvm::Type::getInt64Ty(llvmContext));
-        } else {
-            value64 = builder.CreateSExt(value, llvm::Type::getInt64Ty(llvmContext));
-        }
+        value64 = AST::widenInteger(context, value, llvm::Type::getInt64Ty(llvmContext),
+                                    sourceType != AST::VarType::VOID ? sourceType : targetType);
     } else {
         return value;
     }
@@ -1832,9 +1786,9 @@ llvm::Value* StatementCodeGen::codegenStructDecl(CodeGen& context, StructDecl& d
     auto& module = context.getModule();
     
     std::string structName = decl.getName();
-    std::cout << "DEBUG codegenStructDecl: Generating struct '" << structName << "' with " 
+    SUMMIT_TRACE(Struct, Detail, "codegenStructDecl: Generating struct '" << structName << "' with " 
               << decl.getFields().size() << " fields and " << decl.getMethods().size() 
-              << " methods" << std::endl;
+              << " methods");
     
     std::vector<llvm::Type*> fieldTypes;
     for (const auto& field : decl.getFields()) {
@@ -1852,7 +1806,7 @@ llvm::Value* StatementCodeGen::codegenStructDecl(CodeGen& context, StructDecl& d
             throw std::runtime_error("Unknown field type in struct '" + structName + "' for field: " + field.first);
         }
         fieldTypes.push_back(fieldType);
-        std::cout << "DEBUG: Field '" << field.first << "' type: " << static_cast<int>(field.second) << std::endl;
+        SUMMIT_TRACE(Struct, Detail, "Field '" << field.first << "' type: " << static_cast<int>(field.second));
     }
     
     llvm::StructType* structType = llvm::StructType::create(llvmContext, fieldTypes, structName);
@@ -1861,7 +1815,7 @@ llvm::Value* StatementCodeGen::codegenStructDecl(CodeGen& context, StructDecl& d
     for (const auto& [fieldName, defaultValueExpr] : decl.getFieldDefaults()) {
         if (defaultValueExpr) {
             try {
-                if (auto* floatExpr = dynamic_cast<AST::FloatExpr*>(defaultValueExpr.get())) {
+                if (auto* floatExpr = AST::as<AST::FloatExpr>(defaultValueExpr.get())) {
                     VarType fieldType = VarType::VOID;
                     for (const auto& field : decl.getFields()) {
                         if (field.first == fieldName) {
@@ -1879,10 +1833,10 @@ llvm::Value* StatementCodeGen::codegenStructDecl(CodeGen& context, StructDecl& d
                     
                     if (constantValue) {
                         context.registerStructFieldDefault(structName, fieldName, constantValue);
-                        std::cout << "DEBUG: Registered float default value for field '" << fieldName << "': " << floatExpr->getValue() << std::endl;
+                        SUMMIT_TRACE(Struct, Detail, "Registered float default value for field '" << fieldName << "': " << floatExpr->getValue());
                     }
                 }
-                else if (auto* numberExpr = dynamic_cast<AST::NumberExpr*>(defaultValueExpr.get())) {
+                else if (auto* numberExpr = AST::as<AST::NumberExpr>(defaultValueExpr.get())) {
                     VarType fieldType = VarType::VOID;
                     for (const auto& field : decl.getFields()) {
                         if (field.first == fieldName) {
@@ -1914,13 +1868,13 @@ llvm::Value* StatementCodeGen::codegenStructDecl(CodeGen& context, StructDecl& d
                     
                     if (constantValue) {
                         context.registerStructFieldDefault(structName, fieldName, constantValue);
-                        std::cout << "DEBUG: Registered integer default value for field '" << fieldName << "': " << bigValue.toString() << std::endl;
+                        SUMMIT_TRACE(Struct, Detail, "Registered integer default value for field '" << fieldName << "': " << bigValue.toString());
                     }
                 }
-                else if (auto* boolExpr = dynamic_cast<AST::BooleanExpr*>(defaultValueExpr.get())) {
+                else if (auto* boolExpr = AST::as<AST::BooleanExpr>(defaultValueExpr.get())) {
                     llvm::Constant* constantValue = llvm::ConstantInt::get(llvm::Type::getInt1Ty(llvmContext), boolExpr->getValue() ? 1 : 0);
                     context.registerStructFieldDefault(structName, fieldName, constantValue);
-                    std::cout << "DEBUG: Registered boolean default value for field '" << fieldName << "': " << boolExpr->getValue() << std::endl;
+                    SUMMIT_TRACE(Struct, Detail, "Registered boolean default value for field '" << fieldName << "': " << boolExpr->getValue());
                 }
                 else {
                     std::cout << "WARNING: Unsupported default value type for field '" << fieldName << "'" << std::endl;
@@ -1933,30 +1887,29 @@ llvm::Value* StatementCodeGen::codegenStructDecl(CodeGen& context, StructDecl& d
     }
     
     
-    std::cout << "DEBUG: Registered struct type '" << structName << "' with " << fieldTypes.size() << " fields" << std::endl;
+    SUMMIT_TRACE(Struct, Detail, "Registered struct type '" << structName << "' with " << fieldTypes.size() << " fields");
 
     for (const auto& method : decl.getMethods()) {
-        std::cout << "DEBUG: Generating method declaration for '" << method->getName() 
-                  << "' for struct '" << structName << "'" << std::endl;
-        std::cout << "DEBUG: Method return type: " << static_cast<int>(method->getReturnType())
-                  << ", return struct name: '" << method->getReturnStructName() << "'" << std::endl;
+        SUMMIT_TRACE(Struct, Detail, "Generating method declaration for '" << method->getName() 
+                  << "' for struct '" << structName << "'");
+        SUMMIT_TRACE(Struct, Detail, "Method return type: " << static_cast<int>(method->getReturnType())
+                  << ", return struct name: '" << method->getReturnStructName() << "'");
 
         std::string mangledName = method->getName();
-        std::cout << "DEBUG: Using mangled name: '" << mangledName << "'" << std::endl;
+        SUMMIT_TRACE(Struct, Detail, "Using mangled name: '" << mangledName << "'");
         
         std::vector<llvm::Type*> paramTypes;
         
         paramTypes.push_back(llvm::PointerType::get(structType, 0));
-        std::cout << "DEBUG: Added self parameter of type: ";
-        structType->print(llvm::errs());
-        std::cout << " for method " << mangledName << std::endl;
+        SUMMIT_TRACE(Struct, Detail, "Added self parameter of type: " << Trace::printed(structType)
+                     << " for method " << mangledName);
         
         const auto& params = method->getParameters();
         for (size_t i = 0; i < params.size(); ++i) {
             const auto& param = params[i];
             
             if (param.first == "self") {
-                std::cout << "DEBUG: Skipping 'self' parameter from method definition" << std::endl;
+                SUMMIT_TRACE(Struct, Detail, "Skipping 'self' parameter from method definition");
                 continue;
             }
             
@@ -1966,7 +1919,7 @@ llvm::Value* StatementCodeGen::codegenStructDecl(CodeGen& context, StructDecl& d
 
                 if (paramStructName.empty()) {
                     paramStructName = structName;
-                    std::cout << "DEBUG: Inferred struct name '" << paramStructName << "' for parameter '" << param.first << "'" << std::endl;
+                    SUMMIT_TRACE(Struct, Detail, "Inferred struct name '" << paramStructName << "' for parameter '" << param.first << "'");
                 }
                 
                 if (paramStructName.empty()) {
@@ -1981,15 +1934,13 @@ llvm::Value* StatementCodeGen::codegenStructDecl(CodeGen& context, StructDecl& d
                 throw std::runtime_error("Unknown parameter type for method parameter: " + param.first);
             }
             paramTypes.push_back(paramType);
-            std::cout << "DEBUG: Added parameter '" << param.first << "' type: ";
-            paramType->print(llvm::errs());
-            std::cout << std::endl;
+            SUMMIT_TRACE(Struct, Detail, "Added parameter '" << param.first << "' type: " << Trace::printed(paramType));
         }
         
         llvm::Type* returnType = nullptr;
         if (method->getReturnType() == VarType::STRUCT) {
             std::string returnStructName = method->getReturnStructName();
-            std::cout << "DEBUG: Method returns struct: '" << returnStructName << "'" << std::endl;
+            SUMMIT_TRACE(Struct, Detail, "Method returns struct: '" << returnStructName << "'");
             
             if (returnStructName.empty()) {
                 throw std::runtime_error("Struct type requires a struct name for method: " + method->getName());
@@ -2016,11 +1967,17 @@ llvm::Value* StatementCodeGen::codegenStructDecl(CodeGen& context, StructDecl& d
             &module
         );
 
+        /* The parser names methods "<struct>.<method>" */
+        std::string methodName = mangledName.compare(0, structName.size() + 1, structName + ".") == 0
+            ? mangledName.substr(structName.size() + 1)
+            : mangledName;
+        context.registerStructMethod(structName, methodName, function);
+
         unsigned argIdx = 0;
         for (auto& arg : function->args()) {
             if (argIdx == 0) {
                 arg.setName("self");
-                std::cout << "DEBUG: Set parameter " << argIdx << " name to 'self'" << std::endl;
+                SUMMIT_TRACE(Struct, Detail, "Set parameter " << argIdx << " name to 'self'");
             } else {
                 size_t methodParamIdx = 0;
                 size_t nonSelfParamCount = 0;
@@ -2038,24 +1995,23 @@ llvm::Value* StatementCodeGen::codegenStructDecl(CodeGen& context, StructDecl& d
                 if (methodParamIdx < params.size()) {
                     std::string paramName = params[methodParamIdx].first;
                     arg.setName(paramName);
-                    std::cout << "DEBUG: Set parameter " << argIdx << " name to '" << paramName << "'" << std::endl;
+                    SUMMIT_TRACE(Struct, Detail, "Set parameter " << argIdx << " name to '" << paramName << "'");
                 }
             }
             argIdx++;
         }
         
-        std::cout << "DEBUG: Created method declaration for '" << mangledName << "' with " 
-                  << function->arg_size() << " parameters:" << std::endl;
+        SUMMIT_TRACE(Struct, Detail, "Created method declaration for '" << mangledName << "' with " 
+                  << function->arg_size() << " parameters:");
         argIdx = 0;
         for (auto& arg : function->args()) {
-            std::cout << "  Param " << argIdx << ": " << arg.getName().str() << " - ";
-            arg.getType()->print(llvm::errs());
-            std::cout << std::endl;
+            SUMMIT_TRACE(Struct, Detail, "  Param " << argIdx << ": " << arg.getName().str() << " - "
+                         << Trace::printed(arg.getType()));
             argIdx++;
         }
     }
     
-    std::cout << "DEBUG: Successfully generated struct '" << structName << "' type definition" << std::endl;
+    SUMMIT_TRACE(Struct, Detail, "Successfully generated struct '" << structName << "' type definition");
     return nullptr;
 }
 
@@ -2066,17 +2022,17 @@ void StatementCodeGen::codegenStructMethodBodies(CodeGen& context, StructDecl& d
     std::string structName = decl.getName();
     llvm::StructType* structType = llvm::cast<llvm::StructType>(context.getStructType(structName));
     
-    std::cout << "DEBUG codegenStructMethodBodies: Generating method bodies for struct '" << structName << "'" << std::endl;
+    SUMMIT_TRACE(Struct, Detail, "codegenStructMethodBodies: Generating method bodies for struct '" << structName << "'");
     
     for (const auto& method : decl.getMethods()) {
         std::string mangledName = method->getName();
-        std::cout << "DEBUG: Looking for method declaration: '" << mangledName << "'" << std::endl;
+        SUMMIT_TRACE(Struct, Detail, "Looking for method declaration: '" << mangledName << "'");
         
         auto function = module.getFunction(mangledName);
         
         if (!function) {
             std::string altName = structName + "." + method->getName().substr(structName.length() + 1);
-            std::cout << "DEBUG: Trying alternative name: '" << altName << "'" << std::endl;
+            SUMMIT_TRACE(Struct, Detail, "Trying alternative name: '" << altName << "'");
             function = module.getFunction(altName);
         }
         
@@ -2085,50 +2041,24 @@ void StatementCodeGen::codegenStructMethodBodies(CodeGen& context, StructDecl& d
         }
         
         if (method->getBody()) {
-            std::cout << "DEBUG: Generating method body for '" << mangledName << "'" << std::endl;
+            SUMMIT_TRACE(Struct, Detail, "Generating method body for '" << mangledName << "'");
             
             auto& builder = context.getBuilder();
             llvm::BasicBlock* savedInsertBlock = builder.GetInsertBlock();
             
-            auto savedNamedValues = context.getNamedValues();
-            auto savedVariableTypes = context.getVariableTypes();
-            
             context.enterScope();
             
-            std::cout << "DEBUG: Copying global variables into method scope for '" << mangledName << "':" << std::endl;
-            for (const auto& [varName, varValue] : savedNamedValues) {
-                if (context.isGlobalVariable(varName)) {
-                    context.getNamedValues()[varName] = varValue;
-                    auto it = savedVariableTypes.find(varName);
-                    if (it != savedVariableTypes.end()) {
-                        context.getVariableTypes()[varName] = it->second;
-                    }
-                    std::cout << "  - Copied global: " << varName << std::endl;
-                }
-            }
-            
             auto entryBlock = llvm::BasicBlock::Create(llvmContext, "entry", function);
             builder.SetInsertPoint(entryBlock);
             
-            std::cout << "DEBUG: In method '" << mangledName << "', available variables in scope:" << std::endl;
-            auto& currentNamedValues = context.getNamedValues();
-            for (const auto& var : currentNamedValues) {
-                std::cout << "  - " << var.first;
-                if (context.isGlobalVariable(var.first)) {
-                    std::cout << " (global)";
-                }
-                std::cout << std::endl;
-            }
-
             unsigned idx = 0;
             const auto& methodParams = method->getParameters();
             for (auto& arg : function->args()) {
                 if (idx == 0 && arg.getName() == "self") {
                     arg.setName("self");
-                    context.getNamedValues()["self"] = &arg;
-                    context.getVariableTypes()["self"] = VarType::STRUCT;
+                    context.declareVariable("self", &arg, VarType::STRUCT);
                     context.setVariableStructName("self", structName);
-                    std::cout << "DEBUG: Set variable 'self' to struct '" << structName << "' (direct argument)" << std::endl;
+                    SUMMIT_TRACE(Struct, Detail, "Set variable 'self' to struct '" << structName << "' (direct argument)");
                 } else {
                     size_t methodParamIdx = 0;
                     size_t nonSelfParamCount = 0;
@@ -2150,19 +2080,17 @@ void StatementCodeGen::codegenStructMethodBodies(CodeGen& context, StructDecl& d
                         arg.setName(paramName);
 
                         if (paramType == VarType::STRUCT) {
-                            context.getNamedValues()[paramName] = &arg;
-                            context.getVariableTypes()[paramName] = paramType;
+                            context.declareVariable(paramName, &arg, paramType);
                             context.setVariableStructName(paramName, structName);
-                            std::cout << "DEBUG: Set struct parameter '" << paramName << "' to struct '" 
-                                      << structName << "' (direct argument)" << std::endl;
+                            SUMMIT_TRACE(Struct, Detail, "Set struct parameter '" << paramName << "' to struct '" 
+                                      << structName << "' (direct argument)");
                         } else {
                             auto alloca = builder.CreateAlloca(arg.getType(), nullptr, paramName);
                             builder.CreateStore(&arg, alloca);
-                            context.getNamedValues()[paramName] = alloca;
-                            context.getVariableTypes()[paramName] = paramType;
+                            context.declareVariable(paramName, alloca, paramType);
                             
-                            std::cout << "DEBUG: Set parameter '" << paramName << "' with type " 
-                                      << static_cast<int>(paramType) << std::endl;
+                            SUMMIT_TRACE(Struct, Detail, "Set parameter '" << paramName << "' with type " 
+                                      << static_cast<int>(paramType));
                         }
                     }
                 }
@@ -2197,7 +2125,7 @@ void StatementCodeGen::codegenStructMethodBodies(CodeGen& context, StructDecl& d
 llvm::Value* StatementCodeGen::codegenMemberAssignment(CodeGen& context, MemberAssignmentStmt& stmt) {
     auto& builder = context.getBuilder();
     
-    auto* varExpr = dynamic_cast<AST::VariableExpr*>(stmt.getObject().get());
+    auto* varExpr = AST::as<AST::VariableExpr>(stmt.getObject().get());
     if (!varExpr) {
         throw std::runtime_error("Member assignment only supports direct variable access");
     }
@@ -2253,7 +2181,7 @@ llvm::Value* StatementCodeGen::codegenMemberAssignment(CodeGen& context, MemberA
             if (actualBits > expectedBits) {
                 value = builder.CreateTrunc(value, expectedFieldType);
             } else if (actualBits < expectedBits) {
-                VarType sourceType = AST::inferSourceType(value, context);
+                VarType sourceType = AST::sourceTypeOf(*stmt.getValue(), value, context);
                 if (AST::TypeBounds::isUnsignedType(sourceType)) {
                     value = builder.CreateZExt(value, expectedFieldType);
                 } else {
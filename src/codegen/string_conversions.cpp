@@ -140,7 +140,7 @@ namespace AST {
         return buffer;
     }
 
-    llvm::Value* convertToString(CodeGen& context, llvm::Value* value) {
+    llvm::Value* convertToString(CodeGen& context, llvm::Value* value, VarType sourceType) {
         auto& builder = context.getBuilder();
         auto& module = context.getModule();
         auto& llvmContext = context.getContext();
@@ -153,13 +153,13 @@ namespace AST {
             llvm::StructType* structType = llvm::cast<llvm::StructType>(value->getType());
             std::string structName = structType->getName().str();
             
-            std::cout << "DEBUG convertToString: Converting struct '" << structName << "' to string" << std::endl;
+            SUMMIT_TRACE(Struct, Detail, "convertToString: Converting struct '" << structName << "' to string");
             
             std::string methodName = structName + ".to_str";
             auto methodFunc = module.getFunction(methodName);
             
             if (methodFunc) {
-                std::cout << "DEBUG convertToString: Found to_str method for struct '" << structName << "'" << std::endl;
+                SUMMIT_TRACE(Struct, Detail, "convertToString: Found to_str method for struct '" << structName << "'");
 
                 auto alloca = builder.CreateAlloca(structType, nullptr, "struct_temp");
                 builder.CreateStore(value, alloca);
@@ -168,7 +168,7 @@ namespace AST {
                 args.push_back(alloca);
                 return builder.CreateCall(methodFunc, args);
             } else {
-                std::cout << "DEBUG convertToString: No to_str method found for struct '" << structName << "'" << std::endl;
+                SUMMIT_TRACE(Struct, Detail, "convertToString: No to_str method found for struct '" << structName << "'");
                 
                 std::string fallbackStr = "[" + structName + " struct]";
                 return builder.CreateGlobalStringPtr(fallbackStr);
@@ -193,7 +193,9 @@ namespace AST {
         if (value->getType()->isIntegerTy()) {
             unsigned bitWidth = value->getType()->getIntegerBitWidth();
 
-            VarType sourceType = AST::inferSourceType(value, context);
+            if (sourceType == VarType::VOID) {
+                sourceType = AST::inferSourceType(value, context);
+            }
             bool isUnsigned = TypeBounds::isUnsignedType(sourceType);
 
             if (bitWidth == 1) {
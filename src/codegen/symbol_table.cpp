@@ -0,0 +1,49 @@
+#include "symbol_table.h"
+#include <limits>
+#include <stdexcept>
+
+void SymbolTable::enterScope() {
+    scopeMarks.push_back(entries.size());
+}
+
+void SymbolTable::exitScope() {
+    if (scopeMarks.empty()) return;
+
+    size_t mark = scopeMarks.back();
+    scopeMarks.pop_back();
+    while (entries.size() > mark) {
+        const Entry& entry = entries.back();
+        if (entry.shadowed) {
+            heads[entry.id] = entry.shadowed;
+        } else {
+            heads.erase(entry.id);
+        }
+        entries.pop_back();
+    }
+}
+
+SymbolTable::Symbol& SymbolTable::declare(Id id) {
+    if (scopeMarks.empty()) throw std::runtime_error("No active scope");
+
+    uint32_t& head = heads[id];
+    if (head && entries[head - 1].depth == scopeMarks.size()) {
+        return entries[head - 1].symbol;
+    }
+
+    if (entries.size() >= std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("Too many variables in scope");
+    }
+    entries.push_back({Symbol{}, id, static_cast<uint32_t>(scopeMarks.size()), head});
+    head = static_cast<uint32_t>(entries.size());
+    return entries.back().symbol;
+}
+
+SymbolTable::Symbol* SymbolTable::lookup(Id id) {
+    auto it = heads.find(id);
+    return it == heads.end() ? nullptr : &entries[it->second - 1].symbol;
+}
+
+const SymbolTable::Symbol* SymbolTable::lookup(Id id) const {
+    auto it = heads.find(id);
+    return it == heads.end() ? nullptr : &entries[it->second - 1].symbol;
+}
@@ -0,0 +1,19 @@
+#include "type_descriptor.h"
+#include <llvm/IR/DerivedTypes.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Type.h>
+
+namespace AST::TypeFactories {
+
+llvm::Type* int1(llvm::LLVMContext& context) { return llvm::Type::getInt1Ty(context); }
+llvm::Type* int8(llvm::LLVMContext& context) { return llvm::Type::getInt8Ty(context); }
+llvm::Type* int16(llvm::LLVMContext& context) { return llvm::Type::getInt16Ty(context); }
+llvm::Type* int32(llvm::LLVMContext& context) { return llvm::Type::getInt32Ty(context); }
+llvm::Type* int64(llvm::LLVMContext& context) { return llvm::Type::getInt64Ty(context); }
+llvm::Type* float32(llvm::LLVMContext& context) { return llvm::Type::getFloatTy(context); }
+llvm::Type* float64(llvm::LLVMContext& context) { return llvm::Type::getDoubleTy(context); }
+llvm::Type* string(llvm::LLVMContext& context) { return llvm::PointerType::get(llvm::Type::getInt8Ty(context), 0); }
+llvm::Type* voidType(llvm::LLVMContext& context) { return llvm::Type::getVoidTy(context); }
+llvm::Type* module(llvm::LLVMContext& context) { return llvm::StructType::create(context, "module_t"); }
+
+}
@@ -1,4 +1,6 @@
 #include "type_inference.h"
+#include "type_descriptor.h"
+#include "bounds.h"
 #include <llvm/IR/Type.h>
 #include <llvm/IR/Value.h>
 
@@ -24,13 +26,8 @@ namespace AST {
                 return VarType::MODULE;
             }
             
-            if (globalVar->getValueType()->isStructTy()) {
-                if (auto* structType = llvm::dyn_cast<llvm::StructType>(globalVar->getValueType())) {
-                    std::string typeName = structType->getName().str();
-                    if (typeName.find("module_t") != std::string::npos) {
-                        return VarType::MODULE;
-                    }
-                }
+            if (globalVar->getValueType() == context.getLLVMType(VarType::MODULE)) {
+                return VarType::MODULE;
             }
         }
         
@@ -41,4 +38,28 @@ namespace AST {
         return value->getType()->isIntegerTy() || 
                value->getType()->isIntegerTy(1);
     }
-}
\ No newline at end of file
+
+    VarType resolvedSourceType(const Expr& expr, llvm::Value* value) {
+        VarType type = expr.getResolvedType();
+        const TypeDescriptor& desc = typeDescriptor(type);
+        llvm::Type* valueType = value->getType();
+
+        if (desc.hasRange) return valueType->isIntegerTy(desc.storageBits) ? type : VarType::VOID;
+        if (type == VarType::FLOAT32) return valueType->isFloatTy() ? type : VarType::VOID;
+        if (type == VarType::FLOAT64) return valueType->isDoubleTy() ? type : VarType::VOID;
+        if (type == VarType::STRING) return valueType->isPointerTy() ? type : VarType::VOID;
+        return VarType::VOID;
+    }
+
+    VarType sourceTypeOf(const Expr& expr, llvm::Value* value, CodeGen& context) {
+        VarType type = resolvedSourceType(expr, value);
+        return type != VarType::VOID ? type : inferSourceType(value, context);
+    }
+
+    llvm::Value* widenInteger(CodeGen& context, llvm::Value* value, llvm::Type* type, VarType sourceType) {
+        if (TypeBounds::isUnsignedType(sourceType) || sourceType == VarType::BOOL) {
+            return context.getBuilder().CreateZExt(value, type);
+        }
+        return context.getBuilder().CreateSExt(value, type);
+    }
+}
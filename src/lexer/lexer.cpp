@@ -1,10 +1,28 @@
 #include "lexer.h"
 #include <cctype>
 #include <stdexcept>
+#include <array>
+#include <cstdint>
+#include <limits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SUMMIT_LEXER_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SUMMIT_LEXER_SSE2 1
+#endif
 
 using namespace std;
 
-unordered_map<string, TokenType> Lexer::keywords = {
+namespace {
+
+struct Keyword {
+    string_view text;
+    TokenType type;
+};
+
+constexpr Keyword KEYWORDS[] = {
     {"var", TokenType::VAR}, {"const", TokenType::CONST}, {"as", TokenType::AS},
     {"bool", TokenType::BOOL}, {"true", TokenType::TRUE}, {"false", TokenType::FALSE},
     {"if", TokenType::IF}, {"then", TokenType::THEN}, {"else", TokenType::ELSE},
@@ -25,46 +43,207 @@ unordered_map<string, TokenType> Lexer::keywords = {
     {"f32", TokenType::FLOAT32}, {"f64", TokenType::FLOAT64}, {"str", TokenType::STRING}
 };
 
-Lexer::Lexer(const string& input) 
-    : input(input), position(0), line(1), column(1) {}
+constexpr size_t KEYWORD_COUNT = sizeof(KEYWORDS) / sizeof(KEYWORDS[0]);
+constexpr size_t KEYWORD_TABLE_SIZE = 128;
+constexpr size_t MIN_KEYWORD_LENGTH = 2;
+constexpr size_t MAX_KEYWORD_LENGTH = 6;
+
+/* Length plus first, second and last character; the multipliers were chosen so every
+   keyword lands in its own slot, which the static_assert below re-checks */
+constexpr size_t keywordHash(string_view text) {
+    return (text.size() + static_cast<unsigned char>(text[0]) * 13u +
+            static_cast<unsigned char>(text[1]) + static_cast<unsigned char>(text.back()) * 19u) %
+           KEYWORD_TABLE_SIZE;
+}
+
+/* Slot -> index into KEYWORDS, or -1 */
+constexpr array<int8_t, KEYWORD_TABLE_SIZE> buildKeywordSlots() {
+    array<int8_t, KEYWORD_TABLE_SIZE> slots{};
+    for (auto& slot : slots) slot = -1;
+    for (size_t i = 0; i < KEYWORD_COUNT; ++i) {
+        slots[keywordHash(KEYWORDS[i].text)] = static_cast<int8_t>(i);
+    }
+    return slots;
+}
+
+constexpr bool keywordHashIsPerfect() {
+    for (size_t i = 0; i < KEYWORD_COUNT; ++i) {
+        const auto& text = KEYWORDS[i].text;
+        if (text.size() < MIN_KEYWORD_LENGTH || text.size() > MAX_KEYWORD_LENGTH) return false;
+        for (size_t j = 0; j < i; ++j) {
+            if (keywordHash(KEYWORDS[j].text) == keywordHash(text)) return false;
+        }
+    }
+    return true;
+}
+
+static_assert(keywordHashIsPerfect(), "keyword hash collides; choose new multipliers in keywordHash");
+
+constexpr auto KEYWORD_SLOTS = buildKeywordSlots();
+
+inline bool isIdentifierChar(char c) {
+    return isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+/* Block classification: each character class below tests a whole register of bytes at once
+   (32 with AVX2, 16 with SSE2) and scanWhile skips the run with one compare per block.
+   Targets without either use the scalar loop, which is also used for the tail */
+#if defined(SUMMIT_LEXER_AVX2)
+using Block = __m256i;
+constexpr size_t BLOCK_SIZE = 32;
+inline Block loadBlock(const char* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+inline Block splat(char c) { return _mm256_set1_epi8(c); }
+inline Block equal(Block a, Block b) { return _mm256_cmpeq_epi8(a, b); }
+inline Block either(Block a, Block b) { return _mm256_or_si256(a, b); }
+inline Block minUnsigned(Block a, Block b) { return _mm256_min_epu8(a, b); }
+inline Block minus(Block a, Block b) { return _mm256_sub_epi8(a, b); }
+inline uint32_t bitmask(Block b) { return static_cast<uint32_t>(_mm256_movemask_epi8(b)); }
+#elif defined(SUMMIT_LEXER_SSE2)
+using Block = __m128i;
+constexpr size_t BLOCK_SIZE = 16;
+inline Block loadBlock(const char* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+inline Block splat(char c) { return _mm_set1_epi8(c); }
+inline Block equal(Block a, Block b) { return _mm_cmpeq_epi8(a, b); }
+inline Block either(Block a, Block b) { return _mm_or_si128(a, b); }
+inline Block minUnsigned(Block a, Block b) { return _mm_min_epu8(a, b); }
+inline Block minus(Block a, Block b) { return _mm_sub_epi8(a, b); }
+inline uint32_t bitmask(Block b) { return static_cast<uint32_t>(_mm_movemask_epi8(b)); }
+#endif
+
+#if defined(SUMMIT_LEXER_AVX2) || defined(SUMMIT_LEXER_SSE2)
+#define SUMMIT_LEXER_SIMD 1
+constexpr uint32_t FULL_MASK = BLOCK_SIZE == 32 ? 0xFFFFFFFFu : 0xFFFFu;
+
+/* Bytes in [lo, hi]: shift the range down to 0 and compare unsigned */
+inline Block inRange(Block v, char lo, char hi) {
+    Block shifted = minus(v, splat(lo));
+    return equal(minUnsigned(shifted, splat(static_cast<char>(hi - lo))), shifted);
+}
+
+inline unsigned lowestBit(uint32_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+#endif
+
+struct WhitespaceRun {
+    bool scalar(char c) const { return c == ' ' || (c >= '\t' && c <= '\r'); }
+#ifdef SUMMIT_LEXER_SIMD
+    Block block(Block v) const { return either(equal(v, splat(' ')), inRange(v, '\t', '\r')); }
+#endif
+};
+
+struct IdentifierRun {
+    bool scalar(char c) const { return isIdentifierChar(c); }
+#ifdef SUMMIT_LEXER_SIMD
+    Block block(Block v) const {
+        Block letters = inRange(either(v, splat(0x20)), 'a', 'z');
+        return either(either(letters, inRange(v, '0', '9')), equal(v, splat('_')));
+    }
+#endif
+};
+
+/* Anything except the given terminators and NUL (which peek() treats as end of input) */
+template <char A, char B = '\0', char C = '\0'>
+struct RunUntil {
+    bool scalar(char c) const { return c != A && c != B && c != C && c != '\0'; }
+#ifdef SUMMIT_LEXER_SIMD
+    Block block(Block v) const {
+        Block stop = either(either(equal(v, splat(A)), equal(v, splat(B))),
+                            either(equal(v, splat(C)), equal(v, splat('\0'))));
+        return equal(stop, splat(0));
+    }
+#endif
+};
+
+/* Index of the first character at or after pos that is not in run (text.size() if none) */
+template <typename Run>
+size_t scanWhile(string_view text, size_t pos, Run run) {
+#ifdef SUMMIT_LEXER_SIMD
+    while (pos + BLOCK_SIZE <= text.size()) {
+        uint32_t stops = ~bitmask(run.block(loadBlock(text.data() + pos))) & FULL_MASK;
+        if (stops) return pos + lowestBit(stops);
+        pos += BLOCK_SIZE;
+    }
+#endif
+    while (pos < text.size() && run.scalar(text[pos])) ++pos;
+    return pos;
+}
+
+/* Offsets just past every '\n', appended to lineStarts */
+void indexNewlines(string_view text, vector<uint32_t>& lineStarts) {
+    size_t pos = 0;
+#ifdef SUMMIT_LEXER_SIMD
+    const Block newline = splat('\n');
+    for (; pos + BLOCK_SIZE <= text.size(); pos += BLOCK_SIZE) {
+        uint32_t hits = bitmask(equal(loadBlock(text.data() + pos), newline));
+        while (hits) {
+            lineStarts.push_back(static_cast<uint32_t>(pos + lowestBit(hits) + 1));
+            hits &= hits - 1;
+        }
+    }
+#endif
+    for (; pos < text.size(); ++pos) {
+        if (text[pos] == '\n') lineStarts.push_back(static_cast<uint32_t>(pos + 1));
+    }
+}
+
+}
+
+TokenType Lexer::lookupKeyword(string_view ident) {
+    if (ident.size() < MIN_KEYWORD_LENGTH || ident.size() > MAX_KEYWORD_LENGTH) {
+        return TokenType::IDENTIFIER;
+    }
+    int8_t slot = KEYWORD_SLOTS[keywordHash(ident)];
+    if (slot >= 0 && KEYWORDS[slot].text == ident) {
+        return KEYWORDS[slot].type;
+    }
+    return TokenType::IDENTIFIER;
+}
+
+Lexer::Lexer(string_view input, StringInterner& symbols) 
+    : input(input), position(0), out(input, symbols), sink(&out) {
+    if (input.size() >= numeric_limits<uint32_t>::max()) {
+        throw runtime_error("Source file too large (tokens use 32-bit offsets)");
+    }
+    indexNewlines(input, out.lineStarts);
+}
 
 char Lexer::peek() {
     return position >= input.length() ? '\0' : input[position];
 }
 
+char Lexer::peekNext() {
+    return position + 1 >= input.length() ? '\0' : input[position + 1];
+}
+
 char Lexer::advance() {
-    if (position >= input.length()) return '\0';
-    char c = input[position++];
-    if (c == '\n') {
-        line++;
-        column = 1;
-    } else {
-        column++;
-    }
-    return c;
+    return position >= input.length() ? '\0' : input[position++];
 }
 
 void Lexer::skipWhitespace() {
-    while (isspace(peek())) advance();
+    position = scanWhile(input, position, WhitespaceRun{});
 }
 
 void Lexer::skipComment() {
     if (peek() == '/') {
         advance();
         if (peek() == '/') {
-            while (peek() != '\n' && peek() != '\0') advance();
+            position = scanWhile(input, position, RunUntil<'\n'>{});
         } else if (peek() == '*') {
             advance();
             while (true) {
+                position = scanWhile(input, position, RunUntil<'*'>{});
                 if (peek() == '\0') break;
-                if (peek() == '*') {
-                    advance();
-                    if (peek() == '/') {
-                        advance();
-                        break;
-                    }
-                } else {
+                advance();
+                if (peek() == '/') {
                     advance();
+                    break;
                 }
             }
         } else {
@@ -73,323 +252,351 @@ void Lexer::skipComment() {
     }
 }
 
-Token Lexer::readNumber() {
-    string number;
-    size_t startLine = line, startCol = column;
+void Lexer::emit(TokenType type, size_t start, uint32_t id) {
+    sink->tokens.push_back({type, static_cast<uint32_t>(start), static_cast<uint32_t>(position - start), id});
+}
+
+uint32_t Lexer::addLiteral(string text) {
+    sink->literals.push_back(move(text));
+    return static_cast<uint32_t>(sink->literals.size());
+}
+
+/* Numbers keep their lexeme unless it has '_' separators or an upper-case 0B/0X prefix */
+void Lexer::finishNumber(TokenType type, size_t start) {
+    string_view lexeme = input.substr(start, position - start);
+    bool upperPrefix = lexeme.size() > 1 && lexeme[0] == '0' && (lexeme[1] == 'B' || lexeme[1] == 'X');
+    if (!upperPrefix && lexeme.find('_') == string_view::npos) {
+        emit(type, start);
+        return;
+    }
+    string cooked;
+    cooked.reserve(lexeme.size());
+    for (char c : lexeme) {
+        if (c != '_') cooked += c;
+    }
+    if (upperPrefix) cooked[1] = static_cast<char>(tolower(cooked[1]));
+    emit(type, start, addLiteral(move(cooked)));
+}
+
+void Lexer::readNumber() {
+    size_t start = position;
     bool isFloat = false;
     
-    if (peek() == '0' && (input[position + 1] == 'b' || input[position + 1] == 'B')) {
+    if (peek() == '0' && (peekNext() == 'b' || peekNext() == 'B')) {
         advance(); advance();
-        number = "0b";
-        while (peek() == '0' || peek() == '1' || peek() == '_') {
-            if (peek() != '_') number += advance();
-            else advance();
-        }
-        if (number.length() <= 2) throw runtime_error("Invalid binary literal: " + number);
-        return Token(TokenType::NUMBER, number, startLine, startCol);
+        while (peek() == '0' || peek() == '1' || peek() == '_') advance();
+        finishNumber(TokenType::NUMBER, start);
+        string_view number = sink->text(sink->tokens.back());
+        if (number.length() <= 2) throw runtime_error("Invalid binary literal: " + string(number));
+        return;
     }
     
-    if (peek() == '0' && (input[position + 1] == 'x' || input[position + 1] == 'X')) {
+    if (peek() == '0' && (peekNext() == 'x' || peekNext() == 'X')) {
         advance(); advance();
-        number = "0x";
-        while (isxdigit(peek()) || peek() == '_') {
-            if (peek() != '_') number += advance();
-            else advance();
-        }
-        if (number.length() <= 2) throw runtime_error("Invalid hex literal: " + number);
-        return Token(TokenType::NUMBER, number, startLine, startCol);
+        while (isxdigit(peek()) || peek() == '_') advance();
+        finishNumber(TokenType::NUMBER, start);
+        string_view number = sink->text(sink->tokens.back());
+        if (number.length() <= 2) throw runtime_error("Invalid hex literal: " + string(number));
+        return;
     }
 
-    while (isdigit(peek()) || peek() == '_') {
-        if (peek() != '_') number += advance();
-        else advance();
-    }
+    while (isdigit(peek()) || peek() == '_') advance();
 
     if (peek() == '.') {
         isFloat = true;
-        number += advance();
-        while (isdigit(peek()) || peek() == '_') {
-            if (peek() != '_') number += advance();
-            else advance();
-        }
+        advance();
+        while (isdigit(peek()) || peek() == '_') advance();
     }
     
     if (peek() == 'e' || peek() == 'E') {
         isFloat = true;
-        number += advance();
-        if (peek() == '+' || peek() == '-') number += advance();
-        while (isdigit(peek()) || peek() == '_') {
-            if (peek() != '_') number += advance();
-            else advance();
-        }
+        advance();
+        if (peek() == '+' || peek() == '-') advance();
+        while (isdigit(peek()) || peek() == '_') advance();
     }
     
     if (isFloat) {
+        finishNumber(TokenType::FLOAT_LITERAL, start);
+        string_view number = sink->text(sink->tokens.back());
         if (number.empty() || number == "." || number.back() == 'e' || 
             number.back() == 'E' || number.back() == '+' || number.back() == '-') {
-            throw runtime_error("Invalid float literal: " + number);
+            throw runtime_error("Invalid float literal: " + string(number));
         }
-        return Token(TokenType::FLOAT_LITERAL, number, startLine, startCol);
     } else {
-        return Token(TokenType::NUMBER, number, startLine, startCol);
+        finishNumber(TokenType::NUMBER, start);
     }
 }
 
-Token Lexer::readString() {
-    string str;
-    size_t startLine = line, startCol = column;
+/* Cooked form of the escape sequence whose character follows a backslash in a quote-delimited string */
+static void appendEscape(string& out, char c, char quote) {
+    switch (c) {
+        case 'n': out += '\n'; break;
+        case 't': out += '\t'; break;
+        case '\\': out += '\\'; break;
+        default:
+            if (c == quote || (quote == '`' && (c == '{' || c == '}'))) {
+                out += c;
+            } else {
+                out += '\\'; out += c;
+            }
+            break;
+    }
+}
+
+/* "..." strings; the value is only copied out when it contains escapes */
+void Lexer::readString() {
+    size_t start = position;
+    bool hasEscapes = false;
     advance();
     
-    while (peek() != '"' && peek() != '\0') {
-        if (peek() == '\\') {
-            advance();
-            switch (peek()) {
-                case 'n': str += '\n'; break;
-                case 't': str += '\t'; break;
-                case '\\': str += '\\'; break;
-                case '"': str += '"'; break;
-                default: str += '\\'; str += peek(); break;
-            }
-            advance();
-        } else {
-            str += advance();
-        }
+    while (true) {
+        position = scanWhile(input, position, RunUntil<'"', '\\'>{});
+        if (peek() != '\\') break;
+        hasEscapes = true;
+        advance();
+        advance();
     }
     
-    if (peek() != '"') throw runtime_error("Unterminated string literal");
+    if (peek() != '"') {
+        throw runtime_error("Unterminated string literal");
+    }
     advance();
-    return Token(TokenType::STRING_LITERAL, str, startLine, startCol);
-}
 
-Token Lexer::readBacktickString() {
+    if (!hasEscapes) {
+        emit(TokenType::STRING_LITERAL, start);
+        return;
+    }
+
+    string_view body = input.substr(start + 1, position - start - 2);
     string str;
-    size_t startLine = line, startCol = column;
+    str.reserve(body.size());
+    for (size_t i = 0; i < body.size(); ++i) {
+        if (body[i] != '\\') {
+            str += body[i];
+            continue;
+        }
+        appendEscape(str, ++i < body.size() ? body[i] : '\0', '"');
+    }
+    emit(TokenType::STRING_LITERAL, start, addLiteral(move(str)));
+}
+
+/* `...` strings: the BACKTICK_STRING token, then for each {placeholder} its expression tokens
+   and a FORMAT_END. The literal text around the placeholders goes to the format pool, so
+   nothing downstream has to scan the string again */
+void Lexer::readFormatString() {
+    size_t start = position;
+    size_t stringToken = sink->tokens.size();
+    emit(TokenType::BACKTICK_STRING, start); /* length and format are filled in at the end */
     advance();
-    
-    while (peek() != '`' && peek() != '\0') {
-        if (peek() == '\\') {
+
+    TokenList::FormatString format;
+    string literal;
+    while (true) {
+        size_t runStart = position;
+        position = scanWhile(input, position, RunUntil<'`', '\\', '{'>{});
+        literal.append(input.substr(runStart, position - runStart));
+
+        char c = peek();
+        if (c == '\\') {
             advance();
-            switch (peek()) {
-                case 'n': str += '\n'; break;
-                case 't': str += '\t'; break;
-                case '\\': str += '\\'; break;
-                case '`': str += '`'; break;
-                case '{': str += '{'; break;
-                case '}': str += '}'; break;
-                default: str += '\\'; str += peek(); break;
+            appendEscape(literal, advance(), '`');
+            continue;
+        }
+        if (c != '{') break;
+
+        format.text += literal;
+        format.literals.push_back(move(literal));
+        literal.clear();
+
+        size_t open = position;
+        advance();
+        int depth = 0;
+        while (true) {
+            skipWhitespace();
+            char next = peek();
+            if (next == '\0' || next == '`') {
+                throw runtime_error("Unclosed '{' in format string");
             }
-            advance();
-        } else {
-            str += advance();
+            if (next == '}' && depth == 0) break;
+            scanToken();
+            TokenType type = sink->tokens.back().type;
+            if (type == TokenType::LBRACE) ++depth;
+            else if (type == TokenType::RBRACE) --depth;
         }
+        advance();
+        emit(TokenType::FORMAT_END, position - 1);
+        format.text.append(input.substr(open, position - open));
+    }
+
+    if (peek() != '`') {
+        throw runtime_error("Unterminated backtick string literal");
     }
-    
-    if (peek() != '`') throw runtime_error("Unterminated backtick string literal");
     advance();
-    return Token(TokenType::BACKTICK_STRING, str, startLine, startCol);
+
+    format.text += literal;
+    format.literals.push_back(move(literal));
+    sink->formats.push_back(move(format));
+
+    Token& token = sink->tokens[stringToken];
+    token.length = static_cast<uint32_t>(position - start);
+    token.id = static_cast<uint32_t>(sink->formats.size());
 }
 
-Token Lexer::readIdentifier() {
-    string ident;
-    size_t startLine = line, startCol = column;
+void Lexer::readIdentifier() {
+    size_t start = position;
     
-    while (isalnum(peek()) || peek() == '_') ident += advance();
+    position = scanWhile(input, position, IdentifierRun{});
     
-    auto it = keywords.find(ident);
-    return it != keywords.end() 
-        ? Token(it->second, ident, startLine, startCol)
-        : Token(TokenType::IDENTIFIER, ident, startLine, startCol);
+    string_view ident = input.substr(start, position - start);
+    TokenType type = lookupKeyword(ident);
+    emit(type, start, type == TokenType::IDENTIFIER ? sink->symbols().intern(ident) : 0);
 }
 
-Token Lexer::readBuiltin() {
-    string builtin;
-    size_t startLine = line, startCol = column;
+void Lexer::readBuiltin() {
+    size_t start = position;
     advance();
     
     if (!isalpha(peek()) && peek() != '_') {
         throw runtime_error("Expected identifier after '@'");
     }
 
-    while (isalnum(peek()) || peek() == '_') builtin += advance();
+    while (isalnum(peek()) || peek() == '_') advance();
     
-    if (builtin == "entrypoint") {
-        return Token(TokenType::ENTRYPOINT, "@entrypoint", startLine, startCol);
+    string_view builtin = input.substr(start, position - start);
+    if (builtin == "@entrypoint") {
+        emit(TokenType::ENTRYPOINT, start);
+        return;
     }
     
-    return Token(TokenType::BUILTIN, "@" + builtin, startLine, startCol);
+    emit(TokenType::BUILTIN, start, sink->symbols().intern(builtin));
 }
-vector<Token> Lexer::tokenize() {
-    vector<Token> tokens;
-    
-    while (position < input.length()) {
+TokenList Lexer::tokenize() {
+    /* Typical source averages well over 8 bytes per token, so this rarely regrows */
+    out.tokens.reserve(input.size() / 8 + 1);
+    lexInto(out, numeric_limits<size_t>::max());
+    return move(out);
+}
+
+TokenList Lexer::beginStream() {
+    return move(out);
+}
+
+size_t Lexer::lexInto(TokenList& list, size_t maxTokens) {
+    sink = &list;
+    size_t count = 0;
+    while (!finished && count < maxTokens) {
+        scanToken();
+        ++count;
+    }
+    return count;
+}
+
+void Lexer::scanToken() {
+    while (true) {
         skipWhitespace();
-        if (peek() == '/' && (input[position + 1] == '/' || input[position + 1] == '*')) {
+        if (peek() == '/' && (peekNext() == '/' || peekNext() == '*')) {
             skipComment();
             continue;
         }
+        break;
+    }
 
-        char c = peek();
-        if (c == '\0') break;
-        
-        size_t currentLine = line, currentCol = column;
-        
-        if (isdigit(c) || (c == '.' && isdigit(input[position + 1]))) {
-            tokens.push_back(readNumber());
-        } else if (c == '"') {
-            tokens.push_back(readString());
-        } else if (c == '`') {
-            tokens.push_back(readBacktickString());
-        } else if (isalpha(c) || c == '_') {
-            tokens.push_back(readIdentifier());
-        } else if (c == '@') {
-            tokens.push_back(readBuiltin());
-        } else {
-            switch (c) {
-                case '=': 
-                    advance(); 
-                    if (peek() == '=') {
-                        advance(); 
-                        tokens.push_back(Token(TokenType::EQUAL_EQUAL, "==", currentLine, currentCol));
-                    } else {
-                        tokens.push_back(Token(TokenType::EQUALS, "=", currentLine, currentCol));
-                    }
-                    break;
-                case '!': 
-                    advance(); 
-                    tokens.push_back(peek() == '=' 
-                        ? (advance(), Token(TokenType::NOT_EQUAL, "!=", currentLine, currentCol))
-                        : Token(TokenType::EXCLAMATION, "!", currentLine, currentCol)); 
-                    break;
-                case '<': 
-                    advance(); 
-                    if (peek() == '=') {
-                        advance(); 
-                        tokens.push_back(Token(TokenType::LESS_EQUAL, "<=", currentLine, currentCol));
-                    } else if (peek() == '<') {
-                        advance(); 
-                        tokens.push_back(Token(TokenType::LEFT_SHIFT, "<<", currentLine, currentCol));
-                    } else {
-                        tokens.push_back(Token(TokenType::LESS, "<", currentLine, currentCol));
-                    } 
-                    break;
-                case '>': 
-                    advance();
-                    if (peek() == '=') {
-                        advance(); 
-                        tokens.push_back(Token(TokenType::GREATER_EQUAL, ">=", currentLine, currentCol));
-                    } else if (peek() == '>') {
-                        advance(); 
-                        tokens.push_back(Token(TokenType::RIGHT_SHIFT, ">>", currentLine, currentCol));
-                    } else {
-                        tokens.push_back(Token(TokenType::GREATER, ">", currentLine, currentCol));
-                    } 
-                    break;
-                case '&': 
-                    advance(); 
-                    tokens.push_back(peek() == '&' 
-                        ? (advance(), Token(TokenType::AND_AND, "&&", currentLine, currentCol))
-                        : Token(TokenType::AMPERSAND, "&", currentLine, currentCol)); 
-                    break;
-                case '|': 
+    char c = peek();
+    if (c == '\0') {
+        emit(TokenType::END_OF_FILE, position);
+        finished = true;
+        return;
+    }
+
+    size_t start = position;
+    
+    if (isdigit(c) || (c == '.' && isdigit(peekNext()))) {
+        readNumber();
+    } else if (c == '"') {
+        readString();
+    } else if (c == '`') {
+        readFormatString();
+    } else if (isalpha(c) || c == '_') {
+        readIdentifier();
+    } else if (c == '@') {
+        readBuiltin();
+    } else {
+        advance();
+        switch (c) {
+            case '=': 
+                emit(peek() == '=' ? (advance(), TokenType::EQUAL_EQUAL) : TokenType::EQUALS, start);
+                break;
+            case '!': 
+                emit(peek() == '=' ? (advance(), TokenType::NOT_EQUAL) : TokenType::EXCLAMATION, start);
+                break;
+            case '<': 
+                if (peek() == '=') {
                     advance(); 
-                    tokens.push_back(peek() == '|' 
-                        ? (advance(), Token(TokenType::OR_OR, "||", currentLine, currentCol))
-                        : Token(TokenType::PIPE, "|", currentLine, currentCol)); 
-                    break;
-                case '^': 
-                    tokens.push_back(Token(TokenType::CARET, "^", currentLine, currentCol)); 
+                    emit(TokenType::LESS_EQUAL, start);
+                } else if (peek() == '<') {
                     advance(); 
-                    break;
-                case '~': 
-                    tokens.push_back(Token(TokenType::TILDE, "~", currentLine, currentCol)); 
+                    emit(TokenType::LEFT_SHIFT, start);
+                } else {
+                    emit(TokenType::LESS, start);
+                } 
+                break;
+            case '>': 
+                if (peek() == '=') {
                     advance(); 
-                    break;
-                case '%': 
-                    tokens.push_back(Token(TokenType::PERCENT, "%", currentLine, currentCol)); 
+                    emit(TokenType::GREATER_EQUAL, start);
+                } else if (peek() == '>') {
                     advance(); 
-                    break;
-                case '+': 
+                    emit(TokenType::RIGHT_SHIFT, start);
+                } else {
+                    emit(TokenType::GREATER, start);
+                } 
+                break;
+            case '&': 
+                emit(peek() == '&' ? (advance(), TokenType::AND_AND) : TokenType::AMPERSAND, start);
+                break;
+            case '|': 
+                emit(peek() == '|' ? (advance(), TokenType::OR_OR) : TokenType::PIPE, start);
+                break;
+            case '^': emit(TokenType::CARET, start); break;
+            case '~': emit(TokenType::TILDE, start); break;
+            case '%': emit(TokenType::PERCENT, start); break;
+            case '+': 
+                if (peek() == '=') {
                     advance();
-                    if (peek() == '=') {
-                        advance();
-                        tokens.push_back(Token(TokenType::PLUS_EQUALS, "+=", currentLine, currentCol));
-                    } else if (peek() == '+') {
-                        advance();
-                        tokens.push_back(Token(TokenType::INCREMENT, "++", currentLine, currentCol));
-                    } else {
-                        tokens.push_back(Token(TokenType::PLUS, "+", currentLine, currentCol));
-                    }
-                    break;
-                case '-': 
+                    emit(TokenType::PLUS_EQUALS, start);
+                } else if (peek() == '+') {
                     advance();
-                    if (peek() == '=') {
-                        advance();
-                        tokens.push_back(Token(TokenType::MINUS_EQUALS, "-=", currentLine, currentCol));
-                    } else if (peek() == '-') {
-                        advance();
-                        tokens.push_back(Token(TokenType::DECREMENT, "--", currentLine, currentCol));
-                    } else {
-                        tokens.push_back(Token(TokenType::MINUS, "-", currentLine, currentCol));
-                    }
-                    break;
-                case '*': 
+                    emit(TokenType::INCREMENT, start);
+                } else {
+                    emit(TokenType::PLUS, start);
+                }
+                break;
+            case '-': 
+                if (peek() == '=') {
                     advance();
-                    if (peek() == '=') {
-                        advance();
-                        tokens.push_back(Token(TokenType::STAR_EQUALS, "*=", currentLine, currentCol));
-                    } else {
-                        tokens.push_back(Token(TokenType::STAR, "*", currentLine, currentCol));
-                    }
-                    break;
-                case '/': 
+                    emit(TokenType::MINUS_EQUALS, start);
+                } else if (peek() == '-') {
                     advance();
-                    if (peek() == '=') {
-                        advance();
-                        tokens.push_back(Token(TokenType::SLASH_EQUALS, "/=", currentLine, currentCol));
-                    } else {
-                        tokens.push_back(Token(TokenType::SLASH, "/", currentLine, currentCol));
-                    }
-                    break;
-                case ':': 
-                    tokens.push_back(Token(TokenType::COLON, ":", currentLine, currentCol)); 
-                    advance(); 
-                    break;
-                case ';': 
-                    tokens.push_back(Token(TokenType::SEMICOLON, ";", currentLine, currentCol)); 
-                    advance(); 
-                    break;
-                case '(': 
-                    tokens.push_back(Token(TokenType::LPAREN, "(", currentLine, currentCol)); 
-                    advance(); 
-                    break;
-                case ')': 
-                    tokens.push_back(Token(TokenType::RPAREN, ")", currentLine, currentCol)); 
-                    advance(); 
-                    break;
-                case ',': 
-                    tokens.push_back(Token(TokenType::COMMA, ",", currentLine, currentCol)); 
-                    advance(); 
-                    break;
-                case '{': 
-                    tokens.push_back(Token(TokenType::LBRACE, "{", currentLine, currentCol)); 
-                    advance(); 
-                    break;
-                case '}': 
-                    tokens.push_back(Token(TokenType::RBRACE, "}", currentLine, currentCol)); 
-                    advance(); 
-                    break;
-                case '.': 
-                    tokens.push_back(Token(TokenType::DOT, ".", currentLine, currentCol)); 
-                    advance(); 
-                    break;
-                default: 
-                    tokens.push_back(Token(TokenType::UNKNOWN, string(1, c), currentLine, currentCol)); 
-                    advance(); 
-                    break;
-            }
+                    emit(TokenType::DECREMENT, start);
+                } else {
+                    emit(TokenType::MINUS, start);
+                }
+                break;
+            case '*': 
+                emit(peek() == '=' ? (advance(), TokenType::STAR_EQUALS) : TokenType::STAR, start);
+                break;
+            case '/': 
+                emit(peek() == '=' ? (advance(), TokenType::SLASH_EQUALS) : TokenType::SLASH, start);
+                break;
+            case ':': emit(TokenType::COLON, start); break;
+            case ';': emit(TokenType::SEMICOLON, start); break;
+            case '(': emit(TokenType::LPAREN, start); break;
+            case ')': emit(TokenType::RPAREN, start); break;
+            case ',': emit(TokenType::COMMA, start); break;
+            case '{': emit(TokenType::LBRACE, start); break;
+            case '}': emit(TokenType::RBRACE, start); break;
+            case '.': emit(TokenType::DOT, start); break;
+            default: emit(TokenType::UNKNOWN, start); break;
         }
     }
-    
-    tokens.push_back(Token(TokenType::END_OF_FILE, "", line, column));
-    return tokens;
-}
\ No newline at end of file
+}
@@ -1,10 +1,51 @@
 #include "token.h"
+#include <algorithm>
 #include <sstream>
+#include <unordered_map>
 
-Token::Token(TokenType t, const std::string& v, size_t l, size_t c)
-    : type(t), value(v), line(l), column(c) {}
+TokenList::TokenList(std::string_view source, StringInterner& symbols)
+    : lineStarts{0}, src(source), symbolTable(&symbols) {}
 
-std::string Token::toString() const {
+void TokenList::discardBefore(size_t index) {
+    if (index <= firstIndex) return;
+    size_t count = std::min(index - firstIndex, tokens.size());
+    tokens.erase(tokens.begin(), tokens.begin() + count);
+    firstIndex += count;
+}
+
+std::string_view TokenList::text(const Token& tok) const {
+    switch (tok.type) {
+        case TokenType::NUMBER:
+        case TokenType::FLOAT_LITERAL:
+            if (tok.id) return literals[tok.id - 1];
+            break;
+        case TokenType::BACKTICK_STRING:
+            return formats[tok.id - 1].text;
+        case TokenType::STRING_LITERAL:
+            if (tok.id) return literals[tok.id - 1];
+            return src.substr(tok.offset + 1, tok.length - 2);
+        default:
+            break;
+    }
+    return src.substr(tok.offset, tok.length);
+}
+
+SourceLocation TokenList::location(const Token& tok) const {
+    auto next = std::upper_bound(lineStarts.begin(), lineStarts.end(), tok.offset);
+    size_t line = next - lineStarts.begin();
+    return {line, tok.offset - lineStarts[line - 1] + 1};
+}
+
+std::string_view TokenList::lineText(size_t line) const {
+    if (line == 0 || line > lineStarts.size()) return {};
+    size_t start = lineStarts[line - 1];
+    size_t end = line < lineStarts.size() ? lineStarts[line] - 1 : src.size();
+    std::string_view text = src.substr(start, end - start);
+    if (!text.empty() && text.back() == '\r') text.remove_suffix(1);
+    return text;
+}
+
+std::string TokenList::describe(const Token& tok) const {
     static const std::unordered_map<TokenType, std::string> tokenTypeNames = {
         {TokenType::VAR, "VAR"}, {TokenType::CONST, "CONST"}, {TokenType::AS, "AS"},
         {TokenType::IF, "IF"}, {TokenType::THEN, "THEN"}, {TokenType::ELSE, "ELSE"}, {TokenType::ELSEIF, "ELSEIF"},
@@ -45,15 +86,16 @@ std::string Token::toString() const {
         
         {TokenType::COLON, "COLON"}, {TokenType::SEMICOLON, "SEMICOLON"}, {TokenType::LPAREN, "LPAREN"},
         {TokenType::RPAREN, "RPAREN"}, {TokenType::COMMA, "COMMA"}, {TokenType::BACKTICK_STRING, "BACKTICK_STRING"},
-        {TokenType::LBRACE, "LBRACE"}, {TokenType::RBRACE, "RBRACE"},
+        {TokenType::LBRACE, "LBRACE"}, {TokenType::RBRACE, "RBRACE"}, {TokenType::FORMAT_END, "FORMAT_END"},
         
         {TokenType::END_OF_FILE, "END_OF_FILE"}, {TokenType::UNKNOWN, "UNKNOWN"}
     };
 
-    auto it = tokenTypeNames.find(type);
+    auto it = tokenTypeNames.find(tok.type);
     std::string typeStr = (it != tokenTypeNames.end()) ? it->second : "UNKNOWN";
 
     std::ostringstream oss;
-    oss << typeStr << "('" << value << "') at line " << line << ", column " << column;
+    SourceLocation loc = location(tok);
+    oss << typeStr << "('" << text(tok) << "') at line " << loc.line << ", column " << loc.column;
     return oss.str();
-}
\ No newline at end of file
+}
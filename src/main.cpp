@@ -1,32 +1,33 @@
 #include <iostream>
-#include <fstream>
-#include <sstream>
 #include <cstdlib>
 #include <vector>
 #include <string>
 #include <algorithm>
 #include <stdexcept>
+#include <memory>
+#include <optional>
+#include <filesystem>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
 
 #include "lexer/lexer.h"
 #include "parser/parser.h"
 #include "codegen/codegen.h"
 #include "ast/ast.h"
+#include "ast/semantic_analyzer.h"
 #include "stdlib/core/stdlib_manager.h"
+#include "utils/object_cache.h"
+#include "utils/time_report.h"
+#include "utils/compile_server.h"
+#include "utils/source_buffer.h"
+#include "utils/trace.h"
 
 using namespace std;
 
 static constexpr const char* TOOL_VERSION = "0.1.0";
 
-string readFile(const string& filename) {
-    ifstream file(filename);
-    if (!file.is_open()) {
-        throw runtime_error("Could not open file: " + filename);
-    }
-    stringstream buffer;
-    buffer << file.rdbuf();
-    return buffer.str();
-}
-
 string getBaseFilename(const string& filename) {
     size_t lastslash = filename.find_last_of("/\\");
     string fname = (lastslash == string::npos) ? filename : filename.substr(lastslash + 1);
@@ -35,50 +36,149 @@ string getBaseFilename(const string& filename) {
     return fname.substr(0, lastdot);
 }
 
+/* Path, size and mtime; enough to notice a rebuilt library */
+string fileIdentity(const string& path) {
+    if (path.empty()) return "";
+    error_code ec;
+    string identity = path;
+    identity += ":" + to_string(filesystem::file_size(path, ec));
+    identity += ":" + to_string(filesystem::last_write_time(path, ec).time_since_epoch().count());
+    return identity;
+}
+
+/* Hash of everything that changes the emitted object */
+string objectCacheKey(string_view source, const CompileOptions& options) {
+    string cpu, features;
+    CodeGen::resolveCpuAndFeatures(options, cpu, features);
+    string triple = CodeGen::resolveTargetTriple(options.targetTriple);
+
+    string stdlibIdentity = "no-stdlib";
+    if (!options.noStdlib) {
+        string dllPath;
+        stdlibIdentity = fileIdentity(CodeGen::findStandardLibrary(triple, dllPath));
+        if (options.linkRuntimeBitcode) {
+            stdlibIdentity += "|" + fileIdentity(CodeGen::findRuntimeBitcode(triple));
+        }
+    }
+
+    string optLevel = to_string(static_cast<int>(options.optLevel));
+    return ObjectCache::computeKey({source, TOOL_VERSION, triple, cpu, features, optLevel, stdlibIdentity});
+}
+
+void runExecutable(const string& outputName, bool verbose) {
+#ifdef _WIN32
+    string runCmd = outputName;
+#else
+    string runCmd = "./" + outputName;
+#endif
+    if (verbose) cerr << "Running: " << runCmd << "\n";
+    int r = system(runCmd.c_str());
+    if (verbose && r != 0) {
+        cerr << "Program exited with code: " << r << "\n";
+    }
+}
+
 void printHelp(const string& prog) {
-    cout << "Usage: " << prog << " [options] <source.sm>\n\n";
+    cout << "Usage: " << prog << " [options] <source.sm>\n";
+    cout << "       " << prog << " run [options] <source.sm>   JIT-compile and run in-process\n";
+    cout << "       " << prog << " build [options] <a.sm> <b.sm> ... [-jN]   Compile many files in parallel\n";
+    cout << "       " << prog << " --server [--socket <path>]   Serve compile requests from a warm process\n";
+    cout << "       " << prog << " --connect [--socket <path>] [options] <source.sm>   Compile through the server\n\n";
     cout << "Options:\n";
     cout << "  -o <file>           Set output executable name (default: <source base>)\n";
     cout << "  --target <triple>   Target triple (e.g., x86_64-pc-linux-gnu, x86_64-w64-windows-gnu)\n";
+    cout << "  -O0|-O1|-O2|-O3|-Os Optimization level (default: -O0)\n";
+    cout << "  --cpu <name>        Target CPU (default: generic)\n";
+    cout << "  --features <list>   Target features, e.g. +avx2,+bmi2,-avx512f\n";
+    cout << "  -march=<cpu>        Same as --cpu; -march=native tunes for the host\n";
+    cout << "  --linker=<kind>     lld (in-process, default) or external (clang++/g++)\n";
+    cout << "  --cache             Reuse cached objects for unchanged sources (also: $SUMMIT_CACHE_DIR)\n";
+    cout << "  --cache-dir <dir>   Object cache directory (implies --cache)\n";
+    cout << "  --cache-size <MB>   Object cache size limit, LRU evicted (default: 1024)\n";
+    cout << "  -j<N>, --jobs <N>   Worker threads for 'build' (default: hardware threads)\n";
     cout << "  --ir                Print generated IR to stdout\n";
     cout << "  --tokens            Print lexer tokens\n";
+    cout << "  --stream-tokens     Lex on demand while parsing; memory stays flat for very large inputs\n";
     cout << "  --ast               Print AST\n";
     cout << "  --emit-ir-only      Emit IR file and exit\n";
     cout << "  --keep-ir           Keep the generated IR file\n";
     cout << "  --run               Run the produced executable after successful build\n";
     cout << "  --verbose           Print extra compilation info\n";
+    cout << "  --trace=<cats>[:N]  Trace compiler internals: scope,call,struct,module,var,func,parse or all;\n";
+    cout << "                      level 1 (default) or 2 for per-expression detail\n";
+    cout << "  --trace-file <path> Write trace output to a file instead of stderr\n";
+    cout << "  --time-report[=json] Print per-phase wall/CPU time, peak RSS and sizes to stderr\n";
     cout << "  --no-stdlib         Compile without linking the standard library\n";
+    cout << "  --no-runtime-bc     Call libsummit externally instead of linking libsummit.bc\n";
+    cout << "  --socket <path>     Server socket (default: $SUMMIT_SERVER_SOCKET or <tmp>/summit-<uid>.sock)\n";
     cout << "  --version           Print version and exit\n";
     cout << "  --help              Show this help\n";
     cout << "\nExample:\n  " << prog << " -o myprog --run hello.sm\n";
     cout << "  " << prog << " --target x86_64-pc-linux-gnu -o hello_linux hello.sm\n";
     cout << "  " << prog << " --no-stdlib -o minimal minimal.sm\n";
+    cout << "  " << prog << " -O2 -o fast hello.sm\n";
+    cout << "  " << prog << " -O3 -march=native -o tuned hello.sm\n";
+    cout << "  " << prog << " run hello.sm\n";
+    cout << "  " << prog << " build -O2 -j16 a.sm b.sm c.sm\n";
 }
 
-int main(int argc, char* argv[]) {
-    if (argc < 2) {
-        cerr << "Usage: " << argv[0] << " <source file> [options]\n";
-        cerr << "Try '--help' for more information.\n";
-        return 1;
-    }
-
-    string inputFilename;
+/* Everything the driver reads from the command line */
+struct DriverOptions {
+    vector<string> inputFilenames;
     string outputName;
     string targetTriple;
+    string cpu;
+    string features;
     bool printIR = false;
     bool printTokens = false;
+    bool streamTokens = false;
     bool printAST = false;
     bool emitIROnly = false;
     bool keepIR = false;
     bool runAfter = false;
     bool verbose = false;
     bool noStdlib = false;
+    bool externalLinker = false;
+    bool linkRuntimeBitcode = true;
+    bool jitRun = false;
+    bool batchBuild = false;
+    bool useCache = getenv("SUMMIT_CACHE_DIR") != nullptr;
+    string cacheDir;
+    uint64_t cacheSizeMB = 1024;
+    unsigned jobs = 0;
+    OptLevel optLevel = OptLevel::O0;
+    string timeReportFormat; /* "", "text" or "json" */
+    string traceSpec; /* --trace=; process-wide, so applied by the local driver only */
+    string traceFile;
+    string artifactDir; /* --server: outputs go to the request's private directory */
+
+    CompileOptions toCompileOptions() const {
+        CompileOptions compileOptions;
+        compileOptions.targetTriple = targetTriple;
+        compileOptions.cpu = cpu;
+        compileOptions.features = features;
+        compileOptions.optLevel = optLevel;
+        compileOptions.verbose = verbose;
+        compileOptions.noStdlib = noStdlib;
+        compileOptions.externalLinker = externalLinker;
+        compileOptions.linkRuntimeBitcode = linkRuntimeBitcode;
+        return compileOptions;
+    }
+};
 
-    vector<string> args(argv + 1, argv + argc);
+/* Parse driver arguments; returns -1 to continue, otherwise the exit code */
+int parseArguments(vector<string> args, const string& prog, DriverOptions& opts) {
+    if (!args.empty() && args[0] == "run") {
+        opts.jitRun = true;
+        args.erase(args.begin());
+    } else if (!args.empty() && args[0] == "build") {
+        opts.batchBuild = true;
+        args.erase(args.begin());
+    }
 
     for (const string& a : args) {
         if (a == "--help" || a == "-h") {
-            printHelp(argv[0]);
+            printHelp(prog);
             return 0;
         }
         if (a == "--version") {
@@ -90,42 +190,138 @@ int main(int argc, char* argv[]) {
     for (size_t i = 0; i < args.size(); ++i) {
         const string& a = args[i];
 
-        if (a == "--ir") { printIR = true; }
-        else if (a == "--tokens") { printTokens = true; }
-        else if (a == "--ast") { printAST = true; }
-        else if (a == "--emit-ir-only") { emitIROnly = true; }
-        else if (a == "--keep-ir") { keepIR = true; }
-        else if (a == "--run") { runAfter = true; }
-        else if (a == "--verbose") { verbose = true; }
-        else if (a == "--no-stdlib") { noStdlib = true; }
+        if (a == "--ir") { opts.printIR = true; }
+        else if (a == "--tokens") { opts.printTokens = true; }
+        else if (a == "--stream-tokens") { opts.streamTokens = true; }
+        else if (a == "--ast") { opts.printAST = true; }
+        else if (a == "--emit-ir-only") { opts.emitIROnly = true; }
+        else if (a == "--keep-ir") { opts.keepIR = true; }
+        else if (a == "--run") { opts.runAfter = true; }
+        else if (a == "--verbose") { opts.verbose = true; }
+        else if (a == "--no-stdlib") { opts.noStdlib = true; }
+        else if (a == "--no-runtime-bc") { opts.linkRuntimeBitcode = false; }
+        else if (a == "-O0") { opts.optLevel = OptLevel::O0; }
+        else if (a == "-O1") { opts.optLevel = OptLevel::O1; }
+        else if (a == "-O2") { opts.optLevel = OptLevel::O2; }
+        else if (a == "-O3") { opts.optLevel = OptLevel::O3; }
+        else if (a == "-Os") { opts.optLevel = OptLevel::Os; }
         else if (a == "-o") {
             if (i + 1 >= args.size()) { cerr << "-o expects a value\n"; return 1; }
-            outputName = args[++i];
+            opts.outputName = args[++i];
         }
         else if (a == "--target") {
             if (i + 1 >= args.size()) { cerr << "--target expects a value\n"; return 1; }
-            targetTriple = args[++i];
+            opts.targetTriple = args[++i];
+        }
+        else if (a == "--cpu") {
+            if (i + 1 >= args.size()) { cerr << "--cpu expects a value\n"; return 1; }
+            opts.cpu = args[++i];
+        }
+        else if (a == "--features") {
+            if (i + 1 >= args.size()) { cerr << "--features expects a value\n"; return 1; }
+            opts.features = args[++i];
+        }
+        else if (a == "--cache") { opts.useCache = true; }
+        else if (a == "--cache-dir") {
+            if (i + 1 >= args.size()) { cerr << "--cache-dir expects a value\n"; return 1; }
+            opts.cacheDir = args[++i];
+            opts.useCache = true;
+        }
+        else if (a == "--cache-size") {
+            if (i + 1 >= args.size()) { cerr << "--cache-size expects a value\n"; return 1; }
+            try {
+                opts.cacheSizeMB = stoull(args[++i]);
+            } catch (const exception&) {
+                cerr << "--cache-size expects a number of megabytes\n";
+                return 1;
+            }
+        }
+        else if (a == "-j" || a == "--jobs" || (a.rfind("-j", 0) == 0 && a.size() > 2)) {
+            string value;
+            if (a.size() > 2 && a[1] == 'j') {
+                value = a.substr(2);
+            } else {
+                if (i + 1 >= args.size()) { cerr << a << " expects a value\n"; return 1; }
+                value = args[++i];
+            }
+            try {
+                opts.jobs = static_cast<unsigned>(stoul(value));
+            } catch (const exception&) {
+                cerr << a << " expects a number of jobs\n";
+                return 1;
+            }
+        }
+        else if (a.rfind("--trace=", 0) == 0) { opts.traceSpec = a.substr(8); }
+        else if (a == "--trace-file") {
+            if (i + 1 >= args.size()) { cerr << "--trace-file expects a value\n"; return 1; }
+            opts.traceFile = args[++i];
+        }
+        else if (a == "--time-report") { opts.timeReportFormat = "text"; }
+        else if (a == "--time-report=json") { opts.timeReportFormat = "json"; }
+        else if (a == "--linker=external") { opts.externalLinker = true; }
+        else if (a == "--linker=lld") { opts.externalLinker = false; }
+        else if (a.rfind("-march=", 0) == 0) {
+            opts.cpu = a.substr(7);
+            if (opts.cpu.empty()) { cerr << "-march= expects a value\n"; return 1; }
         }
         else if (!a.empty() && a[0] == '-') {
             cerr << "Unknown option: " << a << "\n";
             cerr << "Try '--help' for a list of supported options.\n";
             return 1;
         }
+        else if (opts.batchBuild) {
+            opts.inputFilenames.push_back(a);
+        }
         else {
-            inputFilename = a;
+            opts.inputFilenames.assign(1, a);
         }
     }
 
-    if (inputFilename.empty()) {
+    if (opts.inputFilenames.empty()) {
         cerr << "No input file provided.\n";
-        cerr << "Usage: " << argv[0] << " <source file> [--help]\n";
+        cerr << "Usage: " << prog << " <source file> [--help]\n";
         return 1;
     }
 
+    if (opts.inputFilenames.size() > 1) {
+        if (!opts.outputName.empty()) {
+            cerr << "-o cannot be used with multiple input files\n";
+            return 1;
+        }
+        if (opts.runAfter) {
+            cerr << "--run cannot be used with multiple input files\n";
+            return 1;
+        }
+
+        /* Outputs are named after the input's base name, so two inputs must not share one */
+        unordered_map<string, const string*> outputOwners;
+        for (const string& input : opts.inputFilenames) {
+            auto [owner, inserted] = outputOwners.emplace(getBaseFilename(input), &input);
+            if (!inserted) {
+                cerr << "Inputs " << *owner->second << " and " << input << " would both be built as '"
+                     << owner->first << "'; build them separately\n";
+                return 1;
+            }
+        }
+    }
+
+    return -1;
+}
+
+/* Lex, parse, generate and link a single source file; returns the exit code */
+int compileFileTimed(const DriverOptions& opts, const string& inputFilename, string outputName,
+                     TimeReport* timeReport) {
+    bool verbose = opts.verbose;
+    bool noStdlib = opts.noStdlib;
+
     try {
         string baseName = getBaseFilename(inputFilename);
         if (outputName.empty()) outputName = baseName;
         string irFilename = baseName + ".ll";
+        if (!opts.artifactDir.empty()) {
+            outputName = (filesystem::path(opts.artifactDir) / outputName).string();
+            irFilename = (filesystem::path(opts.artifactDir) / irFilename).string();
+        }
 
         if (verbose) {
             cerr << "Input: " << inputFilename << "\n";
@@ -135,78 +331,369 @@ int main(int argc, char* argv[]) {
             }
         }
 
-        string source = readFile(inputFilename);
+        TimeReport::Scope readPhase(timeReport, "read");
+        SourceBuffer sourceBuffer = SourceBuffer::fromFile(inputFilename);
+        string_view source = sourceBuffer.text();
+        readPhase.stop();
+        if (timeReport) timeReport->setCounter("source_bytes", source.size());
+
+        CompileOptions compileOptions = opts.toCompileOptions();
+        compileOptions.timeReport = timeReport;
+
+        /* Only plain builds are cached; the inspection flags need the front end to run */
+        unique_ptr<ObjectCache> objectCache;
+        string cacheKey;
+        if (opts.useCache && !opts.jitRun && !opts.printTokens && !opts.printAST && !opts.printIR &&
+            !opts.keepIR && !opts.emitIROnly) {
+            TimeReport::Scope cachePhase(timeReport, "cache");
+            objectCache = make_unique<ObjectCache>(
+                opts.cacheDir.empty() ? ObjectCache::defaultDirectory() : opts.cacheDir,
+                opts.cacheSizeMB * 1024 * 1024);
+            cacheKey = objectCacheKey(source, compileOptions);
+
+            llvm::SmallVector<char, 0> cachedObject;
+            bool hit = objectCache->lookup(cacheKey, cachedObject);
+            cachePhase.stop();
+            if (verbose) {
+                cerr << "Object cache: " << (hit ? "hit" : "miss") << " " << cacheKey.substr(0, 16)
+                     << " (hits: " << objectCache->getHits() << ", misses: " << objectCache->getMisses()
+                     << ", dir: " << objectCache->getDirectory() << ")\n";
+            }
+
+            if (hit) {
+                if (!CodeGen::linkObject(cachedObject, outputName, compileOptions)) {
+                    cerr << "Failed to compile executable.\n";
+                    return 1;
+                }
+                cout << "Compiled successfully: " << outputName << "\n";
+                if (opts.runAfter) runExecutable(outputName, verbose);
+                return 0;
+            }
+        }
 
-        Lexer lexer(source);
-        auto tokens = lexer.tokenize();
+        StringInterner symbols;
+        Lexer lexer(source, symbols);
+        optional<Parser> parser;
+        bool streaming = opts.streamTokens && !opts.printTokens;
+        if (streaming) {
+            parser.emplace(lexer);
+        } else {
+            TimeReport::Scope lexPhase(timeReport, "lex");
+            TokenList tokens = lexer.tokenize();
+            lexPhase.stop();
 
-        if (printTokens) {
-            for (const auto& token : tokens) {
-                cout << token.toString() << endl;
+            if (opts.printTokens) {
+                for (const auto& token : tokens) {
+                    cout << tokens.describe(token) << endl;
+                }
             }
+            parser.emplace(move(tokens));
         }
 
-        Parser parser(move(tokens), source);
-        auto ast = parser.parse();
+        /* When streaming, lexing happens inside this phase */
+        TimeReport::Scope parsePhase(timeReport, streaming ? "lex+parse" : "parse");
+        AST::constructedNodeCount = 0;
+        auto ast = parser->parse();
+        parsePhase.stop();
+        if (timeReport) {
+            timeReport->setCounter("tokens", parser->tokenCount());
+            timeReport->setCounter("ast_nodes", AST::constructedNodeCount);
+            timeReport->setCounter("ast_arena_bytes", ast->getArena().bytesAllocated());
+        }
 
-        if (printAST) {
+        if (opts.printAST) {
             cout << ast->toString() << endl;
         }
 
-        CodeGen codegen;
+        TimeReport::Scope semaPhase(timeReport, "sema");
+        AST::SemanticAnalyzer().analyze(*ast);
+        semaPhase.stop();
+
+        TimeReport::Scope codegenPhase(timeReport, "codegen");
+        CodeGen codegen(symbols);
 
-        codegen.setGlobalVariables(parser.getGlobalVariables());
+        codegen.setGlobalVariables(parser->getGlobalVariables());
+        codegen.setStdlibEnabled(!noStdlib);
         
         if (!noStdlib) {
             StdLibManager::getInstance().initializeStandardLibrary(!noStdlib);
         }
         
         ast->codegen(codegen);
+        codegenPhase.stop();
 
-        if (printIR) {
+        if (timeReport) {
+            uint64_t functions = 0, instructions = 0;
+            CodeGen::countIR(codegen.getModule(), functions, instructions);
+            timeReport->setCounter("ir_functions", functions);
+            timeReport->setCounter("ir_instructions", instructions);
+        }
+
+        if (opts.printIR) {
             codegen.printIR();
         }
 
-        if (keepIR || emitIROnly) {
+        if (opts.keepIR || opts.emitIROnly) {
             codegen.printIRToFile(irFilename);
             if (verbose) cout << "IR saved to: " << irFilename << "\n";
         }
 
-        if (emitIROnly) {
+        if (opts.emitIROnly) {
             return 0;
         }
 
+        if (opts.jitRun) {
+            if (verbose) cerr << "Running in JIT...\n";
+            int exitCode = codegen.runJIT(compileOptions);
+            if (verbose && exitCode != 0) {
+                cerr << "Program exited with code: " << exitCode << "\n";
+            }
+            return exitCode;
+        }
+
         if (verbose) {
             cout << "Compiling to executable...\n";
-            if (!targetTriple.empty()) {
-                cout << "Target: " << targetTriple << "\n";
+            if (!opts.targetTriple.empty()) {
+                cout << "Target: " << opts.targetTriple << "\n";
             }
         }
 
-        if (!codegen.compileToExecutable(outputName, verbose, targetTriple, noStdlib)) {
+        llvm::SmallVector<char, 0> objBuffer;
+        if (!codegen.emitObject(objBuffer, compileOptions)) {
             cerr << "Failed to compile executable.\n";
             return 1;
         }
 
-        cout << "Compiled successfully: " << outputName << "\n";
+        if (objectCache) {
+            objectCache->store(cacheKey, objBuffer);
+        }
 
-        if (runAfter) {
-#ifdef _WIN32
-            string runCmd = outputName;
-#else
-            string runCmd = "./" + outputName;
-#endif
-            if (verbose) cerr << "Running: " << runCmd << "\n";
-            int r = system(runCmd.c_str());
-            if (verbose && r != 0) {
-                cerr << "Program exited with code: " << r << "\n";
-            }
+        if (!CodeGen::linkObject(objBuffer, outputName, compileOptions)) {
+            cerr << "Failed to compile executable.\n";
+            return 1;
         }
 
+        cout << "Compiled successfully: " << outputName << "\n";
+
+        if (opts.runAfter) runExecutable(outputName, verbose);
+
     } catch (const exception& e) {
         cerr << "Compilation error: " << e.what() << endl;
         return 1;
     }
 
     return 0;
-}
\ No newline at end of file
+}
+
+int compileFile(const DriverOptions& opts, const string& inputFilename, const string& outputName) {
+    if (opts.timeReportFormat.empty()) {
+        return compileFileTimed(opts, inputFilename, outputName, nullptr);
+    }
+
+    TimeReport timeReport(inputFilename);
+    int result = compileFileTimed(opts, inputFilename, outputName, &timeReport);
+
+    /* One write per report so parallel builds don't interleave lines */
+    static mutex reportMutex;
+    lock_guard<mutex> lock(reportMutex);
+    cerr << (opts.timeReportFormat == "json" ? timeReport.toJSON() + "\n" : timeReport.toText());
+    cerr.flush();
+    return result;
+}
+
+/* Compile every input on a pool of workers, each with its own LLVMContext/CodeGen */
+int buildAll(const DriverOptions& opts) {
+    const auto& inputs = opts.inputFilenames;
+    unsigned jobs = opts.jobs ? opts.jobs : max(1u, thread::hardware_concurrency());
+    jobs = min<unsigned>(jobs, static_cast<unsigned>(inputs.size()));
+
+    /* Shared, process-wide state is set up once before any worker starts */
+    CodeGen::initializeTargets();
+    if (!opts.noStdlib) {
+        StdLibManager::getInstance().initializeStandardLibrary(true);
+    }
+
+    vector<int> results(inputs.size(), 0);
+    atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (size_t i = next++; i < inputs.size(); i = next++) {
+            results[i] = compileFile(opts, inputs[i], opts.outputName);
+        }
+    };
+
+    if (jobs <= 1) {
+        worker();
+    } else {
+        vector<thread> pool;
+        for (unsigned t = 0; t < jobs; ++t) pool.emplace_back(CompileServer::inheritOutput(worker));
+        for (auto& th : pool) th.join();
+    }
+
+    size_t failed = 0;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        if (results[i] != 0) {
+            cerr << "Failed: " << inputs[i] << "\n";
+            ++failed;
+        }
+    }
+    if (inputs.size() > 1 || opts.verbose) {
+        cerr << "Built " << (inputs.size() - failed) << "/" << inputs.size() << " files with "
+             << jobs << (jobs == 1 ? " job" : " jobs") << "\n";
+    }
+    return failed ? 1 : 0;
+}
+
+/* Trace settings are process-wide; returns -1 to continue, otherwise the exit code */
+int applyTraceOptions(const DriverOptions& opts) {
+    string error;
+    if (!opts.traceSpec.empty() && !Trace::configure(opts.traceSpec, error)) {
+        cerr << "--trace: " << error << "\n";
+        return 1;
+    }
+    if (!opts.traceFile.empty() && !Trace::setOutputFile(opts.traceFile, error)) {
+        cerr << "--trace-file: " << error << "\n";
+        return 1;
+    }
+    return -1;
+}
+
+/* Server side of --connect: inputs were written to workDir, artifacts are collected from it */
+int serveRequest(const vector<string>& args, const string& workDir) {
+    DriverOptions opts;
+    int status = parseArguments(args, "summit", opts);
+    if (status >= 0) {
+        return status;
+    }
+    if (opts.jitRun) {
+        cerr << "'run' is not available through the server\n";
+        return 1;
+    }
+    /* They would change the server for every later and concurrent request */
+    if (!opts.traceSpec.empty() || !opts.traceFile.empty()) {
+        cerr << "--trace and --trace-file are not available through the server\n";
+        return 1;
+    }
+
+    for (auto& input : opts.inputFilenames) {
+        input = (filesystem::path(workDir) / input).string();
+    }
+    if (!opts.outputName.empty()) {
+        opts.outputName = filesystem::path(opts.outputName).filename().string();
+    }
+    opts.artifactDir = workDir;
+    opts.runAfter = false;
+
+    if (opts.batchBuild) {
+        return buildAll(opts);
+    }
+    return compileFile(opts, opts.inputFilenames.front(), opts.outputName);
+}
+
+int runServer(const string& socketPath) {
+    /* Pay for target and stdlib setup once, not per request; --no-stdlib requests opt out
+       through CodeGen::setStdlibEnabled */
+    CodeGen::initializeTargets();
+    StdLibManager::getInstance().initializeStandardLibrary(true);
+    return CompileServer::serve(socketPath, serveRequest);
+}
+
+/* Client side of --connect; returns -1 to compile locally instead */
+int forwardToServer(const vector<string>& args, const string& prog, const string& socketPath) {
+    DriverOptions opts;
+    int status = parseArguments(args, prog, opts);
+    if (status >= 0) {
+        return status;
+    }
+    /* Tracing covers this process only, so those compiles stay local */
+    if (opts.jitRun || !opts.traceSpec.empty() || !opts.traceFile.empty()) {
+        return -1;
+    }
+
+    /* The server sees inputs by file name only and resolves other paths against its own
+       working directory, so --cache-dir is made absolute here; --run happens here, not on
+       the server */
+    vector<string> remoteArgs;
+    for (size_t i = 0; i < args.size(); ++i) {
+        const string& a = args[i];
+        if (a == "--run") continue;
+        if (a == "--cache-dir" && i + 1 < args.size()) {
+            remoteArgs.push_back(a);
+            remoteArgs.push_back(filesystem::absolute(args[++i]).string());
+        } else if (find(opts.inputFilenames.begin(), opts.inputFilenames.end(), a) != opts.inputFilenames.end()) {
+            remoteArgs.push_back(filesystem::path(a).filename().string());
+        } else {
+            remoteArgs.push_back(a);
+        }
+    }
+
+    string outputName = opts.outputName;
+    auto placeArtifact = [&outputName](const string& name) {
+        if (!outputName.empty() && name.rfind(filesystem::path(outputName).filename().string(), 0) == 0) {
+            return (filesystem::path(outputName).parent_path() / name).string();
+        }
+        return name;
+    };
+
+    int exitCode;
+    try {
+        exitCode = CompileServer::forward(socketPath, remoteArgs, opts.inputFilenames, placeArtifact);
+    } catch (const exception& e) {
+        cerr << "Compilation error: " << e.what() << endl;
+        return 1;
+    }
+    if (exitCode < 0) {
+        if (opts.verbose) cerr << "No summit server on " << socketPath << ", compiling locally\n";
+        return -1;
+    }
+
+    if (exitCode == 0 && opts.runAfter) {
+        runExecutable(outputName.empty() ? getBaseFilename(opts.inputFilenames.front()) : outputName, opts.verbose);
+    }
+    return exitCode;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cerr << "Usage: " << argv[0] << " <source file> [options]\n";
+        cerr << "Try '--help' for more information.\n";
+        return 1;
+    }
+
+    /* Server options are handled here; everything else goes to parseArguments */
+    vector<string> args;
+    bool serverMode = false, connectMode = false;
+    string socketPath;
+    for (int i = 1; i < argc; ++i) {
+        string a = argv[i];
+        if (a == "--server") { serverMode = true; }
+        else if (a == "--connect") { connectMode = true; }
+        else if (a == "--socket") {
+            if (i + 1 >= argc) { cerr << "--socket expects a value\n"; return 1; }
+            socketPath = argv[++i];
+        }
+        else { args.push_back(a); }
+    }
+    if (socketPath.empty()) socketPath = CompileServer::defaultSocketPath();
+
+    if (serverMode) {
+        return runServer(socketPath);
+    }
+    if (connectMode) {
+        int status = forwardToServer(args, argv[0], socketPath);
+        if (status >= 0) {
+            return status;
+        }
+    }
+
+    DriverOptions opts;
+    int status = parseArguments(args, argv[0], opts);
+    if (status < 0) status = applyTraceOptions(opts);
+    if (status >= 0) {
+        return status;
+    }
+
+    if (opts.batchBuild) {
+        return buildAll(opts);
+    }
+    return compileFile(opts, opts.inputFilenames.front(), opts.outputName);
+}
@@ -18,7 +18,7 @@ unique_ptr<Expr> Parser::parseCastExpression() {
 }
 
 unique_ptr<Expr> Parser::parsePrimary() {
-    const Token& tok = peek();
+    Token tok = peek();
 
     if (check(TokenType::ENTRYPOINT)) {
         error("@entrypoint should be used as a standalone statement, not in an expression");
@@ -28,15 +28,15 @@ unique_ptr<Expr> Parser::parsePrimary() {
         return parseStructLiteral();
     }
 
-    if (check(TokenType::BUILTIN) || (check(TokenType::IDENTIFIER) && peek().value == "@get")) {
+    if (check(TokenType::BUILTIN) || (check(TokenType::IDENTIFIER) && text(peek()) == "@get")) {
         return parseBuiltinCall();
     }
 
     if (match(TokenType::NUMBER)) 
-        return make_unique<NumberExpr>(tokens[current - 1].value);
+        return make_unique<NumberExpr>(string(text(previous())));
 
     if (match(TokenType::FLOAT_LITERAL)) {
-        string floatStr = tokens[current - 1].value;
+        string floatStr(text(previous()));
         try {
             double value = stod(floatStr);
             return make_unique<FloatExpr>(value, VarType::FLOAT64);
@@ -46,13 +46,18 @@ unique_ptr<Expr> Parser::parsePrimary() {
     }
 
     if (match(TokenType::STRING_LITERAL)) {
-        return make_unique<StringExpr>(tokens[current - 1].value);
+        return make_unique<StringExpr>(string(text(previous())));
     }
 
     if (match(TokenType::BACKTICK_STRING)) {
-        string formatStr = tokens[current - 1].value;
-        vector<unique_ptr<Expr>> expressions = extractExpressionsFromFormat(formatStr);
-        return make_unique<FormatStringExpr>(formatStr, move(expressions));
+        /* A copy: parsing the placeholders can lex later strings into the format pool */
+        TokenList::FormatString format = tokens.format(previous());
+        ArenaVector<unique_ptr<Expr>> expressions;
+        for (size_t i = 1; i < format.literals.size(); ++i) {
+            expressions.push_back(parseExpression());
+            if (!match(TokenType::FORMAT_END)) error("Expected '}' after expression in format string");
+        }
+        return make_unique<FormatStringExpr>(move(format.text), move(format.literals), move(expressions));
     }
 
     if (match(TokenType::TRUE)) return make_unique<BooleanExpr>(true);
@@ -60,16 +65,16 @@ unique_ptr<Expr> Parser::parsePrimary() {
 
     if (match(TokenType::BUILTIN)) {
         string name;
-        string builtinToken = tokens[current - 1].value;
+        string builtinToken(text(previous()));
         if (builtinToken.length() > 1 && builtinToken[0] == '@') {
             name = builtinToken.substr(1);
         } else {
             if (!check(TokenType::IDENTIFIER)) error("Expected identifier after '@'");
-            name = advance().value;
+            name = text(advance());
         }
 
         if (!match(TokenType::LPAREN)) error("Expected '(' after @" + name);
-        vector<unique_ptr<Expr>> args;
+        ArenaVector<unique_ptr<Expr>> args;
         if (!check(TokenType::RPAREN)) {
             do { args.push_back(parseExpression()); } while(match(TokenType::COMMA));
         }
@@ -78,7 +83,7 @@ unique_ptr<Expr> Parser::parsePrimary() {
     }
 
     if (match(TokenType::IDENTIFIER)) {
-        string name = tokens[current - 1].value;
+        string name(text(previous()));
         
         if (match(TokenType::DOT)) {
             auto object = make_unique<VariableExpr>(name);
@@ -86,7 +91,7 @@ unique_ptr<Expr> Parser::parsePrimary() {
             
             if (check(TokenType::LPAREN)) {
                 advance();
-                vector<unique_ptr<Expr>> args;
+                ArenaVector<unique_ptr<Expr>> args;
                 if (!check(TokenType::RPAREN)) {
                     do { args.push_back(parseExpression()); } while(match(TokenType::COMMA));
                 }
@@ -98,7 +103,7 @@ unique_ptr<Expr> Parser::parsePrimary() {
         }
         
         if (match(TokenType::LPAREN)) {
-            vector<unique_ptr<Expr>> args;
+            ArenaVector<unique_ptr<Expr>> args;
             if (!check(TokenType::RPAREN)) {
                 do { args.push_back(parseExpression()); } while(match(TokenType::COMMA));
             }
@@ -115,7 +120,7 @@ unique_ptr<Expr> Parser::parsePrimary() {
         return expr;
     }
 
-    error("Expected expression, but found: " + tok.value);
+    error("Expected expression, but found: " + string(text(tok)));
     return nullptr;
 }
 
@@ -123,12 +128,12 @@ unique_ptr<Expr> Parser::parseMemberAccess(unique_ptr<Expr> object) {
     if (!match(TokenType::IDENTIFIER)) {
         error("Expected identifier after '.'");
     }
-    string member = tokens[current - 1].value;
+    string member(text(previous()));
 
-    if (auto* varExpr = dynamic_cast<VariableExpr*>(object.get())) {
+    if (auto* varExpr = as<VariableExpr>(object.get())) {
         std::string varName = varExpr->getName();
         
-        if (isEnumType(varName)) {
+        if (isEnumType(tokens.symbols().find(varName))) {
             return make_unique<EnumValueExpr>(varName, member);
         }
         
@@ -139,7 +144,7 @@ unique_ptr<Expr> Parser::parseMemberAccess(unique_ptr<Expr> object) {
     auto memberAccess = make_unique<MemberAccessExpr>(move(object), member);
 
     if (match(TokenType::LPAREN)) {
-        vector<unique_ptr<Expr>> args;
+        ArenaVector<unique_ptr<Expr>> args;
         if (!check(TokenType::RPAREN)) {
             do { 
                 args.push_back(parseExpression()); 
@@ -268,19 +273,19 @@ unique_ptr<Expr> Parser::parseBinaryExpression(int minPrecedence) {
 }
 unique_ptr<Expr> Parser::parseStructLiteral() {
     if (!match(TokenType::IDENTIFIER)) error("Expected struct name");
-    string structName = tokens[current - 1].value;
+    string structName(text(previous()));
     
     if (!match(TokenType::LBRACE)) {
         error("Expected '{' for struct literal");
     }
     
-    vector<pair<string, unique_ptr<Expr>>> fields;
+    ArenaVector<pair<string, unique_ptr<Expr>>> fields;
     
     while (!check(TokenType::RBRACE) && !isAtEnd()) {
         match(TokenType::DOT);
         
         if (!match(TokenType::IDENTIFIER)) error("Expected field name");
-        string fieldName = tokens[current - 1].value;
+        string fieldName(text(previous()));
         
         if (!match(TokenType::EQUALS)) {
             error("Expected '=' after field name");
@@ -306,21 +311,21 @@ unique_ptr<Expr> Parser::parseStructLiteral() {
 unique_ptr<Expr> Parser::parseBuiltinCall() {
     if (!match(TokenType::BUILTIN)) error("Expected '@' for builtin call");
     
-    string builtinToken = tokens[current - 1].value;
+    string builtinToken(text(previous()));
     string funcName;
     
     if (builtinToken.length() > 1 && builtinToken[0] == '@') {
         funcName = builtinToken.substr(1);
     } else {
         if (!check(TokenType::IDENTIFIER)) error("Expected builtin function name after '@'");
-        funcName = advance().value;
+        funcName = text(advance());
     }
     
     if (funcName == "import") {
         if (!match(TokenType::LPAREN)) error("Expected '(' after @import");
         
         if (!match(TokenType::STRING_LITERAL)) error("Expected string literal for module name");
-        string moduleName = tokens[current - 1].value;
+        string moduleName(text(previous()));
         
         if (!match(TokenType::RPAREN)) error("Expected ')' after module name");
         
@@ -328,7 +333,7 @@ unique_ptr<Expr> Parser::parseBuiltinCall() {
     }
     
     if (!match(TokenType::LPAREN)) error("Expected '(' after @" + funcName);
-    vector<unique_ptr<Expr>> args;
+    ArenaVector<unique_ptr<Expr>> args;
     if (!check(TokenType::RPAREN)) {
         do { args.push_back(parseExpression()); } while(match(TokenType::COMMA));
     }
@@ -8,7 +8,7 @@ using namespace AST;
 unique_ptr<Stmt> Parser::parseEntrypointStatement() {
     advance();
     
-    const Token& lastToken = tokens[current - 1];
+    Token lastToken = previous();
     if (!match(TokenType::SEMICOLON)) {
         errorAt(lastToken, "Expected ';' after @entrypoint");
     }
@@ -19,16 +19,16 @@ unique_ptr<Stmt> Parser::parseEntrypointStatement() {
 unique_ptr<Stmt> Parser::parseEnumDeclaration() {
     if (!match(TokenType::ENUM)) error("Expected 'enum'");
     if (!match(TokenType::IDENTIFIER)) error("Expected enum name");
-    string name = tokens[current - 1].value;
+    string name(text(previous()));
     
-    registerEnumType(name);
+    registerEnumType(previous().id);
     
-    vector<pair<string, unique_ptr<Expr>>> members;
+    ArenaVector<pair<string, unique_ptr<Expr>>> members;
     int currentValue = 0;
     
     while (!check(TokenType::END) && !isAtEnd()) {
         if (!match(TokenType::IDENTIFIER)) error("Expected enum member name");
-        string memberName = tokens[current - 1].value;
+        string memberName(text(previous()));
         
         unique_ptr<Expr> value = nullptr;
         if (match(TokenType::EQUALS)) {
@@ -39,7 +39,7 @@ unique_ptr<Stmt> Parser::parseEnumDeclaration() {
         
         members.emplace_back(memberName, move(value));
         
-        if (auto* numExpr = dynamic_cast<NumberExpr*>(members.back().second.get())) {
+        if (auto* numExpr = as<NumberExpr>(members.back().second.get())) {
             try {
                 currentValue = std::stoi(numExpr->getValue().toString()) + 1;
             } catch (...) {
@@ -69,11 +69,11 @@ unique_ptr<Stmt> Parser::parseVariableDeclaration() {
     bool isConst = match(TokenType::CONST);
     if (!isConst && !match(TokenType::VAR)) error("Expected 'var' or 'const'");
     if (!match(TokenType::IDENTIFIER)) error("Expected variable name");
-    string name = tokens[current - 1].value;
+    string name(text(previous()));
     
     if (isInGlobalScope()) {
-        registerGlobalVariable(name);
-        std::cout << "DEBUG: Registered global variable: " << name << std::endl;
+        registerGlobalVariable(previous().id);
+        SUMMIT_TRACE(Parse, Detail, "Registered global variable: " << name);
     }
     
     VarType type = VarType::VOID;
@@ -82,12 +82,13 @@ unique_ptr<Stmt> Parser::parseVariableDeclaration() {
     if (check(TokenType::COLON)) {
         advance();
         if (check(TokenType::IDENTIFIER)) {
-            string typeName = peek().value;
+            Token typeToken = peek();
+            string typeName(text(typeToken));
             advance();
             
-            if (isEnumType(typeName)) {
+            if (isEnumType(typeToken.id)) {
                 type = VarType::INT32;
-            } else if (isStructType(typeName)) {
+            } else if (isStructType(typeToken.id)) {
                 type = VarType::STRUCT;
                 structName = typeName;
             } else {
@@ -106,22 +107,22 @@ unique_ptr<Stmt> Parser::parseVariableDeclaration() {
         value = parseExpression();
         
         if (isConst && type == VarType::VOID) {
-            if (auto* moduleExpr = dynamic_cast<ModuleExpr*>(value.get())) {
+            if (auto* moduleExpr = as<ModuleExpr>(value.get())) {
                 type = VarType::MODULE;
             }
-            else if (auto* numberExpr = dynamic_cast<NumberExpr*>(value.get())) {
+            else if (auto* numberExpr = as<NumberExpr>(value.get())) {
                 const BigInt& bigValue = numberExpr->getValue();
                 if (bigValue >= -128 && bigValue <= 127) type = VarType::INT8;
                 else if (bigValue >= -32768 && bigValue <= 32767) type = VarType::INT16;
                 else type = VarType::INT32;
             }
-            else if (auto* stringExpr = dynamic_cast<StringExpr*>(value.get())) {
+            else if (auto* stringExpr = as<StringExpr>(value.get())) {
                 type = VarType::STRING;
             }
-            else if (auto* boolExpr = dynamic_cast<BooleanExpr*>(value.get())) {
+            else if (auto* boolExpr = as<BooleanExpr>(value.get())) {
                 type = VarType::UINT0;
             }
-            else if (auto* floatExpr = dynamic_cast<FloatExpr*>(value.get())) {
+            else if (auto* floatExpr = as<FloatExpr>(value.get())) {
                 type = floatExpr->getFloatType();
             }
             else {
@@ -136,24 +137,24 @@ unique_ptr<Stmt> Parser::parseVariableDeclaration() {
         }
     }
     
-    const Token& lastToken = tokens[current - 1];
+    Token lastToken = previous();
     if (!match(TokenType::SEMICOLON)) {
         errorAt(lastToken, "Expected ';' after variable declaration");
     }
     
-    std::cout << "DEBUG: Creating VariableDecl for '" << name << "' with type " << static_cast<int>(type) << " and structName '" << structName << "'" << std::endl;
+    SUMMIT_TRACE(Parse, Detail, "Creating VariableDecl for '" << name << "' with type " << static_cast<int>(type) << " and structName '" << structName << "'");
     return make_unique<VariableDecl>(name, type, isConst, move(value), structName);
 }
 
 unique_ptr<Stmt> Parser::parseAssignment() {
     if (!check(TokenType::IDENTIFIER)) error("Expected identifier for assignment");
-    string name = peek().value;
+    string name(text(peek()));
     advance();
     
     if (!match(TokenType::EQUALS)) error("Expected '=' after variable name");
     auto value = parseExpression();
     
-    const Token& lastToken = tokens[current - 1];
+    Token lastToken = previous();
     if (!match(TokenType::SEMICOLON)) {
         errorAt(lastToken, "Expected ';' after assignment");
     }
@@ -314,7 +315,7 @@ unique_ptr<Stmt> Parser::parseFunctionDeclaration() {
     
     if (!match(TokenType::FUNC)) error("Expected 'func'");
     if (!match(TokenType::IDENTIFIER)) error("Expected function name");
-    string name = tokens[current - 1].value;
+    string name(text(previous()));
     
     enterScope();
     
@@ -324,18 +325,18 @@ unique_ptr<Stmt> Parser::parseFunctionDeclaration() {
     if (!check(TokenType::RPAREN)) {
         do {
             if (!match(TokenType::IDENTIFIER)) error("Expected parameter name");
-            string paramName = tokens[current - 1].value;
+            string paramName(text(previous()));
             if (!match(TokenType::COLON)) error("Expected ':' after parameter name");
             
             VarType paramType;
 
             if (check(TokenType::IDENTIFIER)) {
-                string typeName = peek().value;
+                Token typeToken = peek();
                 
-                if (isEnumType(typeName)) {
+                if (isEnumType(typeToken.id)) {
                     paramType = VarType::INT32;
                     advance();
-                } else if (isStructType(typeName)) {
+                } else if (isStructType(typeToken.id)) {
                     paramType = VarType::STRUCT;
                     advance();
                 } else {
@@ -358,12 +359,13 @@ unique_ptr<Stmt> Parser::parseFunctionDeclaration() {
         if (!match(TokenType::GREATER)) error("Expected '>' after '-' for return type");
         
         if (check(TokenType::IDENTIFIER)) {
-            string typeName = peek().value;
+            Token typeToken = peek();
+            string typeName(text(typeToken));
             
-            if (isEnumType(typeName)) {
+            if (isEnumType(typeToken.id)) {
                 returnType = VarType::INT32;
                 advance();
-            } else if (isStructType(typeName)) {
+            } else if (isStructType(typeToken.id)) {
                 returnType = VarType::STRUCT;
                 returnStructName = typeName;
                 advance();
@@ -397,7 +399,7 @@ unique_ptr<Stmt> Parser::parseReturnStatement() {
         value = parseExpression();
     }
     
-    const Token& lastToken = tokens[current - 1];
+    Token lastToken = previous();
     if (!match(TokenType::SEMICOLON)) {
         errorAt(lastToken, "Expected ';' after return statement");
     }
@@ -450,7 +452,7 @@ unique_ptr<Stmt> Parser::parseForLoopStatement() {
     if (!match(TokenType::IDENTIFIER)) {
         error("Expected variable name in for loop");
     }
-    string varName = tokens[current - 1].value;
+    string varName(text(previous()));
 
     if (!match(TokenType::COLON)) {
         error("Expected ':' after variable name in for loop");
@@ -474,7 +476,7 @@ unique_ptr<Stmt> Parser::parseForLoopStatement() {
     unique_ptr<Expr> increment = nullptr;
 
     if (check(TokenType::IDENTIFIER)) {
-        string incVarName = peek().value;
+        string incVarName(text(peek()));
         advance();
 
         if (check(TokenType::INCREMENT) || check(TokenType::DECREMENT)) {
@@ -536,30 +538,30 @@ unique_ptr<Stmt> Parser::parseForLoopStatement() {
 unique_ptr<Stmt> Parser::parseStructDeclaration() {
     if (!match(TokenType::STRUCT)) error("Expected 'struct'");
     if (!match(TokenType::IDENTIFIER)) error("Expected struct name");
-    string name = tokens[current - 1].value;
+    string name(text(previous()));
 
-    registerStructType(name);
+    registerStructType(previous().id);
     
     vector<pair<string, VarType>> fields;
-    vector<unique_ptr<FunctionStmt>> methods;
+    ArenaVector<unique_ptr<FunctionStmt>> methods;
     
     unordered_map<string, unique_ptr<Expr>> fieldDefaults;
     
     while (!check(TokenType::END) && !isAtEnd()) {
         if (check(TokenType::IDENTIFIER) && checkNext(TokenType::COLON)) {
-            string fieldName = peek().value;
+            string fieldName(text(peek()));
             advance();
             advance();
             
             VarType fieldType;
 
             if (check(TokenType::IDENTIFIER)) {
-                string typeName = peek().value;
+                Token typeToken = peek();
                 
-                if (isEnumType(typeName)) {
+                if (isEnumType(typeToken.id)) {
                     fieldType = VarType::INT32;
                     advance();
-                } else if (isStructType(typeName)) {
+                } else if (isStructType(typeToken.id)) {
                     fieldType = VarType::STRUCT;
                     advance();
                 } else {
@@ -604,7 +606,7 @@ unique_ptr<Stmt> Parser::parseStructDeclaration() {
 unique_ptr<FunctionStmt> Parser::parseMethodDeclaration(const string& structName) {
     if (!match(TokenType::FUNC)) error("Expected 'func'");
     if (!match(TokenType::IDENTIFIER)) error("Expected method name");
-    string methodName = tokens[current - 1].value;
+    string methodName(text(previous()));
 
     enterScope();
     
@@ -617,18 +619,18 @@ unique_ptr<FunctionStmt> Parser::parseMethodDeclaration(const string& structName
     if (!check(TokenType::RPAREN)) {
         do {
             if (!match(TokenType::IDENTIFIER)) error("Expected parameter name");
-            string paramName = tokens[current - 1].value;
+            string paramName(text(previous()));
             if (!match(TokenType::COLON)) error("Expected ':' after parameter name");
             
             VarType paramType;
             
             if (check(TokenType::IDENTIFIER)) {
-                string typeName = peek().value;
+                Token typeToken = peek();
                 
-                if (isEnumType(typeName)) {
+                if (isEnumType(typeToken.id)) {
                     paramType = VarType::INT32;
                     advance();
-                } else if (isStructType(typeName)) {
+                } else if (isStructType(typeToken.id)) {
                     paramType = VarType::STRUCT;
                     advance();
                 } else {
@@ -651,28 +653,29 @@ unique_ptr<FunctionStmt> Parser::parseMethodDeclaration(const string& structName
         if (!match(TokenType::GREATER)) error("Expected '>' after '-' for return type");
         
         if (check(TokenType::IDENTIFIER)) {
-            string typeName = peek().value;
-            std::cout << "DEBUG parseMethodDeclaration: Found return type identifier: '" << typeName << "'" << std::endl;
+            Token typeToken = peek();
+            string typeName(text(typeToken));
+            SUMMIT_TRACE(Parse, Detail, "parseMethodDeclaration: Found return type identifier: '" << typeName << "'");
             
-            if (isEnumType(typeName)) {
+            if (isEnumType(typeToken.id)) {
                 returnType = VarType::INT32;
                 advance();
-                std::cout << "DEBUG parseMethodDeclaration: Set return type to INT32 (enum)" << std::endl;
-            } else if (isStructType(typeName)) {
+                SUMMIT_TRACE(Parse, Detail, "parseMethodDeclaration: Set return type to INT32 (enum)");
+            } else if (isStructType(typeToken.id)) {
                 returnType = VarType::STRUCT;
                 returnStructName = typeName;
                 advance();
-                std::cout << "DEBUG parseMethodDeclaration: Set return type to STRUCT with name: '" << returnStructName << "'" << std::endl;
+                SUMMIT_TRACE(Parse, Detail, "parseMethodDeclaration: Set return type to STRUCT with name: '" << returnStructName << "'");
             } else {
                 returnType = parseType();
-                std::cout << "DEBUG parseMethodDeclaration: Set return type to: " << static_cast<int>(returnType) << std::endl;
+                SUMMIT_TRACE(Parse, Detail, "parseMethodDeclaration: Set return type to: " << static_cast<int>(returnType));
             }
         } else {
             returnType = parseType();
-            std::cout << "DEBUG parseMethodDeclaration: Set return type to: " << static_cast<int>(returnType) << std::endl;
+            SUMMIT_TRACE(Parse, Detail, "parseMethodDeclaration: Set return type to: " << static_cast<int>(returnType));
         }
     } else {
-        std::cout << "DEBUG parseMethodDeclaration: No return type specified, defaulting to VOID" << std::endl;
+        SUMMIT_TRACE(Parse, Detail, "parseMethodDeclaration: No return type specified, defaulting to VOID");
     }
 
     auto body = make_unique<BlockStmt>();
@@ -688,9 +691,9 @@ unique_ptr<FunctionStmt> Parser::parseMethodDeclaration(const string& structName
 
     std::string fullMethodName = structName + "." + methodName;
     
-    std::cout << "DEBUG parseMethodDeclaration: Creating method '" << fullMethodName 
+    SUMMIT_TRACE(Parse, Detail, "parseMethodDeclaration: Creating method '" << fullMethodName 
               << "' with return type " << static_cast<int>(returnType)
-              << " and return struct name '" << returnStructName << "'" << std::endl;
+              << " and return struct name '" << returnStructName << "'");
     
     auto method = make_unique<FunctionStmt>(fullMethodName, std::move(parameters), returnType, std::move(body), false, returnStructName);
     
@@ -698,10 +701,10 @@ unique_ptr<FunctionStmt> Parser::parseMethodDeclaration(const string& structName
 }
 
 unique_ptr<Stmt> Parser::parseStatement() {
-    std::cout << "DEBUG parseStatement: current token = " 
-              << tokens[current].value 
-              << " type = " << static_cast<int>(tokens[current].type)
-              << " at line " << tokens[current].line << std::endl;
+    SUMMIT_TRACE(Parse, Detail, "parseStatement: current token = " 
+              << text(peek()) 
+              << " type = " << static_cast<int>(peek().type)
+              << " at line " << tokens.location(peek()).line);
     if (check(TokenType::ENTRYPOINT)) {
         return parseEntrypointStatement();
     }
@@ -744,7 +747,7 @@ unique_ptr<Stmt> Parser::parseStatement() {
 
     auto expr = parseExpression();
     
-    const Token& lastToken = tokens[current - 1];
+    Token lastToken = previous();
     if (!match(TokenType::SEMICOLON)) {
         errorAt(lastToken, "Expected ';' after expression");
     }
@@ -752,13 +755,13 @@ unique_ptr<Stmt> Parser::parseStatement() {
 }
 
 unique_ptr<Stmt> Parser::parseAssignmentOrIncrement() {
-    std::cout << "DEBUG parseAssignmentOrIncrement: current token = " 
-              << tokens[current].value << " at line " 
-              << tokens[current].line << std::endl;
+    SUMMIT_TRACE(Parse, Detail, "parseAssignmentOrIncrement: current token = " 
+              << text(peek()) << " at line " 
+              << tokens.location(peek()).line);
     size_t savedPos = current;
     
     if (check(TokenType::IDENTIFIER)) {
-        string firstName = peek().value;
+        string firstName(text(peek()));
         advance();
         
         if (check(TokenType::DOT)) {
@@ -767,7 +770,7 @@ unique_ptr<Stmt> Parser::parseAssignmentOrIncrement() {
             if (!check(TokenType::IDENTIFIER)) {
                 error("Expected member name after '.'");
             }
-            string memberName = peek().value;
+            string memberName(text(peek()));
             advance();
             
             if (check(TokenType::EQUALS)) {
@@ -775,7 +778,7 @@ unique_ptr<Stmt> Parser::parseAssignmentOrIncrement() {
                 
                 auto value = parseExpression();
                 
-                const Token& lastToken = tokens[current - 1];
+                Token lastToken = previous();
                 if (!match(TokenType::SEMICOLON)) {
                     errorAt(lastToken, "Expected ';' after member assignment");
                 }
@@ -790,7 +793,7 @@ unique_ptr<Stmt> Parser::parseAssignmentOrIncrement() {
             current = savedPos;
             auto expr = parseExpression();
             
-            const Token& lastToken = tokens[current - 1];
+            Token lastToken = previous();
             if (!match(TokenType::SEMICOLON)) {
                 errorAt(lastToken, "Expected ';' after expression");
             }
@@ -800,7 +803,7 @@ unique_ptr<Stmt> Parser::parseAssignmentOrIncrement() {
         current = savedPos;
     }
     
-    string name = peek().value;
+    string name(text(peek()));
     
     if (checkNext(TokenType::INCREMENT) || checkNext(TokenType::DECREMENT)) {
         advance();
@@ -850,7 +853,7 @@ unique_ptr<Stmt> Parser::parseAssignmentOrIncrement() {
         advance();
         auto value = parseExpression();
         
-        const Token& lastToken = tokens[current - 1];
+        Token lastToken = previous();
         if (!match(TokenType::SEMICOLON)) {
             errorAt(lastToken, "Expected ';' after assignment");
         }
@@ -859,7 +862,7 @@ unique_ptr<Stmt> Parser::parseAssignmentOrIncrement() {
 
     auto expr = parseExpression();
     
-    const Token& lastToken = tokens[current - 1];
+    Token lastToken = previous();
     if (!match(TokenType::SEMICOLON)) {
         errorAt(lastToken, "Expected ';' after expression");
     }
@@ -871,7 +874,7 @@ unique_ptr<Stmt> Parser::parseBreakStatement() {
         error("Expected 'STOP' for break statement");
     }
     
-    const Token& lastToken = tokens[current - 1];
+    Token lastToken = previous();
     if (!match(TokenType::SEMICOLON)) {
         errorAt(lastToken, "Expected ';' after STOP");
     }
@@ -884,7 +887,7 @@ unique_ptr<Stmt> Parser::parseContinueStatement() {
         error("Expected 'NEXT' for continue statement");
     }
     
-    const Token& lastToken = tokens[current - 1];
+    Token lastToken = previous();
     if (!match(TokenType::SEMICOLON)) {
         errorAt(lastToken, "Expected ';' after NEXT");
     }
@@ -5,6 +5,7 @@ using namespace AST;
 
 unique_ptr<Program> Parser::parse() {
     auto program = make_unique<Program>();
+    Arena::Scope arenaScope(&program->getArena());
     bool nextFunctionIsEntryPoint = false;
     
     while (!isAtEnd()) {
@@ -21,10 +22,10 @@ unique_ptr<Program> Parser::parse() {
         auto stmt = parseStatement();
         
         if (nextFunctionIsEntryPoint) {
-            if (auto* funcStmt = dynamic_cast<FunctionStmt*>(stmt.get())) {
+            if (auto* funcStmt = as<FunctionStmt>(stmt.get())) {
                 program->setEntryPointFunction(funcStmt->getName());
-                std::cout << "DEBUG: Marking function '" << funcStmt->getName() 
-                          << "' as entry point" << std::endl;
+                SUMMIT_TRACE(Parse, Detail, "Marking function '" << funcStmt->getName() 
+                          << "' as entry point");
             } else {
                 error("@entrypoint must be followed by a function declaration");
             }
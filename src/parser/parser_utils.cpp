@@ -4,47 +4,61 @@
 using namespace std;
 using namespace AST;
 
-Parser::Parser(std::vector<Token> tokens, const std::string& source) 
-    : tokens(std::move(tokens)), current(0), source(source), inGlobalScope(true) {
+Parser::Parser(TokenList tokens) 
+    : tokens(std::move(tokens)), current(0), inGlobalScope(true) {
     // Initialize with global scope
     currentScope.push_back("global");
 }
 
-const Token& Parser::peek() { return tokens[current]; }
-const Token& Parser::advance() { if (!isAtEnd()) current++; return tokens[current - 1]; }
+/* Tokens kept behind the cursor for previous() and short backtracking */
+constexpr size_t STREAM_KEEP = 32;
+constexpr size_t STREAM_BATCH = 2048;
+
+Parser::Parser(Lexer& lexer) 
+    : tokens(lexer.beginStream()), current(0), stream(&lexer), inGlobalScope(true) {
+    currentScope.push_back("global");
+}
+
+void Parser::pull(size_t index) {
+    if (!stream) return;
+    tokens.discardBefore(current > STREAM_KEEP ? current - STREAM_KEEP : 0);
+    while (index >= tokens.size() && stream->lexInto(tokens, STREAM_BATCH) > 0) {}
+}
+
+Token Parser::advance() { if (!isAtEnd()) current++; return previous(); }
 bool Parser::match(TokenType type) { if (check(type)) { advance(); return true; } return false; }
 bool Parser::check(TokenType type) { return !isAtEnd() && peek().type == type; }
-bool Parser::checkNext(TokenType type) { return current + 1 < tokens.size() && tokens[current + 1].type == type; }
+bool Parser::checkNext(TokenType type) { return tokenAt(current + 1).type == type; }
 bool Parser::isAtEnd() { return peek().type == TokenType::END_OF_FILE; }
 
-string Parser::getSourceLine(size_t line) {
-    istringstream iss(source);
-    string currentLine;
-    size_t lineNum = 1;
-    while (getline(iss, currentLine)) {
-        if (lineNum == line) return currentLine;
-        lineNum++;
+unordered_set<string> Parser::spell(const unordered_set<StringInterner::Id>& ids) const {
+    unordered_set<string> names;
+    names.reserve(ids.size());
+    for (StringInterner::Id id : ids) {
+        names.emplace(tokens.symbols().text(id));
     }
-    return "";
+    return names;
+}
+
+string Parser::getSourceLine(size_t line) {
+    return string(tokens.lineText(line));
 }
 
 void Parser::error(const string& msg) {
-    const Token& tok = peek();
-    string sourceLine = getSourceLine(tok.line);
-    throw SyntaxError(msg, tok.line, tok.column, sourceLine);
+    errorAt(peek(), msg);
 }
 
 void Parser::errorAt(const Token& tok, const string& msg) {
-    string sourceLine = getSourceLine(tok.line);
-    throw SyntaxError(msg, tok.line, tok.column, sourceLine);
+    SourceLocation loc = tokens.location(tok);
+    throw SyntaxError(msg, loc.line, loc.column, getSourceLine(loc.line));
 }
 
 AST::VarType Parser::parseType() {
     if (match(TokenType::IDENTIFIER)) {
-        string typeName = tokens[current - 1].value;
+        string typeName(text(previous()));
         
         // Check if it's a struct type
-        if (isStructType(typeName)) {
+        if (isStructType(previous().id)) {
             return VarType::STRUCT;
         }
         
@@ -76,64 +90,3 @@ AST::VarType Parser::parseType() {
     error("Expected type");
     return VarType::VOID;
 }
-
-unique_ptr<Expr> Parser::parseExpressionFromString(const string& exprStr) {
-    Lexer tempLexer(exprStr);
-    auto tempTokens = tempLexer.tokenize();
-    Parser tempParser(tempTokens, exprStr);
-    return tempParser.parseExpression();
-}
-
-string Parser::buildFormatSpecifiers(const string& formatStr) {
-    string formatSpecifiers;
-    size_t pos = 0;
-    size_t lastPos = 0;
-    
-    while ((pos = formatStr.find('{', lastPos)) != string::npos) {
-        if (pos > lastPos) {
-            formatSpecifiers += formatStr.substr(lastPos, pos - lastPos);
-        }
-        
-        size_t endPos = formatStr.find('}', pos);
-        if (endPos == string::npos) {
-            throw runtime_error("Unclosed '{' in format string");
-        }
-        
-        formatSpecifiers += "%s";
-        lastPos = endPos + 1;
-    }
-
-    if (lastPos < formatStr.length()) {
-        formatSpecifiers += formatStr.substr(lastPos);
-    }
-    
-    return formatSpecifiers;
-}
-
-vector<unique_ptr<Expr>> Parser::extractExpressionsFromFormat(const string& formatStr) {
-    vector<unique_ptr<Expr>> expressions;
-    size_t pos = 0;
-    
-    while ((pos = formatStr.find('{', pos)) != string::npos) {
-        size_t endPos = formatStr.find('}', pos);
-        if (endPos == string::npos) {
-            throw runtime_error("Unclosed '{' in format string");
-        }
-        
-        string exprStr = formatStr.substr(pos + 1, endPos - pos - 1);
-        
-        try {
-            Lexer tempLexer(exprStr);
-            auto tempTokens = tempLexer.tokenize();
-            Parser tempParser(tempTokens, exprStr);
-            auto expr = tempParser.parseExpression();
-            expressions.push_back(move(expr));
-        } catch (const exception& e) {
-            throw runtime_error("Invalid expression in format string: " + exprStr + " - " + e.what());
-        }
-        
-        pos = endPos + 1;
-    }
-    
-    return expressions;
-}
\ No newline at end of file
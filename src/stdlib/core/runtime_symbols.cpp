@@ -0,0 +1,119 @@
+#include "runtime_symbols.h"
+#include <cstdint>
+
+extern "C" {
+    /* stdlib/io.c */
+    void io_print_str(const char* str);
+    void io_println_str(const char* str);
+    char* io_readln();
+    uint64_t io_read_int();
+
+    bool io_check_int4_bounds(int64_t value);
+    bool io_check_int8_bounds(int64_t value);
+    bool io_check_int12_bounds(int64_t value);
+    bool io_check_int16_bounds(int64_t value);
+    bool io_check_int24_bounds(int64_t value);
+    bool io_check_int32_bounds(int64_t value);
+    bool io_check_int48_bounds(int64_t value);
+    bool io_check_int64_bounds(int64_t value);
+    bool io_check_uint0_bounds(int64_t value);
+    bool io_check_uint4_bounds(int64_t value);
+    bool io_check_uint8_bounds(int64_t value);
+    bool io_check_uint12_bounds(int64_t value);
+    bool io_check_uint16_bounds(int64_t value);
+    bool io_check_uint24_bounds(int64_t value);
+    bool io_check_uint32_bounds(int64_t value);
+    bool io_check_uint48_bounds(int64_t value);
+    bool io_check_uint64_bounds(int64_t value);
+
+    char* int4_to_string(int8_t value);
+    char* int8_to_string(int8_t value);
+    char* int12_to_string(int16_t value);
+    char* int16_to_string(int16_t value);
+    char* int24_to_string(int32_t value);
+    char* int32_to_string(int32_t value);
+    char* int48_to_string(int64_t value);
+    char* int64_to_string(int64_t value);
+    char* uint0_to_string(uint8_t value);
+    char* uint4_to_string(uint8_t value);
+    char* uint8_to_string(uint8_t value);
+    char* uint12_to_string(uint16_t value);
+    char* uint16_to_string(uint16_t value);
+    char* uint24_to_string(uint32_t value);
+    char* uint32_to_string(uint32_t value);
+    char* uint48_to_string(uint64_t value);
+    char* uint64_to_string(uint64_t value);
+    char* float_to_string(float value);
+    char* double_to_string(double value);
+    char* bool_to_string(bool value);
+
+    /* stdlib/math.c */
+    int32_t math_abs(int32_t x);
+    float math_pow(float base, float exponent);
+    float math_sqrt(float x);
+    float math_round(float x);
+    float math_min(float a, float b);
+    float math_max(float a, float b);
+}
+
+#define RUNTIME_SYMBOL(name) { #name, reinterpret_cast<void*>(&name) }
+
+namespace RuntimeSymbols {
+
+const std::vector<std::pair<std::string, void*>>& getAll() {
+    static const std::vector<std::pair<std::string, void*>> symbols = {
+        RUNTIME_SYMBOL(io_print_str),
+        RUNTIME_SYMBOL(io_println_str),
+        RUNTIME_SYMBOL(io_readln),
+        RUNTIME_SYMBOL(io_read_int),
+
+        RUNTIME_SYMBOL(io_check_int4_bounds),
+        RUNTIME_SYMBOL(io_check_int8_bounds),
+        RUNTIME_SYMBOL(io_check_int12_bounds),
+        RUNTIME_SYMBOL(io_check_int16_bounds),
+        RUNTIME_SYMBOL(io_check_int24_bounds),
+        RUNTIME_SYMBOL(io_check_int32_bounds),
+        RUNTIME_SYMBOL(io_check_int48_bounds),
+        RUNTIME_SYMBOL(io_check_int64_bounds),
+        RUNTIME_SYMBOL(io_check_uint0_bounds),
+        RUNTIME_SYMBOL(io_check_uint4_bounds),
+        RUNTIME_SYMBOL(io_check_uint8_bounds),
+        RUNTIME_SYMBOL(io_check_uint12_bounds),
+        RUNTIME_SYMBOL(io_check_uint16_bounds),
+        RUNTIME_SYMBOL(io_check_uint24_bounds),
+        RUNTIME_SYMBOL(io_check_uint32_bounds),
+        RUNTIME_SYMBOL(io_check_uint48_bounds),
+        RUNTIME_SYMBOL(io_check_uint64_bounds),
+
+        RUNTIME_SYMBOL(int4_to_string),
+        RUNTIME_SYMBOL(int8_to_string),
+        RUNTIME_SYMBOL(int12_to_string),
+        RUNTIME_SYMBOL(int16_to_string),
+        RUNTIME_SYMBOL(int24_to_string),
+        RUNTIME_SYMBOL(int32_to_string),
+        RUNTIME_SYMBOL(int48_to_string),
+        RUNTIME_SYMBOL(int64_to_string),
+        RUNTIME_SYMBOL(uint0_to_string),
+        RUNTIME_SYMBOL(uint4_to_string),
+        RUNTIME_SYMBOL(uint8_to_string),
+        RUNTIME_SYMBOL(uint12_to_string),
+        RUNTIME_SYMBOL(uint16_to_string),
+        RUNTIME_SYMBOL(uint24_to_string),
+        RUNTIME_SYMBOL(uint32_to_string),
+        RUNTIME_SYMBOL(uint48_to_string),
+        RUNTIME_SYMBOL(uint64_to_string),
+        RUNTIME_SYMBOL(float_to_string),
+        RUNTIME_SYMBOL(double_to_string),
+        RUNTIME_SYMBOL(bool_to_string),
+
+        RUNTIME_SYMBOL(math_abs),
+        RUNTIME_SYMBOL(math_pow),
+        RUNTIME_SYMBOL(math_sqrt),
+        RUNTIME_SYMBOL(math_round),
+        RUNTIME_SYMBOL(math_min),
+        RUNTIME_SYMBOL(math_max),
+    };
+    return symbols;
+}
+
+}
@@ -0,0 +1,10 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <utility>
+
+/* Addresses of the C runtime in stdlib/, compiled into the compiler itself,
+   so JIT-compiled programs can call io_*, math_* and *_to_string directly */
+namespace RuntimeSymbols {
+    const std::vector<std::pair<std::string, void*>>& getAll();
+}
@@ -2,8 +2,8 @@
 #include "stdlib/registration/module_registry.h"
 #include "stdlib/registration/function_registry.h"
 
-bool StdLibManager::initialized = false;
-bool StdLibManager::stdlibEnabled = true;
+std::atomic<bool> StdLibManager::initialized{false};
+std::atomic<bool> StdLibManager::stdlibEnabled{true};
 
 StdLibManager& StdLibManager::getInstance() {
     static StdLibManager instance;
@@ -12,13 +12,17 @@ StdLibManager& StdLibManager::getInstance() {
 
 void StdLibManager::registerModule(ModulePtr module) {
     if (module && stdlibEnabled) {
+        std::unique_lock<std::shared_mutex> lock(registryMutex);
         modules.push_back(std::move(module));
+        moduleCache.clear();
     }
 }
 
 void StdLibManager::registerFunction(FunctionPtr function) {
     if (function && stdlibEnabled) {
+        std::unique_lock<std::shared_mutex> lock(registryMutex);
         functions.push_back(std::move(function));
+        functionCache.clear();
     }
 }
 
@@ -27,18 +31,27 @@ ModuleInterface* StdLibManager::findModuleHandler(const std::string& moduleName)
         return nullptr;
     }
     
-    auto it = moduleCache.find(moduleName);
-    if (it != moduleCache.end()) {
-        return it->second;
-    }
-    
-    for (auto& module : modules) {
-        if (module->handlesModule(moduleName)) {
-            moduleCache[moduleName] = module.get();
-            return module.get();
+    ModuleInterface* handler = nullptr;
+    {
+        std::shared_lock<std::shared_mutex> lock(registryMutex);
+        auto it = moduleCache.find(moduleName);
+        if (it != moduleCache.end()) {
+            return it->second;
         }
+        
+        for (auto& module : modules) {
+            if (module->handlesModule(moduleName)) {
+                handler = module.get();
+                break;
+            }
+        }
+    }
+
+    if (handler) {
+        std::unique_lock<std::shared_mutex> lock(registryMutex);
+        moduleCache[moduleName] = handler;
     }
-    return nullptr;
+    return handler;
 }
 
 FunctionInterface* StdLibManager::findFunctionHandler(const std::string& functionName, size_t argCount) {
@@ -47,34 +60,44 @@ FunctionInterface* StdLibManager::findFunctionHandler(const std::string& functio
     }
     
     std::string key = functionName + "_" + std::to_string(argCount);
-    auto it = functionCache.find(key);
-    if (it != functionCache.end()) {
-        return it->second;
-    }
-    
-    for (auto& function : functions) {
-        if (function->handlesCall(functionName, argCount)) {
-            functionCache[key] = function.get();
-            return function.get();
+    FunctionInterface* handler = nullptr;
+    {
+        std::shared_lock<std::shared_mutex> lock(registryMutex);
+        auto it = functionCache.find(key);
+        if (it != functionCache.end()) {
+            return it->second;
+        }
+        
+        for (auto& function : functions) {
+            if (function->handlesCall(functionName, argCount)) {
+                handler = function.get();
+                break;
+            }
         }
     }
-    return nullptr;
+
+    if (handler) {
+        std::unique_lock<std::shared_mutex> lock(registryMutex);
+        functionCache[key] = handler;
+    }
+    return handler;
 }
 
 void StdLibManager::initializeStandardLibrary(bool enableStdlib) {
+    std::lock_guard<std::mutex> lock(initMutex);
     if (initialized) {
         return;
     }
     
     stdlibEnabled = enableStdlib;
-    initialized = true;
     
-    if (!enableStdlib) {
-        return;
+    if (enableStdlib) {
+        ModuleRegistry::registerAllModules(*this);
+        FunctionRegistry::registerAllFunctions(*this);
     }
-    
-    ModuleRegistry::registerAllModules(*this);
-    FunctionRegistry::registerAllFunctions(*this);
+
+    /* Publish only after registration so other threads never see a half-filled registry */
+    initialized = true;
 }
 
 bool StdLibManager::isStdlibEnabled() {
@@ -83,4 +106,4 @@ bool StdLibManager::isStdlibEnabled() {
 
 bool StdLibManager::isInitialized() {
     return initialized;
-}
\ No newline at end of file
+}
@@ -1,6 +1,9 @@
 #pragma once
 #include <vector>
 #include <memory>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
 #include <unordered_map>
 #include "module_interface.h"
 #include "function_interface.h"
@@ -11,8 +14,11 @@ private:
     std::vector<FunctionPtr> functions;
     std::unordered_map<std::string, ModuleInterface*> moduleCache;
     std::unordered_map<std::string, FunctionInterface*> functionCache;
-    static bool initialized;
-    static bool stdlibEnabled;
+    /* Guards the handler lists and lookup caches; shared by concurrent compiles */
+    mutable std::shared_mutex registryMutex;
+    std::mutex initMutex;
+    static std::atomic<bool> initialized;
+    static std::atomic<bool> stdlibEnabled;
     
 public:
     static StdLibManager& getInstance();
@@ -23,7 +29,7 @@ public:
     ModuleInterface* findModuleHandler(const std::string& moduleName);
     FunctionInterface* findFunctionHandler(const std::string& functionName, size_t argCount);
     
-    // Modified to accept enable flag
+    // Modified to accept enable flag; runs once even when called from several threads
     void initializeStandardLibrary(bool enableStdlib = true);
     
     // Check if stdlib is enabled
@@ -31,4 +37,4 @@ public:
     
     // Check if already initialized
     static bool isInitialized();
-};
\ No newline at end of file
+};
@@ -1,6 +1,7 @@
 #include "print_function.h"
 #include "ast/ast.h"
 #include "codegen/string_conversions.h"
+#include "codegen/type_inference.h"
 #include <llvm/IR/Function.h>
 #include <llvm/IR/Type.h>
 
@@ -13,7 +14,7 @@ llvm::Value* PrintFunction::generateCall(CodeGen& context, AST::CallExpr& expr)
     auto& llvmContext = context.getContext();
     
     auto argValue = expr.getArgs()[0]->codegen(context);
-    auto stringValue = AST::convertToString(context, argValue);
+    auto stringValue = AST::convertToString(context, argValue, AST::resolvedSourceType(*expr.getArgs()[0], argValue));
    
     auto* i8Ptr = llvm::PointerType::get(llvm::Type::getInt8Ty(llvmContext), 0);
     auto* voidType = llvm::Type::getVoidTy(llvmContext);
@@ -24,8 +24,7 @@ llvm::Value* StdModule::handleIOMember(CodeGen& context, const std::string& call
     auto ioModule = context.lookupVariable(ioVarName);
     if (!ioModule) {
         auto& module = context.getModule();
-        auto& llvmContext = context.getContext();
-        auto moduleType = llvm::StructType::create(llvmContext, "module_t");
+        auto moduleType = context.getLLVMType(AST::VarType::MODULE);
         auto ioVar = new llvm::GlobalVariable(
             module,
             moduleType,
@@ -35,11 +34,10 @@ llvm::Value* StdModule::handleIOMember(CodeGen& context, const std::string& call
             ioVarName
         );
         
-        context.getNamedValues()[ioVarName] = ioVar;
-        context.getVariableTypes()[ioVarName] = AST::VarType::MODULE;
+        context.declareVariable(ioVarName, ioVar, AST::VarType::MODULE);
         context.setModuleReference(ioVarName, ioVar, "io");
         
-        std::cout << "DEBUG: Created IO module reference: " << ioVarName << std::endl;
+        SUMMIT_TRACE(Module, Detail, "Created IO module reference: " << ioVarName);
         return ioVar;
     }
     return ioModule;
@@ -51,8 +49,7 @@ llvm::Value* StdModule::handleMathMember(CodeGen& context, const std::string& ca
     auto mathModule = context.lookupVariable(mathVarName);
     if (!mathModule) {
         auto& module = context.getModule();
-        auto& llvmContext = context.getContext();
-        auto moduleType = llvm::StructType::create(llvmContext, "module_t");
+        auto moduleType = context.getLLVMType(AST::VarType::MODULE);
         auto mathVar = new llvm::GlobalVariable(
             module,
             moduleType,
@@ -62,11 +59,10 @@ llvm::Value* StdModule::handleMathMember(CodeGen& context, const std::string& ca
             mathVarName
         );
         
-        context.getNamedValues()[mathVarName] = mathVar;
-        context.getVariableTypes()[mathVarName] = AST::VarType::MODULE;
+        context.declareVariable(mathVarName, mathVar, AST::VarType::MODULE);
         context.setModuleReference(mathVarName, mathVar, "math");
         
-        std::cout << "DEBUG: Created Math module reference: " << mathVarName << std::endl;
+        SUMMIT_TRACE(Module, Detail, "Created Math module reference: " << mathVarName);
         return mathVar;
     }
     return mathModule;
@@ -1,5 +1,177 @@
 #include "utils/bigint.h"
 
+namespace {
+
+void check(mp_err err) {
+    if (err != MP_OKAY) throw std::runtime_error("BigInt arithmetic failed");
+}
+
+/* Scratch mp_int, cleared on scope exit */
+struct MpTemp {
+    mp_int value;
+    MpTemp() { check(mp_init(&value)); }
+    ~MpTemp() { mp_clear(&value); }
+    MpTemp(const MpTemp&) = delete;
+    MpTemp& operator=(const MpTemp&) = delete;
+};
+
+}
+
+BigInt::BigInt(const std::string& str) : small(0) {
+    /* Up to 18 digits always fits in int64_t; anything else goes through libtommath */
+    size_t digits = str.size() - (!str.empty() && str[0] == '-');
+    if (digits > 0 && digits <= 18 && str.find_first_not_of("0123456789", str.size() - digits) == std::string::npos) {
+        for (size_t i = str.size() - digits; i < str.size(); ++i) {
+            small = small * 10 + (str[i] - '0');
+        }
+        if (str[0] == '-') small = -small;
+        return;
+    }
+
+    mp_init(&big);
+    isBig = true;
+    if (mp_read_radix(&big, str.c_str(), 10) != MP_OKAY) {
+        release();
+        throw std::runtime_error("Invalid integer: " + str);
+    }
+    normalize();
+}
+
+void BigInt::normalize() {
+    if (!isBig || mp_count_bits(&big) > 64) return;
+
+    uint64_t magnitude = 0;
+    for (int i = 0; i < big.used; i++) {
+        magnitude |= ((uint64_t)big.dp[i]) << (i * MP_DIGIT_BIT);
+    }
+
+    bool negative = mp_isneg(&big);
+    if (magnitude > (negative ? 9223372036854775808ULL : 9223372036854775807ULL)) return;
+
+    mp_clear(&big);
+    isBig = false;
+    small = negative ? static_cast<int64_t>(0 - magnitude) : static_cast<int64_t>(magnitude);
+}
+
+std::string BigInt::toString() const {
+    if (!isBig) return std::to_string(small);
+
+    int size;
+    mp_radix_size(&big, 10, &size);
+    std::string result(size, '\0');
+    mp_toradix(&big, &result[0], 10);
+    
+    if (!result.empty() && result.back() == '\0') {
+        result.pop_back();
+    }
+    return result;
+}
+
+void BigInt::loadInto(mp_int& out) const {
+    if (isBig) {
+        check(mp_copy(&big, &out));
+    } else {
+        mp_set_i64(&out, small);
+    }
+}
+
+BigInt BigInt::adopt(mp_int& value) {
+    BigInt result;
+    result.big = value;
+    result.isBig = true;
+    result.normalize();
+    return result;
+}
+
+template <typename Op>
+BigInt BigInt::viaMp(const BigInt& a, const BigInt& b, Op op) {
+    MpTemp lhs, rhs;
+    a.loadInto(lhs.value);
+    b.loadInto(rhs.value);
+
+    mp_int result;
+    check(mp_init(&result));
+    mp_err err = op(&lhs.value, &rhs.value, &result);
+    if (err != MP_OKAY) {
+        mp_clear(&result);
+        check(err);
+    }
+    return adopt(result);
+}
+
+BigInt BigInt::operator-() const {
+    if (!isBig && small != INT64_MIN) return BigInt(-small);
+    return BigInt(0) - *this;
+}
+
+BigInt BigInt::operator~() const {
+    return -*this - BigInt(1);
+}
+
+BigInt BigInt::operator+(const BigInt& other) const {
+    int64_t result;
+    if (!isBig && !other.isBig && !__builtin_add_overflow(small, other.small, &result)) return BigInt(result);
+    return viaMp(*this, other, mp_add);
+}
+
+BigInt BigInt::operator-(const BigInt& other) const {
+    int64_t result;
+    if (!isBig && !other.isBig && !__builtin_sub_overflow(small, other.small, &result)) return BigInt(result);
+    return viaMp(*this, other, mp_sub);
+}
+
+BigInt BigInt::operator*(const BigInt& other) const {
+    int64_t result;
+    if (!isBig && !other.isBig && !__builtin_mul_overflow(small, other.small, &result)) return BigInt(result);
+    return viaMp(*this, other, mp_mul);
+}
+
+BigInt BigInt::operator/(const BigInt& other) const {
+    if (!other.isBig && other.small == 0) throw std::runtime_error("Division by zero");
+    if (!isBig && !other.isBig && !(small == INT64_MIN && other.small == -1)) return BigInt(small / other.small);
+    return viaMp(*this, other, [](const mp_int* a, const mp_int* b, mp_int* quotient) {
+        return mp_div(a, b, quotient, nullptr);
+    });
+}
+
+BigInt BigInt::operator%(const BigInt& other) const {
+    if (!other.isBig && other.small == 0) throw std::runtime_error("Division by zero");
+    if (!isBig && !other.isBig) return BigInt(other.small == -1 ? 0 : small % other.small);
+    return viaMp(*this, other, [](const mp_int* a, const mp_int* b, mp_int* remainder) {
+        return mp_div(a, b, nullptr, remainder);
+    });
+}
+
+BigInt BigInt::operator&(const BigInt& other) const {
+    if (!isBig && !other.isBig) return BigInt(small & other.small);
+    return viaMp(*this, other, mp_and);
+}
+
+BigInt BigInt::operator|(const BigInt& other) const {
+    if (!isBig && !other.isBig) return BigInt(small | other.small);
+    return viaMp(*this, other, mp_or);
+}
+
+BigInt BigInt::operator^(const BigInt& other) const {
+    if (!isBig && !other.isBig) return BigInt(small ^ other.small);
+    return viaMp(*this, other, mp_xor);
+}
+
+BigInt BigInt::operator<<(unsigned shift) const {
+    int64_t result;
+    if (!isBig && shift < 63 && !__builtin_mul_overflow(small, int64_t(1) << shift, &result)) return BigInt(result);
+    return viaMp(*this, BigInt(), [shift](const mp_int* a, const mp_int*, mp_int* shifted) {
+        return mp_mul_2d(a, static_cast<int>(shift), shifted);
+    });
+}
+
+BigInt BigInt::operator>>(unsigned shift) const {
+    if (!isBig) return BigInt(shift >= 63 ? (small < 0 ? -1 : 0) : small >> shift);
+    return viaMp(*this, BigInt(), [shift](const mp_int* a, const mp_int*, mp_int* shifted) {
+        return mp_signed_rsh(a, static_cast<int>(shift), shifted);
+    });
+}
+
 const BigInt BigInt::MIN_INT4("-8");
 const BigInt BigInt::MAX_INT4("7");
 const BigInt BigInt::MIN_INT8("-128");
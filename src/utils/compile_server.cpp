@@ -0,0 +1,376 @@
+#include "utils/compile_server.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <algorithm>
+#include <stdexcept>
+#include <streambuf>
+#include <thread>
+#include <mutex>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if !defined(_WIN32)
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <signal.h>
+#include <cerrno>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace CompileServer {
+
+static constexpr const char* PROTOCOL_MAGIC = "summit-server-1";
+
+std::string defaultSocketPath() {
+    if (const char* env = std::getenv("SUMMIT_SERVER_SOCKET")) {
+        return env;
+    }
+#if defined(_WIN32)
+    return (fs::temp_directory_path() / "summit.sock").string();
+#else
+    return (fs::temp_directory_path() / ("summit-" + std::to_string(getuid()) + ".sock")).string();
+#endif
+}
+
+#if defined(_WIN32)
+
+int serve(const std::string&, const Handler&) {
+    std::cerr << "--server is not supported on Windows" << std::endl;
+    return 1;
+}
+
+int forward(const std::string&, const std::vector<std::string>&, const std::vector<std::string>&,
+            const std::function<std::string(const std::string&)>&) {
+    return -1;
+}
+
+std::function<void()> inheritOutput(std::function<void()> work) {
+    return work;
+}
+
+#else
+
+/* Frames are a 32-bit length followed by that many bytes; both ends run on the same host */
+static bool writeAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = ::write(fd, data, size);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+static bool readAll(int fd, char* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = ::read(fd, data, size);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+static bool sendFrame(int fd, const std::string& payload) {
+    uint32_t size = static_cast<uint32_t>(payload.size());
+    return writeAll(fd, reinterpret_cast<const char*>(&size), sizeof(size)) &&
+           writeAll(fd, payload.data(), payload.size());
+}
+
+static bool recvFrame(int fd, std::string& payload) {
+    uint32_t size = 0;
+    if (!readAll(fd, reinterpret_cast<char*>(&size), sizeof(size))) return false;
+    payload.resize(size);
+    return size == 0 || readAll(fd, &payload[0], size);
+}
+
+static bool recvCount(int fd, size_t& count) {
+    std::string frame;
+    if (!recvFrame(fd, frame)) return false;
+    try {
+        count = std::stoul(frame);
+    } catch (const std::exception&) {
+        return false;
+    }
+    return true;
+}
+
+static bool fillAddress(const std::string& socketPath, sockaddr_un& address) {
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Socket path too long: " << socketPath << std::endl;
+        return false;
+    }
+    std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+    return true;
+}
+
+static int connectTo(const std::string& socketPath) {
+    sockaddr_un address;
+    if (!fillAddress(socketPath, address)) return -1;
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static std::string readBinary(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw std::runtime_error("Could not open file: " + path);
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    return buffer.str();
+}
+
+/* Output captured for the request running on this thread, if any */
+struct CapturedOutput {
+    std::mutex mutex;
+    std::string out;
+    std::string err;
+};
+static thread_local CapturedOutput* capturedOutput = nullptr;
+
+/* Installed as std::cout/std::cerr's buffer in the server: request threads write into their
+   CapturedOutput, everything else falls through to the original stream */
+class RoutingBuf : public std::streambuf {
+    std::streambuf* fallback;
+    bool isErr;
+
+protected:
+    int_type overflow(int_type ch) override {
+        if (traits_type::eq_int_type(ch, traits_type::eof())) return traits_type::not_eof(ch);
+        char c = traits_type::to_char_type(ch);
+        return xsputn(&c, 1) == 1 ? ch : traits_type::eof();
+    }
+
+    std::streamsize xsputn(const char* data, std::streamsize count) override {
+        if (CapturedOutput* output = capturedOutput) {
+            std::lock_guard<std::mutex> lock(output->mutex);
+            (isErr ? output->err : output->out).append(data, static_cast<size_t>(count));
+            return count;
+        }
+        return fallback->sputn(data, count);
+    }
+
+    int sync() override {
+        return capturedOutput ? 0 : fallback->pubsync();
+    }
+
+public:
+    RoutingBuf(std::streambuf* fallback, bool isErr) : fallback(fallback), isErr(isErr) {}
+};
+
+std::function<void()> inheritOutput(std::function<void()> work) {
+    CapturedOutput* output = capturedOutput;
+    return [output, work = std::move(work)]() {
+        capturedOutput = output;
+        work();
+        capturedOutput = nullptr;
+    };
+}
+
+/* Read one request, compile it in a private directory and stream the results back */
+static void handleConnection(int fd, const Handler& handler) {
+    std::string magic;
+    size_t argCount = 0, fileCount = 0;
+    if (!recvFrame(fd, magic) || magic != PROTOCOL_MAGIC || !recvCount(fd, argCount)) {
+        ::close(fd);
+        return;
+    }
+
+    std::vector<std::string> args(argCount);
+    for (auto& arg : args) {
+        if (!recvFrame(fd, arg)) { ::close(fd); return; }
+    }
+
+    std::string tmpl = (fs::temp_directory_path() / "summit-request-XXXXXX").string();
+    std::vector<char> dirBuffer(tmpl.begin(), tmpl.end());
+    dirBuffer.push_back('\0');
+    if (!mkdtemp(dirBuffer.data())) {
+        ::close(fd);
+        return;
+    }
+    std::string workDir = dirBuffer.data();
+
+    bool received = recvCount(fd, fileCount);
+    std::vector<std::string> inputs;
+    for (size_t i = 0; received && i < fileCount; ++i) {
+        std::string name, content;
+        received = recvFrame(fd, name) && recvFrame(fd, content);
+        /* Only plain file names; the client strips directories */
+        name = fs::path(name).filename().string();
+        if (!received || name.empty() || name == "." || name == "..") {
+            received = false;
+            break;
+        }
+        std::ofstream out(fs::path(workDir) / name, std::ios::binary | std::ios::trunc);
+        out.write(content.data(), static_cast<std::streamsize>(content.size()));
+        inputs.push_back(name);
+    }
+
+    if (received) {
+        CapturedOutput output;
+        capturedOutput = &output;
+        int exitCode = 1;
+        try {
+            exitCode = handler(args, workDir);
+        } catch (const std::exception& e) {
+            output.err += std::string("Compilation error: ") + e.what() + "\n";
+        }
+        capturedOutput = nullptr;
+
+        bool ok = sendFrame(fd, "out") && sendFrame(fd, output.out) &&
+                  sendFrame(fd, "err") && sendFrame(fd, output.err);
+
+        std::error_code ec;
+        for (const auto& entry : fs::directory_iterator(workDir, ec)) {
+            if (!ok) break;
+            std::string name = entry.path().filename().string();
+            if (!entry.is_regular_file() || std::find(inputs.begin(), inputs.end(), name) != inputs.end()) {
+                continue;
+            }
+            auto perms = entry.status().permissions();
+            bool executable = (perms & fs::perms::owner_exec) != fs::perms::none;
+            std::string content;
+            try {
+                content = readBinary(entry.path().string());
+            } catch (const std::exception&) {
+                continue;
+            }
+            ok = sendFrame(fd, "file") && sendFrame(fd, name) &&
+                 sendFrame(fd, executable ? "755" : "644") && sendFrame(fd, content);
+        }
+        if (ok) {
+            sendFrame(fd, "exit");
+            sendFrame(fd, std::to_string(exitCode));
+        }
+    }
+
+    std::error_code ec;
+    fs::remove_all(workDir, ec);
+    ::close(fd);
+}
+
+int serve(const std::string& socketPath, const Handler& handler) {
+    /* A client that disconnects early must not kill the server */
+    signal(SIGPIPE, SIG_IGN);
+
+    int probe = connectTo(socketPath);
+    if (probe >= 0) {
+        ::close(probe);
+        std::cerr << "A summit server is already listening on " << socketPath << std::endl;
+        return 1;
+    }
+    ::unlink(socketPath.c_str());
+
+    sockaddr_un address;
+    if (!fillAddress(socketPath, address)) return 1;
+    int listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        std::cerr << "socket: " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+
+    mode_t oldMask = ::umask(0077);
+    int bound = ::bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    ::umask(oldMask);
+    if (bound != 0 || ::listen(listenFd, 64) != 0) {
+        std::cerr << "Could not listen on " << socketPath << ": " << std::strerror(errno) << std::endl;
+        ::close(listenFd);
+        return 1;
+    }
+
+    static RoutingBuf outBuf(std::cout.rdbuf(), false);
+    static RoutingBuf errBuf(std::cerr.rdbuf(), true);
+    std::cout.rdbuf(&outBuf);
+    std::cerr.rdbuf(&errBuf);
+
+    std::cerr << "summit server listening on " << socketPath << std::endl;
+
+    while (true) {
+        int fd = ::accept(listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "accept: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        std::thread(handleConnection, fd, std::cref(handler)).detach();
+    }
+
+    ::close(listenFd);
+    ::unlink(socketPath.c_str());
+    return 1;
+}
+
+int forward(const std::string& socketPath, const std::vector<std::string>& args,
+            const std::vector<std::string>& inputFiles,
+            const std::function<std::string(const std::string&)>& placeArtifact) {
+    signal(SIGPIPE, SIG_IGN);
+
+    int fd = connectTo(socketPath);
+    if (fd < 0) return -1;
+
+    bool ok = sendFrame(fd, PROTOCOL_MAGIC) && sendFrame(fd, std::to_string(args.size()));
+    for (const auto& arg : args) {
+        ok = ok && sendFrame(fd, arg);
+    }
+    ok = ok && sendFrame(fd, std::to_string(inputFiles.size()));
+    for (const auto& input : inputFiles) {
+        ok = ok && sendFrame(fd, fs::path(input).filename().string()) && sendFrame(fd, readBinary(input));
+    }
+    if (!ok) {
+        ::close(fd);
+        throw std::runtime_error("Lost connection to summit server");
+    }
+
+    std::string tag;
+    while (recvFrame(fd, tag)) {
+        std::string payload;
+        if (tag == "out" && recvFrame(fd, payload)) {
+            std::cout << payload << std::flush;
+        } else if (tag == "err" && recvFrame(fd, payload)) {
+            std::cerr << payload << std::flush;
+        } else if (tag == "file") {
+            std::string name, mode;
+            if (!recvFrame(fd, name) || !recvFrame(fd, mode) || !recvFrame(fd, payload)) break;
+            std::string path = placeArtifact(fs::path(name).filename().string());
+            {
+                std::ofstream out(path, std::ios::binary | std::ios::trunc);
+                if (!out) {
+                    std::cerr << "Could not write " << path << std::endl;
+                    continue;
+                }
+                out.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+            }
+            ::chmod(path.c_str(), mode == "755" ? 0755 : 0644);
+        } else if (tag == "exit" && recvFrame(fd, payload)) {
+            ::close(fd);
+            try {
+                return std::stoi(payload);
+            } catch (const std::exception&) {
+                return 1;
+            }
+        } else {
+            break;
+        }
+    }
+
+    ::close(fd);
+    throw std::runtime_error("Lost connection to summit server");
+}
+
+#endif
+
+}
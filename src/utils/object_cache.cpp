@@ -0,0 +1,160 @@
+#include "utils/object_cache.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <system_error>
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/Support/BLAKE3.h>
+
+namespace fs = std::filesystem;
+
+ObjectCache::ObjectCache(const std::string& directory, uint64_t maxBytes)
+    : directory(directory), maxBytes(maxBytes) {
+    std::error_code ec;
+    fs::create_directories(directory, ec);
+    loadStats();
+}
+
+std::string ObjectCache::defaultDirectory() {
+    if (const char* env = std::getenv("SUMMIT_CACHE_DIR")) {
+        return env;
+    }
+    if (const char* xdg = std::getenv("XDG_CACHE_HOME")) {
+        return (fs::path(xdg) / "summit").string();
+    }
+#if defined(_WIN32)
+    if (const char* local = std::getenv("LOCALAPPDATA")) {
+        return (fs::path(local) / "summit" / "cache").string();
+    }
+#else
+    if (const char* home = std::getenv("HOME")) {
+        return (fs::path(home) / ".cache" / "summit").string();
+    }
+#endif
+    return (fs::temp_directory_path() / "summit-cache").string();
+}
+
+std::string ObjectCache::computeKey(const std::vector<std::string_view>& parts) {
+    llvm::BLAKE3 hasher;
+    for (const auto& part : parts) {
+        /* Length prefix keeps ("ab","c") and ("a","bc") distinct */
+        uint64_t length = part.size();
+        hasher.update(llvm::ArrayRef<uint8_t>(reinterpret_cast<const uint8_t*>(&length), sizeof(length)));
+        hasher.update(llvm::StringRef(part.data(), part.size()));
+    }
+    auto digest = hasher.final();
+    return llvm::toHex(digest, true);
+}
+
+std::string ObjectCache::objectPath(const std::string& key) const {
+    return (fs::path(directory) / (key + ".o")).string();
+}
+
+bool ObjectCache::lookup(const std::string& key, llvm::SmallVectorImpl<char>& object) {
+    std::string path = objectPath(key);
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        recordStats(false);
+        return false;
+    }
+
+    in.seekg(0, std::ios::end);
+    std::streamoff size = in.tellg();
+    in.seekg(0, std::ios::beg);
+    object.resize(static_cast<size_t>(size));
+    if (size <= 0 || !in.read(object.data(), size)) {
+        object.clear();
+        recordStats(false);
+        return false;
+    }
+
+    /* Touch for LRU ordering */
+    std::error_code ec;
+    fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+    recordStats(true);
+    return true;
+}
+
+void ObjectCache::store(const std::string& key, llvm::ArrayRef<char> object) {
+    /* Write to a unique temp name and rename so concurrent builds never see a partial object */
+    std::random_device rd;
+    std::string tmpPath = objectPath(key) + ".tmp" + std::to_string(rd());
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) return;
+        out.write(object.data(), static_cast<std::streamsize>(object.size()));
+        if (!out) {
+            out.close();
+            std::remove(tmpPath.c_str());
+            return;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(tmpPath, objectPath(key), ec);
+    if (ec) {
+        fs::remove(tmpPath, ec);
+        return;
+    }
+    evict();
+}
+
+void ObjectCache::evict() {
+    struct Entry {
+        fs::file_time_type lastUse;
+        uint64_t size;
+        fs::path path;
+    };
+
+    std::vector<Entry> entries;
+    uint64_t total = 0;
+    std::error_code ec;
+    for (const auto& item : fs::directory_iterator(directory, ec)) {
+        if (item.path().extension() != ".o") continue;
+        std::error_code itemEc;
+        uint64_t size = item.file_size(itemEc);
+        auto lastUse = item.last_write_time(itemEc);
+        if (itemEc) continue;
+        entries.push_back({lastUse, size, item.path()});
+        total += size;
+    }
+    if (total <= maxBytes) return;
+
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry& a, const Entry& b) { return a.lastUse < b.lastUse; });
+    for (const auto& entry : entries) {
+        if (total <= maxBytes) break;
+        if (fs::remove(entry.path, ec)) total -= entry.size;
+    }
+}
+
+void ObjectCache::loadStats() {
+    std::ifstream in((fs::path(directory) / "stats").string());
+    std::string label;
+    uint64_t value;
+    while (in >> label >> value) {
+        if (label == "hits") hits = value;
+        else if (label == "misses") misses = value;
+    }
+}
+
+void ObjectCache::recordStats(bool hit) {
+    /* Re-read so counts from concurrent runs are not overwritten wholesale */
+    loadStats();
+    if (hit) ++hits; else ++misses;
+
+    std::random_device rd;
+    fs::path statsPath = fs::path(directory) / "stats";
+    std::string tmpPath = statsPath.string() + ".tmp" + std::to_string(rd());
+    {
+        std::ofstream out(tmpPath, std::ios::trunc);
+        if (!out) return;
+        out << "hits " << hits << "\n" << "misses " << misses << "\n";
+    }
+    std::error_code ec;
+    fs::rename(tmpPath, statsPath, ec);
+    if (ec) fs::remove(tmpPath, ec);
+}
@@ -0,0 +1,12 @@
+#include "utils/source_buffer.h"
+#include <stdexcept>
+
+SourceBuffer SourceBuffer::fromFile(const std::string& filename) {
+    /* Not volatile: sources don't change under us, so LLVM may mmap them */
+    auto buffer = llvm::MemoryBuffer::getFile(filename, /*IsText=*/false,
+                                              /*RequiresNullTerminator=*/true, /*IsVolatile=*/false);
+    if (!buffer) {
+        throw std::runtime_error("Could not open file: " + filename);
+    }
+    return SourceBuffer(std::move(*buffer));
+}
@@ -0,0 +1,26 @@
+#include "utils/string_interner.h"
+#include <limits>
+#include <stdexcept>
+
+StringInterner::StringInterner() {
+    spellings.emplace_back();
+}
+
+StringInterner::Id StringInterner::intern(std::string_view text) {
+    auto it = ids.find(text);
+    if (it != ids.end()) return it->second;
+
+    if (spellings.size() > std::numeric_limits<Id>::max()) {
+        throw std::runtime_error("Too many distinct identifiers");
+    }
+    Id id = static_cast<Id>(spellings.size());
+    std::string_view stored = storage.emplace_back(text);
+    spellings.push_back(stored);
+    ids.emplace(stored, id);
+    return id;
+}
+
+StringInterner::Id StringInterner::find(std::string_view text) const {
+    auto it = ids.find(text);
+    return it == ids.end() ? NONE : it->second;
+}
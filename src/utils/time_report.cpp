@@ -0,0 +1,148 @@
+#include "utils/time_report.h"
+#include <sstream>
+#include <iomanip>
+#include <ctime>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+TimeReport::Scope::Scope(TimeReport* report, const std::string& name)
+    : report(report), name(name) {
+    if (report) {
+        wallStart = std::chrono::steady_clock::now();
+        cpuStartMs = threadCpuMs();
+    }
+}
+
+void TimeReport::Scope::stop() {
+    if (!report) return;
+    double wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wallStart).count();
+    report->addPhase({name, wallMs, threadCpuMs() - cpuStartMs, peakRssKB()});
+    report = nullptr;
+}
+
+void TimeReport::setCounter(const std::string& name, uint64_t value) {
+    for (auto& counter : counters) {
+        if (counter.first == name) {
+            counter.second = value;
+            return;
+        }
+    }
+    counters.emplace_back(name, value);
+}
+
+double TimeReport::threadCpuMs() {
+#if defined(_WIN32)
+    FILETIME creation, exit, kernel, user;
+    if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user)) return 0;
+    auto toMs = [](const FILETIME& ft) {
+        ULARGE_INTEGER value;
+        value.LowPart = ft.dwLowDateTime;
+        value.HighPart = ft.dwHighDateTime;
+        return static_cast<double>(value.QuadPart) / 10000.0;
+    };
+    return toMs(kernel) + toMs(user);
+#else
+    timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) return 0;
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+#endif
+}
+
+uint64_t TimeReport::peakRssKB() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+    return counters.PeakWorkingSetSize / 1024;
+#else
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#if defined(__APPLE__)
+    return static_cast<uint64_t>(usage.ru_maxrss) / 1024;
+#else
+    return static_cast<uint64_t>(usage.ru_maxrss);
+#endif
+#endif
+}
+
+std::string TimeReport::toText() const {
+    std::ostringstream out;
+    out << "===== Time report" << (file.empty() ? "" : ": " + file) << " =====\n";
+    out << std::left << std::setw(14) << "phase"
+        << std::right << std::setw(12) << "wall (ms)"
+        << std::setw(12) << "cpu (ms)"
+        << std::setw(16) << "peak rss (KB)" << "\n";
+
+    double totalWall = 0, totalCpu = 0;
+    out << std::fixed << std::setprecision(3);
+    for (const auto& phase : phases) {
+        out << std::left << std::setw(14) << phase.name
+            << std::right << std::setw(12) << phase.wallMs
+            << std::setw(12) << phase.cpuMs
+            << std::setw(16) << phase.peakRssKB << "\n";
+        totalWall += phase.wallMs;
+        totalCpu += phase.cpuMs;
+    }
+    out << std::left << std::setw(14) << "total"
+        << std::right << std::setw(12) << totalWall
+        << std::setw(12) << totalCpu << "\n";
+
+    for (const auto& counter : counters) {
+        out << std::left << std::setw(26) << counter.first << counter.second << "\n";
+    }
+    return out.str();
+}
+
+/* Escape for a JSON string literal */
+static std::string jsonEscape(const std::string& text) {
+    std::ostringstream out;
+    for (char c : text) {
+        switch (c) {
+            case '"': out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c)
+                        << std::dec << std::setfill(' ');
+                } else {
+                    out << c;
+                }
+        }
+    }
+    return out.str();
+}
+
+std::string TimeReport::toJSON() const {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(3);
+    out << "{\"file\":\"" << jsonEscape(file) << "\",\"phases\":[";
+
+    double totalWall = 0, totalCpu = 0;
+    for (size_t i = 0; i < phases.size(); ++i) {
+        const auto& phase = phases[i];
+        if (i) out << ",";
+        out << "{\"name\":\"" << jsonEscape(phase.name) << "\""
+            << ",\"wall_ms\":" << phase.wallMs
+            << ",\"cpu_ms\":" << phase.cpuMs
+            << ",\"peak_rss_kb\":" << phase.peakRssKB << "}";
+        totalWall += phase.wallMs;
+        totalCpu += phase.cpuMs;
+    }
+
+    out << "],\"total_wall_ms\":" << totalWall
+        << ",\"total_cpu_ms\":" << totalCpu
+        << ",\"peak_rss_kb\":" << peakRssKB()
+        << ",\"counters\":{";
+    for (size_t i = 0; i < counters.size(); ++i) {
+        if (i) out << ",";
+        out << "\"" << jsonEscape(counters[i].first) << "\":" << counters[i].second;
+    }
+    out << "}}";
+    return out.str();
+}
@@ -0,0 +1,120 @@
+#include "utils/trace.h"
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <sstream>
+
+namespace Trace {
+
+std::atomic<uint32_t> enabledCategories{0};
+std::atomic<uint32_t> enabledLevel{static_cast<uint32_t>(Level::Info)};
+
+static constexpr size_t FLUSH_THRESHOLD = 64 * 1024;
+
+/* Lines from all threads are batched here and written in large chunks */
+static std::mutex sinkMutex;
+static std::string pending;
+static FILE* sink = nullptr;
+
+static const char* categoryName(Category category) {
+    switch (category) {
+        case Category::Scope: return "scope";
+        case Category::Call: return "call";
+        case Category::Struct: return "struct";
+        case Category::Module: return "module";
+        case Category::Var: return "var";
+        case Category::Func: return "func";
+        case Category::Parse: return "parse";
+    }
+    return "trace";
+}
+
+static void writePending() {
+    if (pending.empty()) return;
+    FILE* out = sink ? sink : stderr;
+    std::fwrite(pending.data(), 1, pending.size(), out);
+    std::fflush(out);
+    pending.clear();
+}
+
+void flush() {
+    std::lock_guard<std::mutex> lock(sinkMutex);
+    writePending();
+}
+
+bool configure(const std::string& spec, std::string& error) {
+    static const std::pair<const char*, Category> names[] = {
+        {"scope", Category::Scope}, {"call", Category::Call}, {"struct", Category::Struct},
+        {"module", Category::Module}, {"var", Category::Var}, {"func", Category::Func},
+        {"parse", Category::Parse},
+    };
+
+    std::string list = spec;
+    uint32_t level = static_cast<uint32_t>(Level::Info);
+    size_t colon = spec.find(':');
+    if (colon != std::string::npos) {
+        list = spec.substr(0, colon);
+        std::string levelText = spec.substr(colon + 1);
+        if (levelText == "1" || levelText == "info") level = static_cast<uint32_t>(Level::Info);
+        else if (levelText == "2" || levelText == "detail") level = static_cast<uint32_t>(Level::Detail);
+        else {
+            error = "unknown trace level '" + levelText + "' (expected 1/info or 2/detail)";
+            return false;
+        }
+    }
+
+    uint32_t mask = 0;
+    std::stringstream items(list);
+    std::string item;
+    while (std::getline(items, item, ',')) {
+        if (item.empty()) continue;
+        if (item == "all") {
+            mask = ~0u;
+            continue;
+        }
+        bool found = false;
+        for (const auto& name : names) {
+            if (item == name.first) {
+                mask |= static_cast<uint32_t>(name.second);
+                found = true;
+            }
+        }
+        if (!found) {
+            error = "unknown trace category '" + item + "' (expected scope, call, struct, module, var, func, parse or all)";
+            return false;
+        }
+    }
+
+    static std::once_flag flushAtExit;
+    std::call_once(flushAtExit, []() { std::atexit(flush); });
+
+    enabledLevel.store(level, std::memory_order_relaxed);
+    enabledCategories.store(mask, std::memory_order_relaxed);
+    return true;
+}
+
+bool setOutputFile(const std::string& path, std::string& error) {
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) {
+        error = "could not open trace file: " + path;
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(sinkMutex);
+    writePending();
+    if (sink) std::fclose(sink);
+    sink = file;
+    return true;
+}
+
+Line::Line(Category category) {
+    stream << "[" << categoryName(category) << "] ";
+}
+
+Line::~Line() {
+    stream << '\n';
+    std::lock_guard<std::mutex> lock(sinkMutex);
+    pending += stream.str();
+    if (pending.size() >= FLUSH_THRESHOLD) writePending();
+}
+
+}
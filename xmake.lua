@@ -10,6 +10,7 @@ if is_plat("linux") then
     target("summit")
         set_kind("binary")
         add_files("src/**.cpp")
+        add_files("stdlib/*.c") -- runtime for `summit run` (JIT)
         add_includedirs("src", "include", "include/codegen", "include/ast", "include/utils", "include/lexer", "include/parser")
         
         on_load(function (target)
@@ -60,12 +61,17 @@ if is_plat("linux") then
         )
         add_syslinks("tommath")
 
+        -- in-process linking (src/codegen/lld_linker.cpp)
+        add_defines("SUMMIT_HAVE_LLD")
+        add_links("lldELF", "lldCommon")
+
 else if is_plat("windows") then
     set_toolchains("mingw")
     
     target("summit")
         set_kind("binary")
         add_files("src/**.cpp")
+        add_files("stdlib/*.c") -- runtime for `summit run` (JIT)
         add_includedirs("src", "include", "include/codegen", "include/ast", "include/utils", "include/lexer", "include/parser")
         
         on_load(function (target)
@@ -116,7 +122,7 @@ else if is_plat("windows") then
             "-s"
         )
         
-        add_syslinks("tommath")
+        add_syslinks("tommath", "psapi")
 
 else if is_plat("windows") and is_arch("arm64") then
     set_toolchains("msvc")
@@ -124,6 +130,7 @@ else if is_plat("windows") and is_arch("arm64") then
     target("summit")
         set_kind("binary")
         add_files("src/**.cpp")
+        add_files("stdlib/*.c") -- runtime for `summit run` (JIT)
         add_includedirs("src", "include", "include/codegen", "include/ast", "include/utils", "include/lexer", "include/parser")
 
         on_load(function (target)
@@ -157,4 +164,53 @@ else if is_plat("windows") and is_arch("arm64") then
         )
 end
 end
-end
\ No newline at end of file
+end
+
+-- Microbenchmarks, not built by default: xmake build keyword-bench && xmake run keyword-bench
+target("keyword-bench")
+    set_kind("binary")
+    set_default(false)
+    add_files("bench/keyword_lookup.cpp", "src/lexer/*.cpp", "src/utils/string_interner.cpp")
+    add_includedirs("include", "include/lexer")
+
+-- Front-end throughput (lex/parse/codegen) on a generated corpus, JSON on stdout:
+-- xmake build summit-bench && xmake run summit-bench --functions 5000 --elseif 32
+target("summit-bench")
+    set_kind("binary")
+    set_default(false)
+    add_files("bench/summit_bench.cpp", "src/**.cpp", "stdlib/*.c")
+    remove_files("src/main.cpp")
+    add_includedirs("src", "include", "include/codegen", "include/ast", "include/utils", "include/lexer", "include/parser")
+
+    on_load(function (target)
+        local llvm_cxxflags = os.iorun("llvm-config --cxxflags")
+        local llvm_ldflags = os.iorun("llvm-config --ldflags --system-libs --libs all")
+
+        if llvm_cxxflags and llvm_ldflags then
+            for flag in llvm_cxxflags:gmatch("%S+") do
+                if flag:startswith("-I") then
+                    target:add("includedirs", flag:sub(3))
+                else
+                    target:add("cxxflags", flag)
+                end
+            end
+
+            for flag in llvm_ldflags:gmatch("%S+") do
+                if flag:startswith("-L") then
+                    target:add("linkdirs", flag:sub(3))
+                elseif flag:startswith("-l") then
+                    target:add("links", flag:sub(3))
+                else
+                    target:add("ldflags", flag)
+                end
+            end
+        else
+            target:add("links", "LLVM-18")
+        end
+    end)
+
+    add_cxflags("-DNDEBUG", "-fexceptions")
+    add_syslinks("tommath")
+    if is_plat("windows") then
+        add_syslinks("psapi")
+    end